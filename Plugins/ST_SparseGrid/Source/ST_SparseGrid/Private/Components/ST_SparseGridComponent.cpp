@@ -2,10 +2,13 @@
 
 #include "ST_SparseGridComponent.h"
 #include "ST_SparseGrid.h"
-#include "ST_SparseGridManager_Basic.h"
+#include "ST_SparseGridManager.h"
+#include "ST_SparseGridData.h"
 
 // Extras
+#include "Engine/Level.h"
 #include "GameFramework/Actor.h"
+#include "Components/SceneComponent.h"
 
 ///////////////////////
 ///// Constructor /////
@@ -17,6 +20,10 @@ UST_SparseGridComponent::UST_SparseGridComponent(const FObjectInitializer& OI)
 {
 	// Disable Ticking
 	PrimaryComponentTick.bCanEverTick = false;
+
+	bStaticGridObject = false;
+	GridCategories = 0;
+	GridName = NAME_None;
 }
 
 ///////////////////////////
@@ -39,30 +46,172 @@ void UST_SparseGridComponent::RegisterWithSparseGrid()
 {
 	if (GetWorld() && GetWorld()->IsGameWorld())
 	{
-		UST_SparseGridManager_Basic* BasicManager = Cast<UST_SparseGridManager_Basic>(UST_SparseGridManager::Get(this));
-		if (BasicManager && BasicManager->AreGridsInitialized())
+		UST_SparseGridManager* Manager = UST_SparseGridManager::Get(this);
+		if (Manager && Manager->AreGridsInitialized())
 		{
-			BasicManager->GetSparseGrid_Basic()->Add(this);
+			SparseGridData.SetStatic(bStaticGridObject);
+			SparseGridData.SetCategoryMask((uint32)GridCategories);
+
+			// Grids can only be written on the game thread, the manager adds queued components in one batch on its next tick
+			// Streaming levels register all their components as they are made visible, so those are always batched
+			const ULevel* OwnerLevel = GetOwner() ? GetOwner()->GetLevel() : nullptr;
+			const bool bLevelStreamingIn = OwnerLevel && OwnerLevel->bIsAssociatingLevel;
+
+			if (!IsInGameThread() || bLevelStreamingIn || (Manager->GetGridConfig() && Manager->GetGridConfig()->GetDeferRegistration()))
+			{
+				Manager->QueueGridComponentRegistration(this);
+			}
+			else if (Manager->RegisterGridComponent(this))
+			{
+				OnAddedToSparseGrid();
+			}
 		}
 	}
 }
 
 void UST_SparseGridComponent::UnRegisterWithSparseGrid()
 {
+	// Removal is always immediate, so the grid never holds on to a destroyed component.
+	// Queued removals could be dropped if the component were collected before the manager's next tick.
+	checkf(IsInGameThread(), TEXT("UST_SparseGridComponent::UnRegisterWithSparseGrid() - '%s' must be unregistered on the game thread"), *GetNameSafe(this));
+
+	OnRemovedFromSparseGrid();
+
 	if (GetWorld() && GetWorld()->IsGameWorld())
 	{
-		UST_SparseGridManager_Basic* BasicManager = Cast<UST_SparseGridManager_Basic>(UST_SparseGridManager::Get(this));
-		if (BasicManager && BasicManager->AreGridsInitialized())
+		UST_SparseGridManager* Manager = UST_SparseGridManager::Get(this);
+		if (Manager && Manager->AreGridsInitialized())
 		{
-			BasicManager->GetSparseGrid_Basic()->Remove(this);
+			// The first component of an unloading level drops the whole level, the rest are then already clear
+			const ULevel* OwnerLevel = GetOwner() ? GetOwner()->GetLevel() : nullptr;
+			if (OwnerLevel && OwnerLevel->bIsBeingRemoved && !OwnerLevel->IsPersistentLevel() && SparseGridData.IsValid())
+			{
+				Manager->UnregisterLevelGridComponents(OwnerLevel);
+			}
+
+			Manager->UnregisterGridComponent(this);
 		}
 	}
 }
 
+void UST_SparseGridComponent::OnAddedToSparseGrid()
+{
+	// Static objects rely on transform events to be re-bucketed
+	if (bStaticGridObject && !BoundRootComponent.IsValid())
+	{
+		USceneComponent* RootComponent = GetOwner() ? GetOwner()->GetRootComponent() : nullptr;
+		if (RootComponent)
+		{
+			TransformUpdatedHandle = RootComponent->TransformUpdated.AddUObject(this, &UST_SparseGridComponent::OnRootTransformUpdated);
+			BoundRootComponent = RootComponent;
+		}
+	}
+}
+
+void UST_SparseGridComponent::OnRemovedFromSparseGrid()
+{
+	if (BoundRootComponent.IsValid())
+	{
+		BoundRootComponent->TransformUpdated.Remove(TransformUpdatedHandle);
+	}
+
+	BoundRootComponent.Reset();
+	TransformUpdatedHandle.Reset();
+}
+
+void UST_SparseGridComponent::SetIsStaticGridObject(const bool bNewStatic)
+{
+	if (bStaticGridObject != bNewStatic)
+	{
+		const bool bWasRegistered = SparseGridData.IsValid();
+		if (bWasRegistered)
+		{
+			UnRegisterWithSparseGrid();
+		}
+
+		bStaticGridObject = bNewStatic;
+		SparseGridData.SetStatic(bStaticGridObject);
+
+		if (bWasRegistered)
+		{
+			RegisterWithSparseGrid();
+		}
+	}
+}
+
+void UST_SparseGridComponent::SetGridName(const FName NewGridName)
+{
+	if (GridName != NewGridName)
+	{
+		const bool bWasRegistered = SparseGridData.IsValid();
+		if (bWasRegistered)
+		{
+			UnRegisterWithSparseGrid();
+		}
+
+		GridName = NewGridName;
+
+		if (bWasRegistered)
+		{
+			RegisterWithSparseGrid();
+		}
+	}
+}
+
+void UST_SparseGridComponent::SetGridCategories(const int32 NewCategories)
+{
+	if (GridCategories != NewCategories)
+	{
+		GridCategories = NewCategories;
+		SparseGridData.SetCategoryMask((uint32)GridCategories);
+
+		// Static objects are only re-cached by the grid when dirty
+		if (SparseGridData.IsValid())
+		{
+			UST_SparseGridManager* Manager = UST_SparseGridManager::Get(this);
+			if (Manager && Manager->AreGridsInitialized())
+			{
+				Manager->MarkGridComponentDirty(this);
+			}
+		}
+	}
+}
+
+void UST_SparseGridComponent::InitSparseGridData()
+{
+	// Level-placed components are added by the grid's Init() before their own OnRegister(), so the grid must already see the right flags
+	SparseGridData.SetStatic(bStaticGridObject);
+	SparseGridData.SetCategoryMask((uint32)GridCategories);
+}
+
+void UST_SparseGridComponent::OnRootTransformUpdated(USceneComponent* InRootComponent, EUpdateTransformFlags InUpdateTransformFlags, ETeleportType InTeleport)
+{
+	UST_SparseGridManager* Manager = UST_SparseGridManager::Get(this);
+	if (Manager && Manager->AreGridsInitialized())
+	{
+		Manager->MarkGridComponentDirty(this);
+	}
+}
+
 /////////////////////
 ///// Overrides /////
 /////////////////////
 
+void UST_SparseGridComponent::PostInitProperties()
+{
+	Super::PostInitProperties();
+
+	InitSparseGridData();
+}
+
+void UST_SparseGridComponent::PostLoad()
+{
+	Super::PostLoad();
+
+	// Level-placed components only have their saved properties once loaded
+	InitSparseGridData();
+}
+
 void UST_SparseGridComponent::OnRegister()
 {
 	Super::OnRegister();
@@ -30,6 +30,15 @@ UST_SparseGridData::UST_SparseGridData(const FObjectInitializer& OI)
 	CellSize = 1000;
 	RegisterAllocSize = 128;
 	CellAllocSize = 16;
+	UpdateMode = EST_SparseGridUpdateMode::Serial;
+	ParallelUpdateBatchSize = 2048;
+	AutoRebuildThreshold = 0.5f;
+	bIncrementalUpdate = false;
+	bPublishSnapshots = false;
+	bDeferRegistration = false;
+	NumCoarseLevels = 0;
+	CoarseLevelRatio = 4;
+	CellLayout = EST_SparseGridCellLayout::RowMajor;
 
 	ManagerClass = UST_SparseGridManager_Basic::StaticClass();
 
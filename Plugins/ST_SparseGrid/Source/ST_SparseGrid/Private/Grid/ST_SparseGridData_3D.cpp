@@ -0,0 +1,42 @@
+// Copyright (C) James Baxter. All Rights Reserved.
+
+#include "ST_SparseGridData_3D.h"
+#include "ST_SparseGridManager_3D.h"
+
+#define LOCTEXT_NAMESPACE "NSSparseGridData"
+
+///////////////////////
+///// Constructor /////
+///////////////////////
+
+UST_SparseGridData_3D::UST_SparseGridData_3D(const FObjectInitializer& OI)
+	: Super(OI)
+{
+	GridOriginZ = -1000;
+	NumCellsZ = 4;
+	CellSizeZ = 500;
+
+	ManagerClass = UST_SparseGridManager_3D::StaticClass();
+}
+
+////////////////////////////
+///// Editor Interface /////
+////////////////////////////
+
+#if WITH_EDITORONLY_DATA
+FText UST_SparseGridData_3D::GetGridDiagnosticText() const
+{
+	FNumberFormattingOptions FormatOps;
+	FormatOps.SetMaximumFractionalDigits(2);
+	FormatOps.SetMinimumFractionalDigits(2);
+
+	FFormatOrderedArguments OrderedArgs;
+	OrderedArgs.Add(FText::FromString(LINE_TERMINATOR));
+	OrderedArgs.Add(FText::Format(LOCTEXT("CellCount3D", "Num Cells: {0}"), FText::AsNumber(NumCellsX * NumCellsY * NumCellsZ)));
+	OrderedArgs.Add(FText::Format(LOCTEXT("GridSize3D", "Total Size: {0}M x {1}M x {2}M"), FText::AsNumber((CellSize * NumCellsX) / 100.f, &FormatOps), FText::AsNumber((CellSize * NumCellsY) / 100.f, &FormatOps), FText::AsNumber((CellSizeZ * NumCellsZ) / 100.f, &FormatOps)));
+
+	return FText::Format(LOCTEXT("GridDiagnostics3D", "{1}{0}{2}"), OrderedArgs);
+}
+#endif
+
+#undef LOCTEXT_NAMESPACE
\ No newline at end of file
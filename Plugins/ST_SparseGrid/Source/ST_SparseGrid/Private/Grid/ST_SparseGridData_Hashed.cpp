@@ -0,0 +1,14 @@
+// Copyright (C) James Baxter. All Rights Reserved.
+
+#include "ST_SparseGridData_Hashed.h"
+#include "ST_SparseGridManager_Hashed.h"
+
+///////////////////////
+///// Constructor /////
+///////////////////////
+
+UST_SparseGridData_Hashed::UST_SparseGridData_Hashed(const FObjectInitializer& OI)
+	: Super(OI)
+{
+	ManagerClass = UST_SparseGridManager_Hashed::StaticClass();
+}
\ No newline at end of file
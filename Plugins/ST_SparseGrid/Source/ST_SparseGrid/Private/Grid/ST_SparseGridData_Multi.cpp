@@ -0,0 +1,14 @@
+// Copyright (C) James Baxter. All Rights Reserved.
+
+#include "ST_SparseGridData_Multi.h"
+#include "ST_SparseGridManager_Multi.h"
+
+///////////////////////
+///// Constructor /////
+///////////////////////
+
+UST_SparseGridData_Multi::UST_SparseGridData_Multi(const FObjectInitializer& OI)
+	: Super(OI)
+{
+	ManagerClass = UST_SparseGridManager_Multi::StaticClass();
+}
\ No newline at end of file
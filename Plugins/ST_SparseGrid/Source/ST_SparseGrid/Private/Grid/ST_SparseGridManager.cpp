@@ -2,11 +2,17 @@
 
 #include "ST_SparseGridManager.h"
 #include "ST_SparseGridData.h"
+#include "ST_SparseGridComponent.h"
 
 // Engine
 #include "Engine/Engine.h"
+#include "Engine/Level.h"
+#include "GameFramework/Actor.h"
 #include "GameFramework/WorldSettings.h"
 
+TMap<const UWorld*, TWeakObjectPtr<UST_SparseGridManager>> UST_SparseGridManager::WorldManagers;
+FRWLock UST_SparseGridManager::WorldManagersLock;
+
 ///////////////////////
 ///// Constructor /////
 ///////////////////////
@@ -33,24 +39,16 @@ UST_SparseGridManager::UST_SparseGridManager(const FObjectInitializer& OI)
 UST_SparseGridManager* UST_SparseGridManager::Get(const UObject* WorldContextObject)
 {
 	const UWorld* lWorld = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull);
-	if (lWorld && lWorld->PersistentLevel)
+	if (lWorld)
 	{
-		const AWorldSettings* lWorldSettings = lWorld->PersistentLevel->GetWorldSettings(false);
-		if (lWorldSettings)
+		UST_SparseGridManager* lManager = FindWorldManager(lWorld);
+		if (lManager)
 		{
-			UST_SparseGridManager* lManager = lWorldSettings->FindComponentByClass<UST_SparseGridManager>();
-			if (lManager)
-			{
-				return lManager;
-			}
-			else
-			{
-				UE_LOG(LogST_SparseGridManager, Verbose, TEXT("UST_SparseGridManager::Get() - Manager Invalid"));
-			}
+			return lManager;
 		}
 		else
 		{
-			UE_LOG(LogST_SparseGridManager, Verbose, TEXT("UST_SparseGridManager::Get() - World Settings Invalid"));
+			UE_LOG(LogST_SparseGridManager, Verbose, TEXT("UST_SparseGridManager::Get() - Manager Invalid"));
 		}
 	}
 	else
@@ -66,15 +64,20 @@ UST_SparseGridManager* UST_SparseGridManager::GetChecked(const UObject* WorldCon
 	const UWorld* lWorld = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull);
 	checkf(lWorld != nullptr, TEXT("UST_SparseGridManager::GetChecked() - World Invalid"));
 
-	const AWorldSettings* lWorldSettings = lWorld->GetWorldSettings(false, false);
-	checkf(lWorldSettings != nullptr, TEXT("UST_SparseGridManager::GetChecked() - World Settings Invalid"));
-
-	UST_SparseGridManager* lManager = lWorldSettings->FindComponentByClass<UST_SparseGridManager>();
+	UST_SparseGridManager* lManager = FindWorldManager(lWorld);
 	checkf(lManager != nullptr, TEXT("UST_SparseGridManager::GetChecked() - Manager Invalid"));
 
 	return lManager;
 }
 
+UST_SparseGridManager* UST_SparseGridManager::FindWorldManager(const UWorld* InWorld)
+{
+	FRWScopeLock ReadLock(WorldManagersLock, SLT_ReadOnly);
+
+	const TWeakObjectPtr<UST_SparseGridManager>* FoundManager = WorldManagers.Find(InWorld);
+	return FoundManager ? FoundManager->Get() : nullptr;
+}
+
 ////////////////////
 ///// Creation /////
 ////////////////////
@@ -134,6 +137,13 @@ void UST_SparseGridManager::OnRegister()
 			return;
 		}
 
+		// Register before building, so components registering during Init can find us
+		if (WSOwner->IsInPersistentLevel())
+		{
+			FRWScopeLock WriteLock(WorldManagersLock, SLT_Write);
+			WorldManagers.Add(lWorld, this);
+		}
+
 		// Build the Grid
 		InitializeGrids();
 	}
@@ -143,6 +153,18 @@ void UST_SparseGridManager::OnUnregister()
 {
 	UninitializeGrids();
 
+	{
+		FRWScopeLock WriteLock(WorldManagersLock, SLT_Write);
+		for (auto Itr = WorldManagers.CreateIterator(); Itr; ++Itr)
+		{
+			// Also drops entries of managers that were never unregistered cleanly
+			if (!Itr.Value().IsValid() || Itr.Value().Get() == this)
+			{
+				Itr.RemoveCurrent();
+			}
+		}
+	}
+
 	Super::OnUnregister();
 }
 
@@ -167,6 +189,7 @@ void UST_SparseGridManager::TickComponent(float DeltaTime, enum ELevelTick TickT
 
 	if (AreGridsInitialized())
 	{
+		ProcessPendingRegistrations();
 		UpdateGrids();
 	}
 }
@@ -218,5 +241,95 @@ void UST_SparseGridManager::UninitializeGrids()
 		}
 
 		DestroyGrids();
+		bGridsInitialized = false;
+
+		// Nothing left to register with, components already in the world are picked up again by the next CreateGrids()
+		PendingRegistrations.Empty();
+	}
+}
+
+////////////////////////
+///// Registration /////
+////////////////////////
+
+void UST_SparseGridManager::RegisterGridComponents(TArrayView<UST_SparseGridComponent* const> InComponents)
+{
+	for (UST_SparseGridComponent* ComponentItr : InComponents)
+	{
+		RegisterGridComponent(ComponentItr);
+	}
+}
+
+void UST_SparseGridManager::UnregisterLevelGridComponents(const ULevel* InLevel)
+{
+	checkf(InLevel != nullptr, TEXT("UST_SparseGridManager::UnregisterLevelGridComponents() - Invalid Level"));
+
+	for (AActor* ActorItr : InLevel->Actors)
+	{
+		if (ActorItr)
+		{
+			ActorItr->ForEachComponent<UST_SparseGridComponent>(false, [this](UST_SparseGridComponent* InComponent)
+			{
+				if (InComponent->GetSparseGridData().IsValid())
+				{
+					UnregisterGridComponent(InComponent);
+				}
+			});
+		}
+	}
+}
+
+void UST_SparseGridManager::QueueGridComponentRegistration(UST_SparseGridComponent* InComponent)
+{
+	checkf(InComponent != nullptr, TEXT("UST_SparseGridManager::QueueGridComponentRegistration() - Invalid Component"));
+
+	PendingRegistrations.Enqueue(InComponent);
+}
+
+void UST_SparseGridManager::ProcessPendingRegistrations()
+{
+	check(IsInGameThread());
+
+	if (PendingRegistrations.IsEmpty())
+	{
+		return;
 	}
+
+	// A component may be queued more than once in a frame
+	PendingRequests.Reset();
+
+	TWeakObjectPtr<UST_SparseGridComponent> Request;
+	while (PendingRegistrations.Dequeue(Request))
+	{
+		UST_SparseGridComponent* Component = Request.Get();
+		if (Component)
+		{
+			PendingRequests.Add(Component);
+		}
+	}
+
+	PendingBatch.Reset();
+	for (UST_SparseGridComponent* Component : PendingRequests)
+	{
+		// Components unregistered since queueing are dropped
+		if (Component->IsRegistered() && !Component->IsPendingKill())
+		{
+			PendingBatch.Add(Component);
+		}
+	}
+
+	if (PendingBatch.Num() > 0)
+	{
+		RegisterGridComponents(PendingBatch);
+
+		for (UST_SparseGridComponent* ComponentItr : PendingBatch)
+		{
+			if (ComponentItr->GetSparseGridData().IsValid())
+			{
+				ComponentItr->OnAddedToSparseGrid();
+			}
+		}
+	}
+
+	UE_LOG(LogST_SparseGridManager, Verbose, TEXT("UST_SparseGridManager::ProcessPendingRegistrations() - Applied '%i' queued registrations, '%i' added"), PendingRequests.Num(), PendingBatch.Num());
 }
\ No newline at end of file
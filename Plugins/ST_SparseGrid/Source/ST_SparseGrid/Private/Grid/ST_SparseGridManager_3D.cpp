@@ -0,0 +1,169 @@
+// Copyright (C) James Baxter. All Rights Reserved.
+
+#include "ST_SparseGridManager_3D.h"
+#include "ST_SparseGrid3D.h"
+#include "ST_SparseGridData_3D.h"
+#include "ST_SparseGridComponent.h"
+
+// Extras
+#include "Misc/MemStack.h"
+
+#if WITH_EDITOR
+const FName UST_SparseGridManager_3D::GRIDNAME_3D = FName("3D");
+#endif
+
+///////////////////////
+///// Constructor /////
+///////////////////////
+
+UST_SparseGridManager_3D::UST_SparseGridManager_3D(const FObjectInitializer& OI)
+	: Super(OI)
+{}
+
+///////////////////////////////
+///// Grid Initialization /////
+///////////////////////////////
+
+void UST_SparseGridManager_3D::CreateGrids()
+{
+	const UST_SparseGridData_3D* VoxelData = Cast<UST_SparseGridData_3D>(GetGridConfig());
+	checkf(VoxelData, TEXT("Sparse Grid - 3D requires Sparse Grid Data - 3D, found '%s'"), *GetNameSafe(GetGridConfig()));
+
+	SparseGridData_3D = MakeShareable(new TST_SparseGrid3D<UST_SparseGridComponent>(
+		GetWorld(),
+		VoxelData->GetGridOrigin3D(),
+		VoxelData->GetNumCells3D(),
+		VoxelData->GetCellSize(),
+		VoxelData->GetCellSizeZ(),
+		VoxelData->GetRegisterAllocSize(),
+		VoxelData->GetRegisterAllocShrinkMultiplier(),
+		VoxelData->GetCellAllocSize(),
+		VoxelData->GetCellAllocShrinkMultiplier()));
+
+	SparseGridData_3D->Init(false);
+}
+
+void UST_SparseGridManager_3D::DestroyGrids()
+{
+	SparseGridData_3D.Reset();
+}
+
+void UST_SparseGridManager_3D::UpdateGrids()
+{
+	GetSparseGrid_3D()->Update();
+
+#if SPARSE_GRID_DEBUG
+	if (ST_SparseGridCVars::CVarDrawDebug.GetValueOnGameThread())
+	{
+		GetSparseGrid_3D()->DrawDebugGrid();
+	}
+#endif
+}
+
+////////////////////////
+///// Registration /////
+////////////////////////
+
+bool UST_SparseGridManager_3D::RegisterGridComponent(UST_SparseGridComponent* InComponent)
+{
+	return AreGridsInitialized() && GetSparseGrid_3D()->Add(InComponent);
+}
+
+bool UST_SparseGridManager_3D::UnregisterGridComponent(UST_SparseGridComponent* InComponent)
+{
+	return AreGridsInitialized() && GetSparseGrid_3D()->Remove(InComponent);
+}
+
+//////////////////
+///// Editor /////
+//////////////////
+
+#if WITH_EDITOR
+bool UST_SparseGridManager_3D::GetGridNames(TArray<FName>& OutGridNames) const
+{
+	OutGridNames.Reset(1);
+	OutGridNames.Add(GRIDNAME_3D);
+
+	return true;
+}
+
+bool UST_SparseGridManager_3D::GetGridPopulationData(const FName InGridName, TArray<uint32>& OutData) const
+{
+	if (ensure(InGridName == GRIDNAME_3D))
+	{
+		// Heat-map is 2D, so each entry is the population of a whole column
+		GetSparseGrid_3D()->GetGridCellPopulations(OutData);
+		return true;
+	}
+
+	return false;
+}
+
+bool UST_SparseGridManager_3D::GetGridMemoryInfo(const FName InGridName, int32& OutTotalObjects, uint64& OutRegisterAllocSize, uint64& OutRegisterUsedSize, uint64& OutCellAllocSize, uint64& OutCellUsedSize) const
+{
+	if (ensure(InGridName == GRIDNAME_3D))
+	{
+		GetSparseGrid_3D()->GetEditorDebugInfo(OutTotalObjects, OutRegisterAllocSize, OutRegisterUsedSize, OutCellAllocSize, OutCellUsedSize);
+		return true;
+	}
+
+	return false;
+}
+#endif
+
+////////////////////////////
+///// Blueprint Access /////
+////////////////////////////
+
+const TArray<UST_SparseGridComponent*>& UST_SparseGridManager_3D::GetGridComponents() const
+{
+	check(AreGridsInitialized());
+	return GetSparseGrid_3D()->GetRegisteredObjects();
+}
+
+FST_SparseGridCellTile3D UST_SparseGridManager_3D::GetSearchTile(const FVector& WorldSearchOrigin, const FVector& WorldSearchExtents) const
+{
+	return AreGridsInitialized() ? GetSparseGrid_3D()->GetSearchTile(WorldSearchOrigin, WorldSearchExtents) : FST_SparseGridCellTile3D();
+}
+
+//////////////////////////
+///// Search Queries /////
+//////////////////////////
+
+bool UST_SparseGridManager_3D::K2_GetComponents_Sphere(const UObject* WorldContextObject, TArray<UST_SparseGridComponent*>& GridComponents, const FVector& InWorldLocation, const float InSphereRadius, const bool bDrawDebug /*= false*/)
+{
+	GridComponents.Reset();
+
+	const UST_SparseGridManager_3D* VoxelManager = Cast<UST_SparseGridManager_3D>(UST_SparseGridManager::Get(WorldContextObject));
+	if (VoxelManager && VoxelManager->AreGridsInitialized())
+	{
+		FMemMark Mark(FMemStack::Get());
+
+		TST_SparseGrid3D<UST_SparseGridComponent>::FScratchResults Results;
+		VoxelManager->GetSparseGrid_3D()->QueryGrid_Sphere(Results, InWorldLocation, InSphereRadius, bDrawDebug);
+
+		GridComponents.Append(Results);
+		return true;
+	}
+
+	return false;
+}
+
+bool UST_SparseGridManager_3D::K2_GetComponents_Box(const UObject* WorldContextObject, TArray<UST_SparseGridComponent*>& GridComponents, const FVector& InWorldLocation, const FVector& InBoxExtents, const bool bDrawDebug /*= false*/)
+{
+	GridComponents.Reset();
+
+	const UST_SparseGridManager_3D* VoxelManager = Cast<UST_SparseGridManager_3D>(UST_SparseGridManager::Get(WorldContextObject));
+	if (VoxelManager && VoxelManager->AreGridsInitialized())
+	{
+		FMemMark Mark(FMemStack::Get());
+
+		TST_SparseGrid3D<UST_SparseGridComponent>::FScratchResults Results;
+		VoxelManager->GetSparseGrid_3D()->QueryGrid_Box(Results, InWorldLocation, InBoxExtents, bDrawDebug);
+
+		GridComponents.Append(Results);
+		return true;
+	}
+
+	return false;
+}
\ No newline at end of file
@@ -5,6 +5,11 @@
 #include "ST_SparseGridData.h"
 #include "ST_SparseGridComponent.h"
 
+// Extras
+#include "GameFramework/Actor.h"
+#include "Misc/MemStack.h"
+#include "Math/RandomStream.h"
+
 #if WITH_EDITOR
 const FName UST_SparseGridManager_Basic::GRIDNAME_Basic = FName("Default");
 #endif
@@ -35,6 +40,12 @@ void UST_SparseGridManager_Basic::CreateGrids()
 		BasicData->GetCellAllocSize(),
 		BasicData->GetCellAllocShrinkMultiplier()));
 
+	SparseGridData_Basic->SetCellLayout(BasicData->GetCellLayout());
+	SparseGridData_Basic->SetUpdateMode(BasicData->GetUpdateMode(), BasicData->GetParallelUpdateBatchSize());
+	SparseGridData_Basic->SetAutoRebuildThreshold(BasicData->GetAutoRebuildThreshold());
+	SparseGridData_Basic->SetIncrementalUpdate(BasicData->GetIncrementalUpdate());
+	SparseGridData_Basic->SetPublishSnapshots(BasicData->GetPublishSnapshots());
+	SparseGridData_Basic->SetCoarseLevels(BasicData->GetNumCoarseLevels(), BasicData->GetCoarseLevelRatio());
 	SparseGridData_Basic->Init(false);
 }
 
@@ -55,6 +66,55 @@ void UST_SparseGridManager_Basic::UpdateGrids()
 #endif
 }
 
+////////////////////////
+///// Registration /////
+////////////////////////
+
+bool UST_SparseGridManager_Basic::RegisterGridComponent(UST_SparseGridComponent* InComponent)
+{
+	return AreGridsInitialized() && GetSparseGrid_Basic()->Add(InComponent);
+}
+
+void UST_SparseGridManager_Basic::RegisterGridComponents(TArrayView<UST_SparseGridComponent* const> InComponents)
+{
+	if (AreGridsInitialized())
+	{
+		GetSparseGrid_Basic()->AddBatch(InComponents);
+	}
+}
+
+void UST_SparseGridManager_Basic::UnregisterLevelGridComponents(const ULevel* InLevel)
+{
+	if (!AreGridsInitialized())
+	{
+		return;
+	}
+
+	const int32 NumRemoved = GetSparseGrid_Basic()->RemoveAll([InLevel](const UST_SparseGridComponent* InComponent)
+	{
+		return InComponent->GetOwner() && InComponent->GetOwner()->GetLevel() == InLevel;
+	}, false);
+
+	// Only keep cell storage for what is still loaded
+	if (NumRemoved > 0)
+	{
+		GetSparseGrid_Basic()->Compact();
+	}
+}
+
+bool UST_SparseGridManager_Basic::UnregisterGridComponent(UST_SparseGridComponent* InComponent)
+{
+	return AreGridsInitialized() && GetSparseGrid_Basic()->Remove(InComponent);
+}
+
+void UST_SparseGridManager_Basic::MarkGridComponentDirty(UST_SparseGridComponent* InComponent)
+{
+	if (AreGridsInitialized())
+	{
+		GetSparseGrid_Basic()->MarkDirty(InComponent);
+	}
+}
+
 //////////////////
 ///// Editor /////
 //////////////////
@@ -121,13 +181,30 @@ void UST_SparseGridManager_Basic::K2_GetCellComponents(const int32 CellID, TArra
 	Components.Reset();
 	if (GetSparseGrid_Basic()->GetGridCells().IsValidIndex(CellID))
 	{
-		Components = GetSparseGrid_Basic()->GetGridCells()[CellID].GetObjects();
+		const TArrayView<UST_SparseGridComponent* const> CellObjects = GetSparseGrid_Basic()->GetGridCells()[CellID].GetObjects();
+		Components.Append(CellObjects.GetData(), CellObjects.Num());
 	}
 }
 
 void UST_SparseGridManager_Basic::K2_GetTileComponents(const FST_SparseGridCellTile& Tile, TArray<UST_SparseGridComponent*>& Components) const
 {
-	Components.Reset();
+	const auto& GridCells = GetSparseGrid_Basic()->GetGridCells();
+
+	// Count first, so we only allocate once
+	int32 NumComponents = 0;
+	for (int32 CIdx = Tile.Start.Y; CIdx < Tile.End.Y; CIdx++)
+	{
+		for (int32 RIdx = Tile.Start.X; RIdx < Tile.End.X; RIdx++)
+		{
+			const int32 CellIndex = GetSparseGrid_Basic()->GetCellIndex(FST_GridRef2D(RIdx, CIdx));
+			if (GridCells.IsValidIndex(CellIndex))
+			{
+				NumComponents += GridCells[CellIndex].GetObjects().Num();
+			}
+		}
+	}
+
+	Components.Reset(NumComponents);
 	
 	for (int32 CIdx = Tile.Start.Y; CIdx < Tile.End.Y; CIdx++)
 	{
@@ -135,19 +212,14 @@ void UST_SparseGridManager_Basic::K2_GetTileComponents(const FST_SparseGridCellT
 		{
 			const FST_GridRef2D CellXY = FST_GridRef2D(RIdx, CIdx);
 			const int32 CellIndex = GetSparseGrid_Basic()->GetCellIndex(CellXY);
-			if (GetSparseGrid_Basic()->GetGridCells().IsValidIndex(CellIndex))
+			if (GridCells.IsValidIndex(CellIndex))
 			{
-				Components.Append(GetSparseGrid_Basic()->GetGridCells()[CellIndex].GetObjects());
+				Components.Append(GridCells[CellIndex].GetObjects().GetData(), GridCells[CellIndex].GetObjects().Num());
 			}
 		}
 	}
 }
 
-float UST_SparseGridManager_Basic::K2_GetCellBoundsRadius() const
-{
-	return AreGridsInitialized() ? GetSparseGrid_Basic()->GetCellBoundsRadius() : -1.f;
-}
-
 FST_GridRef2D UST_SparseGridManager_Basic::K2_ConvertToGridRef2D(const int32 CellID) const
 {
 	return AreGridsInitialized() ? GetSparseGrid_Basic()->GetCellXY(CellID) : FST_GridRef2D(INDEX_NONE);
@@ -162,76 +234,232 @@ int32 UST_SparseGridManager_Basic::K2_ConvertToCellID(const FST_GridRef2D& XY) c
 ///// Search Queries /////
 //////////////////////////
 
-bool UST_SparseGridManager_Basic::K2_GetComponents_Sphere(const UObject* WorldContextObject, TArray<UST_SparseGridComponent*>& GridComponents, const FVector& InWorldLocation, const float InSphereRadius, const bool bDrawDebug /*= false*/)
+/*
+* Runs a query into the calling thread's scratch memory, then copies the results out with at most one allocation.
+*/
+template<class QueryFuncType>
+static void QueryGrid_Scratch(TArray<UST_SparseGridComponent*>& OutComponents, const QueryFuncType& QueryFunc)
+{
+	FMemMark Mark(FMemStack::Get());
+
+	TST_SparseGrid<UST_SparseGridComponent>::FScratchResults Results;
+	QueryFunc(Results);
+
+	OutComponents.Reset(Results.Num());
+	OutComponents.Append(Results);
+}
+
+bool UST_SparseGridManager_Basic::K2_GetComponents_Sphere(const UObject* WorldContextObject, TArray<UST_SparseGridComponent*>& GridComponents, const FVector& InWorldLocation, const float InSphereRadius, const int32 InIncludeCategories, const int32 InExcludeCategories, const bool bDrawDebug /*= false*/)
 {
 	GridComponents.Reset();
 
 	const UST_SparseGridManager_Basic* BasicManager = Cast<UST_SparseGridManager_Basic>(UST_SparseGridManager::Get(WorldContextObject));
 	if (BasicManager && BasicManager->AreGridsInitialized())
 	{
-		BasicManager->GetSparseGrid_Basic()->QueryGrid_Sphere(GridComponents, InWorldLocation, InSphereRadius, bDrawDebug);
+		const TSharedRef<TST_SparseGrid<UST_SparseGridComponent>> Grid = BasicManager->GetSparseGrid_Basic();
+		const FST_SparseGridCategoryFilter Filter((uint32)InIncludeCategories, (uint32)InExcludeCategories);
+		QueryGrid_Scratch(GridComponents, [&](TST_SparseGrid<UST_SparseGridComponent>::FScratchResults& Results)
+		{
+			Grid->QueryGrid_Sphere(Results, InWorldLocation, InSphereRadius, Filter, bDrawDebug);
+		});
+
 		return true;
 	}
 
 	return false;
 }
 
-bool UST_SparseGridManager_Basic::K2_GetComponents_Capsule(const UObject* WorldContextObject, TArray<UST_SparseGridComponent*>& GridComponents, const FVector& WorldLocation, const FVector& CapsuleAxis, const float CapsuleRadius, const float CapsuleHalfHeight, const bool bDrawDebug /*= false*/)
+bool UST_SparseGridManager_Basic::K2_GetComponents_Capsule(const UObject* WorldContextObject, TArray<UST_SparseGridComponent*>& GridComponents, const FVector& WorldLocation, const FVector& CapsuleAxis, const float CapsuleRadius, const float CapsuleHalfHeight, const int32 InIncludeCategories, const int32 InExcludeCategories, const bool bDrawDebug /*= false*/)
 {
 	GridComponents.Reset();
 
 	const UST_SparseGridManager_Basic* BasicManager = Cast<UST_SparseGridManager_Basic>(UST_SparseGridManager::Get(WorldContextObject));
 	if (BasicManager && BasicManager->AreGridsInitialized())
 	{
-		BasicManager->GetSparseGrid_Basic()->QueryGrid_Capsule(GridComponents, WorldLocation, CapsuleAxis, CapsuleRadius, CapsuleHalfHeight, bDrawDebug);
+		const TSharedRef<TST_SparseGrid<UST_SparseGridComponent>> Grid = BasicManager->GetSparseGrid_Basic();
+		const FST_SparseGridCategoryFilter Filter((uint32)InIncludeCategories, (uint32)InExcludeCategories);
+		QueryGrid_Scratch(GridComponents, [&](TST_SparseGrid<UST_SparseGridComponent>::FScratchResults& Results)
+		{
+			Grid->QueryGrid_Capsule(Results, WorldLocation, CapsuleAxis, CapsuleRadius, CapsuleHalfHeight, Filter, bDrawDebug);
+		});
+
 		return true;
 	}
 
 	return false;
 }
 
-bool UST_SparseGridManager_Basic::K2_GetComponents_Box(const UObject* WorldContextObject, TArray<UST_SparseGridComponent*>& GridComponents, const FVector& InWorldLocation, const FVector& InBoxExtents, const bool bDrawDebug /*= false*/)
+bool UST_SparseGridManager_Basic::K2_GetComponents_Box(const UObject* WorldContextObject, TArray<UST_SparseGridComponent*>& GridComponents, const FVector& InWorldLocation, const FVector& InBoxExtents, const int32 InIncludeCategories, const int32 InExcludeCategories, const bool bDrawDebug /*= false*/)
 {
 	GridComponents.Reset();
 
 	const UST_SparseGridManager_Basic* BasicManager = Cast<UST_SparseGridManager_Basic>(UST_SparseGridManager::Get(WorldContextObject));
 	if (BasicManager && BasicManager->AreGridsInitialized())
 	{
-		BasicManager->GetSparseGrid_Basic()->QueryGrid_Box(GridComponents, InWorldLocation, InBoxExtents, bDrawDebug);
+		const TSharedRef<TST_SparseGrid<UST_SparseGridComponent>> Grid = BasicManager->GetSparseGrid_Basic();
+		const FST_SparseGridCategoryFilter Filter((uint32)InIncludeCategories, (uint32)InExcludeCategories);
+		QueryGrid_Scratch(GridComponents, [&](TST_SparseGrid<UST_SparseGridComponent>::FScratchResults& Results)
+		{
+			Grid->QueryGrid_Box(Results, InWorldLocation, InBoxExtents, Filter, bDrawDebug);
+		});
+
 		return true;
 	}
 
 	return false;
 }
 
-bool UST_SparseGridManager_Basic::K2_GetComponents_RotatedBox(const UObject* WorldContextObject, TArray<UST_SparseGridComponent*>& GridComponents, const FVector& InWorldLocation, const FRotator& InBoxRotation, const FVector& InBoxExtents, const bool bDrawDebug /*= false*/)
+bool UST_SparseGridManager_Basic::K2_GetComponents_RotatedBox(const UObject* WorldContextObject, TArray<UST_SparseGridComponent*>& GridComponents, const FVector& InWorldLocation, const FRotator& InBoxRotation, const FVector& InBoxExtents, const int32 InIncludeCategories, const int32 InExcludeCategories, const bool bDrawDebug /*= false*/)
 {
 	GridComponents.Reset();
 
 	const UST_SparseGridManager_Basic* BasicManager = Cast<UST_SparseGridManager_Basic>(UST_SparseGridManager::Get(WorldContextObject));
 	if (BasicManager && BasicManager->AreGridsInitialized())
 	{
-		BasicManager->GetSparseGrid_Basic()->QueryGrid_RotatedBox(GridComponents, InWorldLocation, InBoxRotation.Quaternion(), InBoxExtents, bDrawDebug);
+		const TSharedRef<TST_SparseGrid<UST_SparseGridComponent>> Grid = BasicManager->GetSparseGrid_Basic();
+		const FST_SparseGridCategoryFilter Filter((uint32)InIncludeCategories, (uint32)InExcludeCategories);
+		QueryGrid_Scratch(GridComponents, [&](TST_SparseGrid<UST_SparseGridComponent>::FScratchResults& Results)
+		{
+			Grid->QueryGrid_RotatedBox(Results, InWorldLocation, InBoxRotation.Quaternion(), InBoxExtents, Filter, bDrawDebug);
+		});
+
 		return true;
 	}
 
 	return false;
 }
 
-bool UST_SparseGridManager_Basic::K2_GetComponents_Cone(const UObject* WorldContextObject, TArray<UST_SparseGridComponent*>& GridComponents, const FVector& InWorldLocation, const float InConeLength, const float InConeHalfAngleRadians, const FVector& InAxis, const bool bDrawDebug /*= false*/)
+bool UST_SparseGridManager_Basic::K2_GetComponents_Cone(const UObject* WorldContextObject, TArray<UST_SparseGridComponent*>& GridComponents, const FVector& InWorldLocation, const float InConeLength, const float InConeHalfAngleRadians, const FVector& InAxis, const int32 InIncludeCategories, const int32 InExcludeCategories, const bool bDrawDebug /*= false*/)
 {
 	GridComponents.Reset();
 
 	const UST_SparseGridManager_Basic* BasicManager = Cast<UST_SparseGridManager_Basic>(UST_SparseGridManager::Get(WorldContextObject));
 	if (BasicManager && BasicManager->AreGridsInitialized())
 	{
-		BasicManager->GetSparseGrid_Basic()->QueryGrid_Cone(GridComponents, InWorldLocation, InConeLength, InConeHalfAngleRadians, InAxis, bDrawDebug);
+		const TSharedRef<TST_SparseGrid<UST_SparseGridComponent>> Grid = BasicManager->GetSparseGrid_Basic();
+		const FST_SparseGridCategoryFilter Filter((uint32)InIncludeCategories, (uint32)InExcludeCategories);
+		QueryGrid_Scratch(GridComponents, [&](TST_SparseGrid<UST_SparseGridComponent>::FScratchResults& Results)
+		{
+			Grid->QueryGrid_Cone(Results, InWorldLocation, InConeLength, InConeHalfAngleRadians, InAxis, Filter, bDrawDebug);
+		});
+
 		return true;
 	}
 
 	return false;
 }
 
+UST_SparseGridComponent* UST_SparseGridManager_Basic::K2_GetComponent_Nearest(const UObject* WorldContextObject, const FVector& InWorldLocation, const float InMaxDistance, const TSubclassOf<AActor> InOwnerClass, const int32 InIncludeCategories, const int32 InExcludeCategories, const bool bDrawDebug /*= false*/)
+{
+	const UST_SparseGridManager_Basic* BasicManager = Cast<UST_SparseGridManager_Basic>(UST_SparseGridManager::Get(WorldContextObject));
+	if (BasicManager && BasicManager->AreGridsInitialized())
+	{
+		const UClass* OwnerClass = InOwnerClass.Get();
+		const FST_SparseGridCategoryFilter Filter((uint32)InIncludeCategories, (uint32)InExcludeCategories);
+		return BasicManager->GetSparseGrid_Basic()->QueryGrid_Nearest(InWorldLocation, InMaxDistance, Filter, [OwnerClass](const UST_SparseGridComponent* Component)
+		{
+			return !OwnerClass || (Component->GetOwner() && Component->GetOwner()->IsA(OwnerClass));
+		}, bDrawDebug);
+	}
+
+	return nullptr;
+}
+
+bool UST_SparseGridManager_Basic::K2_GetComponents_KNearest(const UObject* WorldContextObject, TArray<UST_SparseGridComponent*>& GridComponents, const FVector& InWorldLocation, const int32 InK, const float InMaxDistance, const TSubclassOf<AActor> InOwnerClass, const int32 InIncludeCategories, const int32 InExcludeCategories, const bool bDrawDebug /*= false*/)
+{
+	GridComponents.Reset();
+
+	const UST_SparseGridManager_Basic* BasicManager = Cast<UST_SparseGridManager_Basic>(UST_SparseGridManager::Get(WorldContextObject));
+	if (BasicManager && BasicManager->AreGridsInitialized())
+	{
+		const UClass* OwnerClass = InOwnerClass.Get();
+		const FST_SparseGridCategoryFilter Filter((uint32)InIncludeCategories, (uint32)InExcludeCategories);
+		BasicManager->GetSparseGrid_Basic()->QueryGrid_KNearest(GridComponents, InWorldLocation, InK, InMaxDistance, Filter, [OwnerClass](const UST_SparseGridComponent* Component)
+		{
+			return !OwnerClass || (Component->GetOwner() && Component->GetOwner()->IsA(OwnerClass));
+		}, bDrawDebug);
+
+		return true;
+	}
+
+	return false;
+}
+
+////////////////////////
+///// Benchmarking /////
+////////////////////////
+
+#if SPARSE_GRID_DEBUG
+namespace ST_SparseGridBenchmark
+{
+	/*
+	* Times box queries covering 3x3 to 9x9 cell tiles with each cell layout, then restores the original layout.
+	* Both layouts are tested against the same random query locations inside the grid.
+	*/
+	static void BenchmarkLayout(const TArray<FString>& Args, UWorld* InWorld)
+	{
+		const UST_SparseGridManager_Basic* BasicManager = Cast<UST_SparseGridManager_Basic>(UST_SparseGridManager::Get(InWorld));
+		if (!BasicManager || !BasicManager->AreGridsInitialized())
+		{
+			UE_LOG(LogST_SparseGridManager, Warning, TEXT("SparseGrid.BenchmarkLayout - World has no initialized Sparse Grid - Basic"));
+			return;
+		}
+
+		const int32 NumQueries = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 1000;
+
+		const TSharedRef<TST_SparseGrid<UST_SparseGridComponent>> Grid = BasicManager->GetSparseGrid_Basic();
+		const EST_SparseGridCellLayout OriginalLayout = Grid->GetCellLayout();
+		const FVector2D GridMin = Grid->GetGridOrigin().ToVector();
+		const FVector2D GridMax = Grid->GetGridMax().ToVector();
+
+		FRandomStream Stream = FRandomStream(NumQueries);
+		TArray<FVector> Locations;
+		Locations.Reserve(NumQueries);
+		for (int32 QueryIdx = 0; QueryIdx < NumQueries; QueryIdx++)
+		{
+			Locations.Add(FVector(Stream.FRandRange(GridMin.X, GridMax.X), Stream.FRandRange(GridMin.Y, GridMax.Y), 0.f));
+		}
+
+		const EST_SparseGridCellLayout Layouts[] = { EST_SparseGridCellLayout::RowMajor, EST_SparseGridCellLayout::Morton };
+		for (const EST_SparseGridCellLayout LayoutItr : Layouts)
+		{
+			Grid->SetCellLayout(LayoutItr);
+
+			for (int32 TileSize = 3; TileSize <= 9; TileSize += 2)
+			{
+				// Slightly under the tile width, so queries cover TileSize or TileSize + 1 cells depending on alignment
+				const float HalfExtent = (TileSize - 1) * Grid->GetCellSize() * 0.5f;
+				const FVector Extents = FVector(HalfExtent, HalfExtent, HALF_WORLD_MAX);
+
+				FMemMark Mark(FMemStack::Get());
+				TST_SparseGrid<UST_SparseGridComponent>::FScratchResults Results;
+
+				int64 NumResults = 0;
+				const double StartTime = FPlatformTime::Seconds();
+				for (const FVector& LocationItr : Locations)
+				{
+					Results.Reset();
+					Grid->QueryGrid_Box(Results, LocationItr, Extents);
+					NumResults += Results.Num();
+				}
+
+				const double ElapsedMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+				UE_LOG(LogST_SparseGridManager, Display, TEXT("SparseGrid.BenchmarkLayout - %s, %ix%i Tiles: %.3fms for %i queries (%.3fus per query, %lld results)"),
+					LayoutItr == EST_SparseGridCellLayout::Morton ? TEXT("Morton") : TEXT("Row Major"), TileSize, TileSize, ElapsedMs, NumQueries, (ElapsedMs * 1000.0) / NumQueries, NumResults);
+			}
+		}
+
+		Grid->SetCellLayout(OriginalLayout);
+	}
+
+	static FAutoConsoleCommandWithWorldAndArgs BenchmarkLayoutCommand(
+		TEXT("SparseGrid.BenchmarkLayout"),
+		TEXT("Compares query times of the Row Major and Morton cell layouts on 3x3 to 9x9 cell tiles\n")
+		TEXT("Arg 0: Number of queries per tile size (default 1000)"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&BenchmarkLayout));
+}
+#endif
+
 //////////////////////////////////
 ///// Example Search Queries /////
 //////////////////////////////////
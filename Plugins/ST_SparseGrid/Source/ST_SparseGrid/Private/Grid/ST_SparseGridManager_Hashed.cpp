@@ -0,0 +1,168 @@
+// Copyright (C) James Baxter. All Rights Reserved.
+
+#include "ST_SparseGridManager_Hashed.h"
+#include "ST_SparseHashGrid.h"
+#include "ST_SparseGridData.h"
+#include "ST_SparseGridComponent.h"
+
+// Extras
+#include "Misc/MemStack.h"
+
+#if WITH_EDITOR
+const FName UST_SparseGridManager_Hashed::GRIDNAME_Hashed = FName("Hashed");
+#endif
+
+///////////////////////
+///// Constructor /////
+///////////////////////
+
+UST_SparseGridManager_Hashed::UST_SparseGridManager_Hashed(const FObjectInitializer& OI)
+	: Super(OI)
+{}
+
+///////////////////////////////
+///// Grid Initialization /////
+///////////////////////////////
+
+void UST_SparseGridManager_Hashed::CreateGrids()
+{
+	const UST_SparseGridData* HashedData = GetGridConfig();
+
+	SparseGridData_Hashed = MakeShareable(new TST_SparseHashGrid<UST_SparseGridComponent>(
+		GetWorld(),
+		HashedData->GetCellSize(),
+		HashedData->GetRegisterAllocSize(),
+		HashedData->GetRegisterAllocShrinkMultiplier(),
+		HashedData->GetCellAllocSize(),
+		HashedData->GetCellAllocShrinkMultiplier()));
+
+	SparseGridData_Hashed->Init(false);
+}
+
+void UST_SparseGridManager_Hashed::DestroyGrids()
+{
+	SparseGridData_Hashed.Reset();
+}
+
+void UST_SparseGridManager_Hashed::UpdateGrids()
+{
+	GetSparseGrid_Hashed()->Update();
+
+#if SPARSE_GRID_DEBUG
+	if (ST_SparseGridCVars::CVarDrawDebug.GetValueOnGameThread())
+	{
+		GetSparseGrid_Hashed()->DrawDebugGrid();
+	}
+#endif
+}
+
+////////////////////////
+///// Registration /////
+////////////////////////
+
+bool UST_SparseGridManager_Hashed::RegisterGridComponent(UST_SparseGridComponent* InComponent)
+{
+	return AreGridsInitialized() && GetSparseGrid_Hashed()->Add(InComponent);
+}
+
+bool UST_SparseGridManager_Hashed::UnregisterGridComponent(UST_SparseGridComponent* InComponent)
+{
+	return AreGridsInitialized() && GetSparseGrid_Hashed()->Remove(InComponent);
+}
+
+//////////////////
+///// Editor /////
+//////////////////
+
+#if WITH_EDITOR
+bool UST_SparseGridManager_Hashed::GetGridNames(TArray<FName>& OutGridNames) const
+{
+	OutGridNames.Reset(1);
+	OutGridNames.Add(GRIDNAME_Hashed);
+
+	return true;
+}
+
+bool UST_SparseGridManager_Hashed::GetGridPopulationData(const FName InGridName, TArray<uint32>& OutData) const
+{
+	if (ensure(InGridName == GRIDNAME_Hashed))
+	{
+		// Heat-map shows the window described by the grid data
+		const UST_SparseGridData* HashedData = GetGridConfig();
+		GetSparseGrid_Hashed()->GetGridCellPopulations(OutData, HashedData->GetGridOrigin(), FST_GridRef2D(HashedData->GetNumCellsX(), HashedData->GetNumCellsY()));
+		return true;
+	}
+
+	return false;
+}
+
+bool UST_SparseGridManager_Hashed::GetGridMemoryInfo(const FName InGridName, int32& OutTotalObjects, uint64& OutRegisterAllocSize, uint64& OutRegisterUsedSize, uint64& OutCellAllocSize, uint64& OutCellUsedSize) const
+{
+	if (ensure(InGridName == GRIDNAME_Hashed))
+	{
+		GetSparseGrid_Hashed()->GetEditorDebugInfo(OutTotalObjects, OutRegisterAllocSize, OutRegisterUsedSize, OutCellAllocSize, OutCellUsedSize);
+		return true;
+	}
+
+	return false;
+}
+#endif
+
+////////////////////////////
+///// Blueprint Access /////
+////////////////////////////
+
+const TArray<UST_SparseGridComponent*>& UST_SparseGridManager_Hashed::GetGridComponents() const
+{
+	check(AreGridsInitialized());
+	return GetSparseGrid_Hashed()->GetRegisteredObjects();
+}
+
+int32 UST_SparseGridManager_Hashed::K2_GetNumPopulatedCells() const
+{
+	return AreGridsInitialized() ? GetSparseGrid_Hashed()->GetNumPopulatedCells() : 0;
+}
+
+//////////////////////////
+///// Search Queries /////
+//////////////////////////
+
+bool UST_SparseGridManager_Hashed::K2_GetComponents_Sphere(const UObject* WorldContextObject, TArray<UST_SparseGridComponent*>& GridComponents, const FVector& InWorldLocation, const float InSphereRadius, const int32 InIncludeCategories, const int32 InExcludeCategories, const bool bDrawDebug /*= false*/)
+{
+	GridComponents.Reset();
+
+	const UST_SparseGridManager_Hashed* HashedManager = Cast<UST_SparseGridManager_Hashed>(UST_SparseGridManager::Get(WorldContextObject));
+	if (HashedManager && HashedManager->AreGridsInitialized())
+	{
+		FMemMark Mark(FMemStack::Get());
+
+		const FST_SparseGridCategoryFilter Filter((uint32)InIncludeCategories, (uint32)InExcludeCategories);
+		TST_SparseHashGrid<UST_SparseGridComponent>::FScratchResults Results;
+		HashedManager->GetSparseGrid_Hashed()->QueryGrid_Sphere(Results, InWorldLocation, InSphereRadius, Filter, bDrawDebug);
+
+		GridComponents.Append(Results);
+		return true;
+	}
+
+	return false;
+}
+
+bool UST_SparseGridManager_Hashed::K2_GetComponents_Box(const UObject* WorldContextObject, TArray<UST_SparseGridComponent*>& GridComponents, const FVector& InWorldLocation, const FVector& InBoxExtents, const int32 InIncludeCategories, const int32 InExcludeCategories, const bool bDrawDebug /*= false*/)
+{
+	GridComponents.Reset();
+
+	const UST_SparseGridManager_Hashed* HashedManager = Cast<UST_SparseGridManager_Hashed>(UST_SparseGridManager::Get(WorldContextObject));
+	if (HashedManager && HashedManager->AreGridsInitialized())
+	{
+		FMemMark Mark(FMemStack::Get());
+
+		const FST_SparseGridCategoryFilter Filter((uint32)InIncludeCategories, (uint32)InExcludeCategories);
+		TST_SparseHashGrid<UST_SparseGridComponent>::FScratchResults Results;
+		HashedManager->GetSparseGrid_Hashed()->QueryGrid_Box(Results, InWorldLocation, InBoxExtents, Filter, bDrawDebug);
+
+		GridComponents.Append(Results);
+		return true;
+	}
+
+	return false;
+}
\ No newline at end of file
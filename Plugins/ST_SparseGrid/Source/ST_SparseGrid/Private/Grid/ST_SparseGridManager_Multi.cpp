@@ -0,0 +1,366 @@
+// Copyright (C) James Baxter. All Rights Reserved.
+
+#include "ST_SparseGridManager_Multi.h"
+#include "ST_SparseGrid.h"
+#include "ST_SparseGridData_Multi.h"
+#include "ST_SparseGridComponent.h"
+
+// Extras
+#include "GameFramework/Actor.h"
+#include "Misc/MemStack.h"
+
+///////////////////////
+///// Constructor /////
+///////////////////////
+
+UST_SparseGridManager_Multi::UST_SparseGridManager_Multi(const FObjectInitializer& OI)
+	: Super(OI)
+{}
+
+///////////////////////////////
+///// Grid Initialization /////
+///////////////////////////////
+
+void UST_SparseGridManager_Multi::CreateGrids()
+{
+	const UST_SparseGridData* SharedData = GetGridConfig();
+	const UST_SparseGridData_Multi* MultiData = Cast<UST_SparseGridData_Multi>(SharedData);
+
+	// Without any entries, behave like the basic manager
+	TArray<FST_SparseGridNamedConfig> GridConfigs;
+	if (MultiData && MultiData->GetGrids().Num() > 0)
+	{
+		GridConfigs = MultiData->GetGrids();
+	}
+	else
+	{
+		FST_SparseGridNamedConfig& DefaultConfig = GridConfigs.AddDefaulted_GetRef();
+		DefaultConfig.GridName = FName("Default");
+		DefaultConfig.CellSize = SharedData->GetCellSize();
+		DefaultConfig.RegisterAllocSize = SharedData->GetRegisterAllocSize();
+		DefaultConfig.CellAllocSize = SharedData->GetCellAllocSize();
+		DefaultConfig.RegisterAllocShrinkMultiplier = SharedData->GetRegisterAllocShrinkMultiplier();
+		DefaultConfig.CellAllocShrinkMultiplier = SharedData->GetCellAllocShrinkMultiplier();
+	}
+
+	// Every grid covers at least the area described by the shared settings
+	const FST_GridRef2D WorldSize = FST_GridRef2D(SharedData->GetNumCellsX(), SharedData->GetNumCellsY()) * SharedData->GetCellSize();
+
+	SparseGrids.Reset();
+	SparseGrids.Reserve(GridConfigs.Num());
+	DefaultGridName = NAME_None;
+
+	for (const FST_SparseGridNamedConfig& ConfigItr : GridConfigs)
+	{
+		if (ConfigItr.GridName.IsNone() || ConfigItr.CellSize <= 0 || SparseGrids.Contains(ConfigItr.GridName))
+		{
+			UE_LOG(LogST_SparseGridManager, Warning, TEXT("UST_SparseGridManager_Multi::CreateGrids() - Skipping grid '%s', names must be set and unique and cell size must be positive"), *ConfigItr.GridName.ToString());
+			continue;
+		}
+
+		// Same limit as UST_SparseGridData::NumCellsX/Y, the cell array and Morton layout rely on it
+		const int32 MaxNumCells = 192;
+		const FST_GridRef2D WantedNumCells = FST_GridRef2D(
+			FMath::Max(FMath::DivideAndRoundUp(WorldSize.X, ConfigItr.CellSize), 1),
+			FMath::Max(FMath::DivideAndRoundUp(WorldSize.Y, ConfigItr.CellSize), 1));
+		const FST_GridRef2D GridNumCells = FST_GridRef2D(FMath::Min(WantedNumCells.X, MaxNumCells), FMath::Min(WantedNumCells.Y, MaxNumCells));
+
+		if (GridNumCells.X != WantedNumCells.X || GridNumCells.Y != WantedNumCells.Y)
+		{
+			UE_LOG(LogST_SparseGridManager, Warning, TEXT("UST_SparseGridManager_Multi::CreateGrids() - Grid '%s' would need %ix%i cells of size '%i', clamped to %ix%i. Objects beyond it are clamped to boundary cells, raise its cell size to cover the world."),
+				*ConfigItr.GridName.ToString(), WantedNumCells.X, WantedNumCells.Y, ConfigItr.CellSize, GridNumCells.X, GridNumCells.Y);
+		}
+
+		TSharedPtr<TST_SparseGrid<UST_SparseGridComponent>> NewGrid = MakeShareable(new TST_SparseGrid<UST_SparseGridComponent>(
+			GetWorld(),
+			SharedData->GetGridOrigin(),
+			GridNumCells,
+			ConfigItr.CellSize,
+			ConfigItr.RegisterAllocSize,
+			ConfigItr.RegisterAllocShrinkMultiplier,
+			ConfigItr.CellAllocSize,
+			ConfigItr.CellAllocShrinkMultiplier));
+
+		NewGrid->SetCellLayout(SharedData->GetCellLayout());
+		NewGrid->SetUpdateMode(SharedData->GetUpdateMode(), SharedData->GetParallelUpdateBatchSize());
+		NewGrid->SetAutoRebuildThreshold(SharedData->GetAutoRebuildThreshold());
+		NewGrid->SetIncrementalUpdate(SharedData->GetIncrementalUpdate());
+		NewGrid->SetPublishSnapshots(SharedData->GetPublishSnapshots());
+		NewGrid->SetCoarseLevels(SharedData->GetNumCoarseLevels(), SharedData->GetCoarseLevelRatio());
+		SparseGrids.Add(ConfigItr.GridName, NewGrid);
+
+		if (DefaultGridName.IsNone())
+		{
+			DefaultGridName = ConfigItr.GridName;
+		}
+	}
+
+	checkf(SparseGrids.Num() > 0, TEXT("UST_SparseGridManager_Multi::CreateGrids() - No valid grids"));
+
+	// Each grid takes the components already in the world that resolve to it
+	for (const TPair<FName, TSharedPtr<TST_SparseGrid<UST_SparseGridComponent>>>& GridItr : SparseGrids)
+	{
+		const FName GridName = GridItr.Key;
+		GridItr.Value->Init(false, [this, GridName](const UST_SparseGridComponent* Component)
+		{
+			return ResolveGridName(Component->GetGridName()) == GridName;
+		});
+	}
+}
+
+void UST_SparseGridManager_Multi::DestroyGrids()
+{
+	SparseGrids.Reset();
+	DefaultGridName = NAME_None;
+}
+
+void UST_SparseGridManager_Multi::UpdateGrids()
+{
+	for (const TPair<FName, TSharedPtr<TST_SparseGrid<UST_SparseGridComponent>>>& GridItr : SparseGrids)
+	{
+		GridItr.Value->Update();
+
+#if SPARSE_GRID_DEBUG
+		if (ST_SparseGridCVars::CVarDrawDebug.GetValueOnGameThread())
+		{
+			GridItr.Value->DrawDebugGrid();
+		}
+#endif
+	}
+}
+
+////////////////////////
+///// Registration /////
+////////////////////////
+
+bool UST_SparseGridManager_Multi::RegisterGridComponent(UST_SparseGridComponent* InComponent)
+{
+	return AreGridsInitialized() && GetSparseGrid(InComponent->GetGridName())->Add(InComponent);
+}
+
+void UST_SparseGridManager_Multi::RegisterGridComponents(TArrayView<UST_SparseGridComponent* const> InComponents)
+{
+	if (!AreGridsInitialized())
+	{
+		return;
+	}
+
+	// One batch per grid
+	TMap<FName, TArray<UST_SparseGridComponent*>> GridBatches;
+	for (UST_SparseGridComponent* ComponentItr : InComponents)
+	{
+		GridBatches.FindOrAdd(ResolveGridName(ComponentItr->GetGridName())).Add(ComponentItr);
+	}
+
+	for (const TPair<FName, TArray<UST_SparseGridComponent*>>& BatchItr : GridBatches)
+	{
+		GetSparseGrid(BatchItr.Key)->AddBatch(BatchItr.Value);
+	}
+}
+
+void UST_SparseGridManager_Multi::UnregisterLevelGridComponents(const ULevel* InLevel)
+{
+	if (!AreGridsInitialized())
+	{
+		return;
+	}
+
+	const auto IsInLevel = [InLevel](const UST_SparseGridComponent* InComponent)
+	{
+		return InComponent->GetOwner() && InComponent->GetOwner()->GetLevel() == InLevel;
+	};
+
+	// Only keep cell storage for what is still loaded
+	for (const TPair<FName, TSharedPtr<TST_SparseGrid<UST_SparseGridComponent>>>& GridItr : SparseGrids)
+	{
+		if (GridItr.Value->RemoveAll(IsInLevel, false) > 0)
+		{
+			GridItr.Value->Compact();
+		}
+	}
+}
+
+bool UST_SparseGridManager_Multi::UnregisterGridComponent(UST_SparseGridComponent* InComponent)
+{
+	return AreGridsInitialized() && GetSparseGrid(InComponent->GetGridName())->Remove(InComponent);
+}
+
+void UST_SparseGridManager_Multi::MarkGridComponentDirty(UST_SparseGridComponent* InComponent)
+{
+	if (AreGridsInitialized())
+	{
+		GetSparseGrid(InComponent->GetGridName())->MarkDirty(InComponent);
+	}
+}
+
+//////////////////
+///// Editor /////
+//////////////////
+
+#if WITH_EDITOR
+bool UST_SparseGridManager_Multi::GetGridNames(TArray<FName>& OutGridNames) const
+{
+	SparseGrids.GenerateKeyArray(OutGridNames);
+	return OutGridNames.Num() > 0;
+}
+
+bool UST_SparseGridManager_Multi::GetGridPopulationData(const FName InGridName, TArray<uint32>& OutData) const
+{
+	if (ensure(HasGrid(InGridName)))
+	{
+		// Heat-map is sized by the shared settings, which may not match this grid's cells
+		const UST_SparseGridData* SharedData = GetGridConfig();
+		GetSparseGrid(InGridName)->GetGridCellPopulations(OutData, SharedData->GetGridOrigin(), FST_GridRef2D(SharedData->GetNumCellsX(), SharedData->GetNumCellsY()), SharedData->GetCellSize());
+		return true;
+	}
+
+	return false;
+}
+
+bool UST_SparseGridManager_Multi::GetGridMemoryInfo(const FName InGridName, int32& OutTotalObjects, uint64& OutRegisterAllocSize, uint64& OutRegisterUsedSize, uint64& OutCellAllocSize, uint64& OutCellUsedSize) const
+{
+	if (ensure(HasGrid(InGridName)))
+	{
+		GetSparseGrid(InGridName)->GetEditorDebugInfo(OutTotalObjects, OutRegisterAllocSize, OutRegisterUsedSize, OutCellAllocSize, OutCellUsedSize);
+		return true;
+	}
+
+	return false;
+}
+#endif
+
+////////////////////////////
+///// Blueprint Access /////
+////////////////////////////
+
+TSharedRef<TST_SparseGrid<UST_SparseGridComponent>> UST_SparseGridManager_Multi::GetSparseGrid(const FName InGridName) const
+{
+	return SparseGrids.FindChecked(ResolveGridName(InGridName)).ToSharedRef();
+}
+
+FName UST_SparseGridManager_Multi::ResolveGridName(const FName InGridName) const
+{
+	if (SparseGrids.Contains(InGridName))
+	{
+		return InGridName;
+	}
+
+	UE_LOG(LogST_SparseGridManager, VeryVerbose, TEXT("UST_SparseGridManager_Multi::ResolveGridName() - No grid named '%s', using '%s'"), *InGridName.ToString(), *DefaultGridName.ToString());
+	return DefaultGridName;
+}
+
+const TArray<UST_SparseGridComponent*>& UST_SparseGridManager_Multi::GetGridComponents(const FName GridName) const
+{
+	check(AreGridsInitialized());
+	return GetSparseGrid(GridName)->GetRegisteredObjects();
+}
+
+//////////////////////////
+///// Search Queries /////
+//////////////////////////
+
+/*
+* Resolves the named grid of the world's multi-grid manager, runs a query into the calling thread's scratch memory, then copies the results out.
+* Returns false if the world has no initialized multi-grid manager.
+*/
+template<class QueryFuncType>
+static bool QueryNamedGrid_Scratch(const UObject* WorldContextObject, const FName InGridName, TArray<UST_SparseGridComponent*>& OutComponents, const QueryFuncType& QueryFunc)
+{
+	OutComponents.Reset();
+
+	const UST_SparseGridManager_Multi* MultiManager = Cast<UST_SparseGridManager_Multi>(UST_SparseGridManager::Get(WorldContextObject));
+	if (MultiManager && MultiManager->AreGridsInitialized())
+	{
+		FMemMark Mark(FMemStack::Get());
+
+		TST_SparseGrid<UST_SparseGridComponent>::FScratchResults Results;
+		QueryFunc(MultiManager->GetSparseGrid(InGridName).Get(), Results);
+
+		OutComponents.Reset(Results.Num());
+		OutComponents.Append(Results);
+		return true;
+	}
+
+	return false;
+}
+
+bool UST_SparseGridManager_Multi::K2_GetComponents_Sphere(const UObject* WorldContextObject, const FName InGridName, TArray<UST_SparseGridComponent*>& GridComponents, const FVector& InWorldLocation, const float InSphereRadius, const int32 InIncludeCategories, const int32 InExcludeCategories, const bool bDrawDebug /*= false*/)
+{
+	const FST_SparseGridCategoryFilter Filter((uint32)InIncludeCategories, (uint32)InExcludeCategories);
+	return QueryNamedGrid_Scratch(WorldContextObject, InGridName, GridComponents, [&](const TST_SparseGrid<UST_SparseGridComponent>& Grid, TST_SparseGrid<UST_SparseGridComponent>::FScratchResults& Results)
+	{
+		Grid.QueryGrid_Sphere(Results, InWorldLocation, InSphereRadius, Filter, bDrawDebug);
+	});
+}
+
+bool UST_SparseGridManager_Multi::K2_GetComponents_Capsule(const UObject* WorldContextObject, const FName InGridName, TArray<UST_SparseGridComponent*>& GridComponents, const FVector& InWorldLocation, const FVector& InCapsuleAxis, const float InCapsuleRadius, const float InCapsuleHalfHeight, const int32 InIncludeCategories, const int32 InExcludeCategories, const bool bDrawDebug /*= false*/)
+{
+	const FST_SparseGridCategoryFilter Filter((uint32)InIncludeCategories, (uint32)InExcludeCategories);
+	return QueryNamedGrid_Scratch(WorldContextObject, InGridName, GridComponents, [&](const TST_SparseGrid<UST_SparseGridComponent>& Grid, TST_SparseGrid<UST_SparseGridComponent>::FScratchResults& Results)
+	{
+		Grid.QueryGrid_Capsule(Results, InWorldLocation, InCapsuleAxis, InCapsuleRadius, InCapsuleHalfHeight, Filter, bDrawDebug);
+	});
+}
+
+bool UST_SparseGridManager_Multi::K2_GetComponents_Box(const UObject* WorldContextObject, const FName InGridName, TArray<UST_SparseGridComponent*>& GridComponents, const FVector& InWorldLocation, const FVector& InBoxExtents, const int32 InIncludeCategories, const int32 InExcludeCategories, const bool bDrawDebug /*= false*/)
+{
+	const FST_SparseGridCategoryFilter Filter((uint32)InIncludeCategories, (uint32)InExcludeCategories);
+	return QueryNamedGrid_Scratch(WorldContextObject, InGridName, GridComponents, [&](const TST_SparseGrid<UST_SparseGridComponent>& Grid, TST_SparseGrid<UST_SparseGridComponent>::FScratchResults& Results)
+	{
+		Grid.QueryGrid_Box(Results, InWorldLocation, InBoxExtents, Filter, bDrawDebug);
+	});
+}
+
+bool UST_SparseGridManager_Multi::K2_GetComponents_RotatedBox(const UObject* WorldContextObject, const FName InGridName, TArray<UST_SparseGridComponent*>& GridComponents, const FVector& InWorldLocation, const FRotator& InBoxRotation, const FVector& InBoxExtents, const int32 InIncludeCategories, const int32 InExcludeCategories, const bool bDrawDebug /*= false*/)
+{
+	const FST_SparseGridCategoryFilter Filter((uint32)InIncludeCategories, (uint32)InExcludeCategories);
+	return QueryNamedGrid_Scratch(WorldContextObject, InGridName, GridComponents, [&](const TST_SparseGrid<UST_SparseGridComponent>& Grid, TST_SparseGrid<UST_SparseGridComponent>::FScratchResults& Results)
+	{
+		Grid.QueryGrid_RotatedBox(Results, InWorldLocation, InBoxRotation.Quaternion(), InBoxExtents, Filter, bDrawDebug);
+	});
+}
+
+bool UST_SparseGridManager_Multi::K2_GetComponents_Cone(const UObject* WorldContextObject, const FName InGridName, TArray<UST_SparseGridComponent*>& GridComponents, const FVector& InWorldLocation, const float InConeLength, const float InConeHalfAngleRadians, const FVector& InAxis, const int32 InIncludeCategories, const int32 InExcludeCategories, const bool bDrawDebug /*= false*/)
+{
+	const FST_SparseGridCategoryFilter Filter((uint32)InIncludeCategories, (uint32)InExcludeCategories);
+	return QueryNamedGrid_Scratch(WorldContextObject, InGridName, GridComponents, [&](const TST_SparseGrid<UST_SparseGridComponent>& Grid, TST_SparseGrid<UST_SparseGridComponent>::FScratchResults& Results)
+	{
+		Grid.QueryGrid_Cone(Results, InWorldLocation, InConeLength, InConeHalfAngleRadians, InAxis, Filter, bDrawDebug);
+	});
+}
+
+UST_SparseGridComponent* UST_SparseGridManager_Multi::K2_GetComponent_Nearest(const UObject* WorldContextObject, const FName InGridName, const FVector& InWorldLocation, const float InMaxDistance, const TSubclassOf<AActor> InOwnerClass, const int32 InIncludeCategories, const int32 InExcludeCategories, const bool bDrawDebug /*= false*/)
+{
+	const UST_SparseGridManager_Multi* MultiManager = Cast<UST_SparseGridManager_Multi>(UST_SparseGridManager::Get(WorldContextObject));
+	if (MultiManager && MultiManager->AreGridsInitialized())
+	{
+		const UClass* OwnerClass = InOwnerClass.Get();
+		const FST_SparseGridCategoryFilter Filter((uint32)InIncludeCategories, (uint32)InExcludeCategories);
+		return MultiManager->GetSparseGrid(InGridName)->QueryGrid_Nearest(InWorldLocation, InMaxDistance, Filter, [OwnerClass](const UST_SparseGridComponent* Component)
+		{
+			return !OwnerClass || (Component->GetOwner() && Component->GetOwner()->IsA(OwnerClass));
+		}, bDrawDebug);
+	}
+
+	return nullptr;
+}
+
+bool UST_SparseGridManager_Multi::K2_GetComponents_KNearest(const UObject* WorldContextObject, const FName InGridName, TArray<UST_SparseGridComponent*>& GridComponents, const FVector& InWorldLocation, const int32 InK, const float InMaxDistance, const TSubclassOf<AActor> InOwnerClass, const int32 InIncludeCategories, const int32 InExcludeCategories, const bool bDrawDebug /*= false*/)
+{
+	GridComponents.Reset();
+
+	const UST_SparseGridManager_Multi* MultiManager = Cast<UST_SparseGridManager_Multi>(UST_SparseGridManager::Get(WorldContextObject));
+	if (MultiManager && MultiManager->AreGridsInitialized())
+	{
+		const UClass* OwnerClass = InOwnerClass.Get();
+		const FST_SparseGridCategoryFilter Filter((uint32)InIncludeCategories, (uint32)InExcludeCategories);
+		MultiManager->GetSparseGrid(InGridName)->QueryGrid_KNearest(GridComponents, InWorldLocation, InK, InMaxDistance, Filter, [OwnerClass](const UST_SparseGridComponent* Component)
+		{
+			return !OwnerClass || (Component->GetOwner() && Component->GetOwner()->IsA(OwnerClass));
+		}, bDrawDebug);
+
+		return true;
+	}
+
+	return false;
+}
\ No newline at end of file
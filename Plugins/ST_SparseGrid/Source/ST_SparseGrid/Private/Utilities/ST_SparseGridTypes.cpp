@@ -86,4 +86,46 @@ TAutoConsoleVariable<FString> ST_SparseGridCVars::CVarColdHex = TAutoConsoleVari
 	*FLinearColor(0.f, 1.f, 0.f, 0.75f).ToFColor(true).ToHex(),
 	TEXT("Hex Value of Cold Colour\n"),
 	ECVF_Cheat);
+#endif
+
+/////////////////////////
+///// Visitor Guard /////
+/////////////////////////
+
+#if SPARSE_GRID_DEBUG
+namespace ST_SparseGridVisitGuard
+{
+	static constexpr int32 MaxDepth = 16;
+
+	// Grids the calling thread is currently visiting, innermost last
+	static thread_local const void* VisitingGrids[MaxDepth];
+	static thread_local int32 VisitDepth = 0;
+}
+
+FST_SparseGridVisitScope::FST_SparseGridVisitScope(const void* InGrid)
+{
+	using namespace ST_SparseGridVisitGuard;
+	checkf(VisitDepth < MaxDepth, TEXT("Sparse Grid visitor queries nested too deeply!"));
+
+	VisitingGrids[VisitDepth++] = InGrid;
+}
+
+FST_SparseGridVisitScope::~FST_SparseGridVisitScope()
+{
+	ST_SparseGridVisitGuard::VisitDepth--;
+}
+
+bool FST_SparseGridVisitScope::IsVisiting(const void* InGrid)
+{
+	using namespace ST_SparseGridVisitGuard;
+	for (int32 Idx = 0; Idx < VisitDepth; Idx++)
+	{
+		if (VisitingGrids[Idx] == InGrid)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
 #endif
\ No newline at end of file
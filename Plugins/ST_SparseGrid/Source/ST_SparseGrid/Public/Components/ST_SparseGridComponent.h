@@ -9,7 +9,7 @@
 /*
 * Sparse Grid Object Component
 *
-* Add this component to any actor, and it will automatically register with the Basic Sparse Grid
+* Add this component to any actor, and it will automatically register with the current Sparse Grid Manager
 * Inherit this component to add your own functionality directly, if required.
 */
 UCLASS(BlueprintType, Category = "Sparse Grid", meta = (DisplayName = "Sparse Grid Component", BlueprintSpawnableComponent), HideCategories = (Activation, Sockets, Collision, ComponentReplication, Tags, Variable, Cooking))
@@ -25,6 +25,43 @@ public:
 	const FST_SparseGridData& GetSparseGridData() const { return SparseGridData; }
 	FST_SparseGridData& AccessSparseGridData() { return SparseGridData; }
 
+	/*
+	* Sets whether this is a static grid object.
+	* Re-registers the component with the grid if it is already registered.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Sparse Grid")
+	void SetIsStaticGridObject(const bool bNewStatic);
+
+	UFUNCTION(BlueprintPure, Category = "Sparse Grid")
+	FORCEINLINE bool IsStaticGridObject() const { return bStaticGridObject; }
+
+	/*
+	* Sets the category bits this object is filtered by in grid queries.
+	* Takes effect in queries once the grid has next updated.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Sparse Grid")
+	void SetGridCategories(UPARAM(meta = (Bitmask)) const int32 NewCategories);
+
+	UFUNCTION(BlueprintPure, Category = "Sparse Grid")
+	FORCEINLINE int32 GetGridCategories() const { return GridCategories; }
+
+	/*
+	* Sets which grid this object registers with, for managers holding several named grids.
+	* Re-registers the component with the grid if it is already registered.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Sparse Grid")
+	void SetGridName(const FName NewGridName);
+
+	UFUNCTION(BlueprintPure, Category = "Sparse Grid")
+	FORCEINLINE FName GetGridName() const { return GridName; }
+
+	/*
+	* Called by the manager once this component has been added to or removed from a grid, including deferred registrations.
+	* Game thread only.
+	*/
+	virtual void OnAddedToSparseGrid();
+	virtual void OnRemovedFromSparseGrid();
+
 	/*
 	* Converts an array of grid components out to an array of their owning actors
 	* Returns the total number of elements
@@ -41,6 +78,10 @@ public:
 	static void GetComponentsOwners_Typed(const TArray<UST_SparseGridComponent*>& GridComponents, TArray<AActor*>& Actors, const TSubclassOf<AActor> ActorClass);
 
 protected:
+	// UObject Interface
+	virtual void PostInitProperties() override;
+	virtual void PostLoad() override;
+
 	// UActorComponent Interface
 	virtual void OnRegister() override;
 	virtual void OnUnregister() override;
@@ -49,7 +90,38 @@ protected:
 	virtual void RegisterWithSparseGrid();
 	virtual void UnRegisterWithSparseGrid();
 
+	/*
+	* Static grid objects are not re-bucketed every frame, only when the owner's root component moves.
+	* Only has an effect when the grid uses incremental updates.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Sparse Grid", meta = (DisplayName = "Static Grid Object"))
+	uint8 bStaticGridObject : 1;
+
+	/*
+	* Category bits matched against the include/exclude masks of filtered grid queries.
+	* Projects are free to assign their own meaning to each bit.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Sparse Grid", meta = (Bitmask))
+	int32 GridCategories;
+
+	/*
+	* Name of the grid this object registers with.
+	* Only used by managers holding several named grids (see UST_SparseGridManager_Multi), None uses the manager's default grid.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Sparse Grid")
+	FName GridName;
+
 private:
+	// Copies the static flag and categories into the grid data, before any grid can see it
+	void InitSparseGridData();
+
+	// Marks static objects dirty in the grid when they move
+	void OnRootTransformUpdated(USceneComponent* InRootComponent, EUpdateTransformFlags InUpdateTransformFlags, ETeleportType InTeleport);
+
+	// Bound to the owner's root component while registered as a static object
+	FDelegateHandle TransformUpdatedHandle;
+	TWeakObjectPtr<USceneComponent> BoundRootComponent;
+
 	// The actual grid reference data
 	FST_SparseGridData SparseGridData;
 };
\ No newline at end of file
@@ -3,10 +3,21 @@
 #pragma once
 
 #include "ST_SparseGridTypes.h"
+#include "ST_SparseGridKernels.h"
+#include "ST_SparseGridQueries.h"
+#include "ST_SparseGridSnapshot.h"
 
 // Required
 #include "Engine/World.h"
+#include "Engine/Level.h"
+#include "GameFramework/Actor.h"
+#include "Components/ActorComponent.h"
 #include "UObject/UObjectIterator.h"
+#include "Async/ParallelFor.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "Misc/ScopeRWLock.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/MemStack.h"
 
 #if SPARSE_GRID_DEBUG
 #include "DrawDebugHelpers.h"
@@ -20,6 +31,8 @@ DECLARE_STATS_GROUP(TEXT("Sparse Grid"), STATGROUP_SparseGrid, STATCAT_Advanced)
 
 // General
 DECLARE_CYCLE_STAT(TEXT("Update Grid"), STAT_UpdateGrid, STATGROUP_SparseGrid);
+DECLARE_CYCLE_STAT(TEXT("Update Grid - Migrate"), STAT_UpdateGrid_Migrate, STATGROUP_SparseGrid);
+DECLARE_CYCLE_STAT(TEXT("Update Grid - Cell Bounds"), STAT_UpdateGrid_CellBounds, STATGROUP_SparseGrid);
 DECLARE_CYCLE_STAT(TEXT("Query Populations"), STAT_QueryPopulation, STATGROUP_SparseGrid);
 DECLARE_CYCLE_STAT(TEXT("Query Tile"), STAT_QueryTile, STATGROUP_SparseGrid);
 
@@ -29,6 +42,8 @@ DECLARE_CYCLE_STAT(TEXT("Query Grid - Capsule"), STAT_QueryGrid_Capsule, STATGRO
 DECLARE_CYCLE_STAT(TEXT("Query Grid - Box"), STAT_QueryGrid_Box, STATGROUP_SparseGrid);
 DECLARE_CYCLE_STAT(TEXT("Query Grid - Rotated Box"), STAT_QueryGrid_RotatedBox, STATGROUP_SparseGrid);
 DECLARE_CYCLE_STAT(TEXT("Query Grid - Cone"), STAT_QueryGrid_Cone, STATGROUP_SparseGrid);
+DECLARE_CYCLE_STAT(TEXT("Query Grid - Sphere Batch"), STAT_QueryGrid_SphereBatch, STATGROUP_SparseGrid);
+DECLARE_CYCLE_STAT(TEXT("Query Grid - Nearest"), STAT_QueryGrid_Nearest, STATGROUP_SparseGrid);
 
 // Forward-Declarations
 template<class T>
@@ -37,14 +52,283 @@ class TST_SparseGrid;
 template<class T>
 class TST_SparseGridCell;
 
-#if SPARSE_GRID_DEBUG
-#define GATHER_DEBUG_PARAMETERS																									\
-	const UWorld* DebugWorld = GetGridWorld();																					\
-	check(DebugWorld);																											\
-	const float DrawQueryTime = ST_SparseGridCVars::CVarQueryDebugTime.GetValueOnGameThread();									\
-	const float DrawQueryThickness = ST_SparseGridCVars::CVarDebugGridThickness.GetValueOnGameThread();
+///////////////////////////
+///// World Iteration /////
+///////////////////////////
+
+/*
+* Visits every object of type T belonging to a world, for grid initialization.
+* Components and actors are found through the actors of the world's levels, rather than a sweep of every object of the type in the process.
+* Any other type falls back to an object iteration filtered by world.
+*/
+template<class T, bool bIsComponent = TIsDerivedFrom<T, UActorComponent>::IsDerived, bool bIsActor = TIsDerivedFrom<T, AActor>::IsDerived>
+struct TST_SparseGridWorldObjects
+{
+	template<class FuncType>
+	static void ForEach(const UWorld* InWorld, const FuncType& InFunc)
+	{
+		for (TObjectIterator<T> Itr; Itr; ++Itr)
+		{
+			if (Itr->GetWorld() == InWorld)
+			{
+				InFunc(*Itr);
+			}
+		}
+	}
+};
+
+template<class T>
+struct TST_SparseGridWorldObjects<T, true, false>
+{
+	template<class FuncType>
+	static void ForEach(const UWorld* InWorld, const FuncType& InFunc)
+	{
+		for (const ULevel* LevelItr : InWorld->GetLevels())
+		{
+			if (!LevelItr) { continue; }
+
+			for (const AActor* ActorItr : LevelItr->Actors)
+			{
+				if (ActorItr)
+				{
+					ActorItr->ForEachComponent<T>(false, [&InFunc](T* InComponent) { InFunc(InComponent); });
+				}
+			}
+		}
+	}
+};
+
+template<class T>
+struct TST_SparseGridWorldObjects<T, false, true>
+{
+	template<class FuncType>
+	static void ForEach(const UWorld* InWorld, const FuncType& InFunc)
+	{
+		for (const ULevel* LevelItr : InWorld->GetLevels())
+		{
+			if (!LevelItr) { continue; }
+
+			for (AActor* ActorItr : LevelItr->Actors)
+			{
+				if (T* TypedActor = Cast<T>(ActorItr))
+				{
+					InFunc(TypedActor);
+				}
+			}
+		}
+	}
+};
+
+////////////////////////////////////
+///// Sparse Grid Cell Storage /////
+////////////////////////////////////
+
+/*
+* Shared backing store for the contents of every cell in a grid.
+*
+* Objects and cached positions of all cells live in one slab per stream, handed out to cells in chunks of whole blocks.
+* Chunks are contiguous, so query kernels still stream a cell's positions directly.
+* Released chunks are kept on a free-list per block count and reused by the next cell asking for the same size,
+* chunks released at the end of the slab are returned to it instead.
+*
+* Cells address their chunk by offset, since growing the slab may move it.
+*/
+template<class T>
+class TST_SparseGridCellStorage
+{
+public:
+	/*
+	* @param InBlockSize		- Number of objects per block, see UST_SparseGridData::CellAllocSize
+	* @param InShrinkMultiplier	- When cells give blocks back, see UST_SparseGridData::CellAllocShrinkMultiplier
+	*/
+	TST_SparseGridCellStorage(const int32 InBlockSize, const int32 InShrinkMultiplier)
+		: BlockSize(FMath::Max(InBlockSize, 1))
+		, ShrinkMultiplier(InShrinkMultiplier)
+		, NumFreeBlocks(0)
+	{}
+
+	/*
+	* Returns the offset of a chunk of InNumBlocks contiguous blocks.
+	*/
+	int32 Allocate(const int32 InNumBlocks)
+	{
+		checkSlow(InNumBlocks > 0);
+
+		if (FreeChunks.IsValidIndex(InNumBlocks) && FreeChunks[InNumBlocks].Num() > 0)
+		{
+			NumFreeBlocks -= InNumBlocks;
+			return FreeChunks[InNumBlocks].Pop(false);
+		}
+
+		const int32 Offset = Objects.Num();
+		const int32 NumSlots = InNumBlocks * BlockSize;
+
+		Objects.AddUninitialized(NumSlots);
+		PositionsX.AddUninitialized(NumSlots);
+		PositionsY.AddUninitialized(NumSlots);
+		PositionsZ.AddUninitialized(NumSlots);
+		Categories.AddUninitialized(NumSlots);
+
+		return Offset;
+	}
+
+	/*
+	* Returns a chunk to the storage.
+	*/
+	void Free(const int32 InOffset, const int32 InNumBlocks)
+	{
+		checkSlow(InOffset >= 0 && InNumBlocks > 0);
+
+		const int32 NumSlots = InNumBlocks * BlockSize;
+		if (InOffset + NumSlots == Objects.Num())
+		{
+			Objects.SetNum(InOffset, false);
+			PositionsX.SetNum(InOffset, false);
+			PositionsY.SetNum(InOffset, false);
+			PositionsZ.SetNum(InOffset, false);
+			Categories.SetNum(InOffset, false);
+			return;
+		}
+
+		if (FreeChunks.Num() <= InNumBlocks)
+		{
+			FreeChunks.SetNum(InNumBlocks + 1);
+		}
+
+		FreeChunks[InNumBlocks].Add(InOffset);
+		NumFreeBlocks += InNumBlocks;
+	}
+
+	/*
+	* Copies the first InNum objects, positions and categories of one chunk to another.
+	*/
+	FORCEINLINE void Copy(const int32 InFromOffset, const int32 InToOffset, const int32 InNum)
+	{
+		FMemory::Memcpy(Categories.GetData() + InToOffset, Categories.GetData() + InFromOffset, sizeof(uint32) * InNum);
+		FMemory::Memcpy(Objects.GetData() + InToOffset, Objects.GetData() + InFromOffset, sizeof(T*) * InNum);
+		FMemory::Memcpy(PositionsX.GetData() + InToOffset, PositionsX.GetData() + InFromOffset, sizeof(float) * InNum);
+		FMemory::Memcpy(PositionsY.GetData() + InToOffset, PositionsY.GetData() + InFromOffset, sizeof(float) * InNum);
+		FMemory::Memcpy(PositionsZ.GetData() + InToOffset, PositionsZ.GetData() + InFromOffset, sizeof(float) * InNum);
+	}
+
+	/*
+	* Copies the first InNum objects, positions and categories of a chunk in another storage to a chunk of this one.
+	*/
+	FORCEINLINE void CopyFrom(const TST_SparseGridCellStorage& InOther, const int32 InFromOffset, const int32 InToOffset, const int32 InNum)
+	{
+		FMemory::Memcpy(Categories.GetData() + InToOffset, InOther.Categories.GetData() + InFromOffset, sizeof(uint32) * InNum);
+		FMemory::Memcpy(Objects.GetData() + InToOffset, InOther.Objects.GetData() + InFromOffset, sizeof(T*) * InNum);
+		FMemory::Memcpy(PositionsX.GetData() + InToOffset, InOther.PositionsX.GetData() + InFromOffset, sizeof(float) * InNum);
+		FMemory::Memcpy(PositionsY.GetData() + InToOffset, InOther.PositionsY.GetData() + InFromOffset, sizeof(float) * InNum);
+		FMemory::Memcpy(PositionsZ.GetData() + InToOffset, InOther.PositionsZ.GetData() + InFromOffset, sizeof(float) * InNum);
+	}
+
+	/*
+	* Allocates the slab for InNumSlots up front, so filling it block by block never grows it.
+	*/
+	void Reserve(const int32 InNumSlots)
+	{
+		Objects.Reserve(InNumSlots);
+		PositionsX.Reserve(InNumSlots);
+		PositionsY.Reserve(InNumSlots);
+		PositionsZ.Reserve(InNumSlots);
+		Categories.Reserve(InNumSlots);
+	}
+
+	/*
+	* Drops every chunk and resizes the slab to InNumSlots, keeping its allocation.
+	* Used by grids laying out every cell at once, cells must be reassigned afterwards.
+	*/
+	void Reset(const int32 InNumSlots)
+	{
+		Objects.SetNumUninitialized(InNumSlots, false);
+		PositionsX.SetNumUninitialized(InNumSlots, false);
+		PositionsY.SetNumUninitialized(InNumSlots, false);
+		PositionsZ.SetNumUninitialized(InNumSlots, false);
+		Categories.SetNumUninitialized(InNumSlots, false);
+
+		for (TArray<int32>& FreeListItr : FreeChunks)
+		{
+			FreeListItr.Reset();
+		}
+
+		NumFreeBlocks = 0;
+	}
+
+	/*
+	* Releases slab memory beyond the slots currently handed out.
+	*/
+	void Shrink()
+	{
+		Objects.Shrink();
+		PositionsX.Shrink();
+		PositionsY.Shrink();
+		PositionsZ.Shrink();
+		Categories.Shrink();
+
+		for (TArray<int32>& FreeListItr : FreeChunks)
+		{
+			FreeListItr.Shrink();
+		}
+	}
+
+	/*
+	* Drops every chunk. Cells using this storage must be emptied first.
+	*/
+	void Empty()
+	{
+		Objects.Empty();
+		PositionsX.Empty();
+		PositionsY.Empty();
+		PositionsZ.Empty();
+		Categories.Empty();
+		FreeChunks.Empty();
+		NumFreeBlocks = 0;
+	}
+
+	FORCEINLINE int32 GetBlockSize() const { return BlockSize; }
+	FORCEINLINE int32 GetShrinkMultiplier() const { return ShrinkMultiplier; }
+
+	FORCEINLINE T** GetObjects(const int32 InOffset) { return Objects.GetData() + InOffset; }
+	FORCEINLINE float* GetPositionsX(const int32 InOffset) { return PositionsX.GetData() + InOffset; }
+	FORCEINLINE float* GetPositionsY(const int32 InOffset) { return PositionsY.GetData() + InOffset; }
+	FORCEINLINE float* GetPositionsZ(const int32 InOffset) { return PositionsZ.GetData() + InOffset; }
+	FORCEINLINE uint32* GetCategories(const int32 InOffset) { return Categories.GetData() + InOffset; }
+
+	FORCEINLINE T* const* GetObjects(const int32 InOffset) const { return Objects.GetData() + InOffset; }
+	FORCEINLINE const float* GetPositionsX(const int32 InOffset) const { return PositionsX.GetData() + InOffset; }
+	FORCEINLINE const float* GetPositionsY(const int32 InOffset) const { return PositionsY.GetData() + InOffset; }
+	FORCEINLINE const float* GetPositionsZ(const int32 InOffset) const { return PositionsZ.GetData() + InOffset; }
+	FORCEINLINE const uint32* GetCategories(const int32 InOffset) const { return Categories.GetData() + InOffset; }
+
+#if WITH_EDITOR
+	/*
+	* Total size of the slab and free-lists, including blocks waiting on a free-list.
+	*/
+	uint64 GetAllocatedSize() const
+	{
+		return Objects.GetAllocatedSize() + PositionsX.GetAllocatedSize() + PositionsY.GetAllocatedSize() + PositionsZ.GetAllocatedSize() + Categories.GetAllocatedSize() + FreeChunks.GetAllocatedSize();
+	}
+
+	FORCEINLINE int32 GetNumFreeBlocks() const { return NumFreeBlocks; }
 #endif
 
+private:
+	int32 BlockSize;
+	int32 ShrinkMultiplier;
+	int32 NumFreeBlocks;
+
+	// Slab, one stream per cell stream
+	TArray<T*> Objects;
+	TArray<float> PositionsX;
+	TArray<float> PositionsY;
+	TArray<float> PositionsZ;
+	TArray<uint32> Categories;
+
+	// Offsets of released chunks, indexed by number of blocks
+	TArray<TArray<int32>> FreeChunks;
+};
+
 ////////////////////////////
 ///// Sparse Grid Cell /////
 ////////////////////////////
@@ -53,75 +337,211 @@ template<class T>
 class TST_SparseGridCell
 {
 public:
-	TST_SparseGridCell(const int32 InAllocSize, const int32 InShrinkMultiplier)
-		: CellObjects(TArray<T*>())
-		, AllocSize(InAllocSize)
-		, ShrinkMultiplier(InShrinkMultiplier)
-	{}
+	explicit TST_SparseGridCell(TST_SparseGridCellStorage<T>* InStorage)
+		: Storage(InStorage)
+		, Offset(INDEX_NONE)
+		, NumObjects(0)
+		, NumBlocks(0)
+		, Bounds()
+	{
+		check(Storage != nullptr);
+	}
 
 	/*
 	* Adds an element to the grid cell.
 	* Adding will fail if the element already belongs to another cell.
+	* The position and category mask are cached alongside the object so that queries do not need to touch the object itself.
 	*/
-	void Add(T* InObject)
+	void Add(T* InObject, const FVector& InPosition)
 	{
 		checkf(InObject != nullptr, TEXT("TST_SparseGridCell::Add - Invalid Object!"));
 		checkfSlow(InObject->GetSparseGridData().GetCellSubIndex() == INDEX_NONE, TEXT("TST_SparseGridCell::Add - Object Already In Another Cell!"));
 
 		// Allocate in Blocks
-		if (CellObjects.GetSlack() <= 0)
+		if (NumObjects == NumBlocks * Storage->GetBlockSize())
 		{
-			CellObjects.Reserve(CellObjects.Max() + AllocSize);
-			UE_LOG(LogST_SparseGrid, VeryVerbose, TEXT("Cell Objects Resized! '%i' Max Objects."), CellObjects.Max());
+			Reallocate(NumBlocks + 1);
+			UE_LOG(LogST_SparseGrid, VeryVerbose, TEXT("Cell Objects Resized! '%i' Max Objects."), NumBlocks * Storage->GetBlockSize());
 		}
 
 		// Add the new item, and store the cell index
-		InObject->AccessSparseGridData().SetCellSubIndex(CellObjects.Add(InObject));
+		const int32 SubIndex = NumObjects++;
+		Storage->GetObjects(Offset)[SubIndex] = InObject;
+		Storage->GetPositionsX(Offset)[SubIndex] = InPosition.X;
+		Storage->GetPositionsY(Offset)[SubIndex] = InPosition.Y;
+		Storage->GetPositionsZ(Offset)[SubIndex] = InPosition.Z;
+		Storage->GetCategories(Offset)[SubIndex] = InObject->GetSparseGridData().GetCategoryMask();
+		InObject->AccessSparseGridData().SetCellSubIndex(SubIndex);
+
+		Bounds.Update(InPosition);
+	}
+
+	/*
+	* Grows the cell to fit InNumToAdd more elements with a single reallocation.
+	* Used when adding many objects at once, so Add() doesn't reallocate block by block.
+	*/
+	void Reserve(const int32 InNumToAdd)
+	{
+		const int32 RequiredBlocks = FMath::DivideAndRoundUp(NumObjects + InNumToAdd, Storage->GetBlockSize());
+		if (RequiredBlocks > NumBlocks)
+		{
+			Reallocate(RequiredBlocks);
+		}
 	}
 
 	/*
 	* Removes an element from the grid cell
 	* This will change the order of items within the cell.
+	* When removing many objects at once, pass bAllowShrink = false and call ShrinkToFit() afterwards.
 	*/
-	void Remove(T* InObject)
+	void Remove(T* InObject, const bool bAllowShrink = true)
 	{
 		checkf(InObject != nullptr, TEXT("TST_SparseGridCell::Remove - Invalid Object!"));
-		checkfSlow(CellObjects.IsValidIndex(InObject->GetSparseGridData().GetCellSubIndex()) && InObject == CellObjects[InObject->GetSparseGridData().GetCellSubIndex()], TEXT("TST_SparseGridCell::Remove - Invalid Object At Cell Sub Index '%s'!"), InObject->GetSparseGridData().GetCellSubIndex());
+		checkfSlow(GetObjects().IsValidIndex(InObject->GetSparseGridData().GetCellSubIndex()) && InObject == GetObjects()[InObject->GetSparseGridData().GetCellSubIndex()], TEXT("TST_SparseGridCell::Remove - Invalid Object At Cell Sub Index '%i'!"), InObject->GetSparseGridData().GetCellSubIndex());
 
-		if (InObject != CellObjects.Last())
+		const int32 LastIndex = NumObjects - 1;
+		const int32 SwapIndex = InObject->GetSparseGridData().GetCellSubIndex();
+		if (SwapIndex != LastIndex)
 		{
-			const int32 SwapIndex = InObject->GetSparseGridData().GetCellSubIndex();
-			CellObjects.Swap(SwapIndex, CellObjects.Num() - 1);
-
-			T* LastObject = CellObjects[SwapIndex];
+			// Move the last object into the hole
+			T** Objects = Storage->GetObjects(Offset);
+			Objects[SwapIndex] = Objects[LastIndex];
+			Storage->GetPositionsX(Offset)[SwapIndex] = Storage->GetPositionsX(Offset)[LastIndex];
+			Storage->GetPositionsY(Offset)[SwapIndex] = Storage->GetPositionsY(Offset)[LastIndex];
+			Storage->GetPositionsZ(Offset)[SwapIndex] = Storage->GetPositionsZ(Offset)[LastIndex];
+			Storage->GetCategories(Offset)[SwapIndex] = Storage->GetCategories(Offset)[LastIndex];
+
+			T* LastObject = Objects[SwapIndex];
 			checkfSlow(LastObject != nullptr, TEXT("Invalid Cell Component"));
 
 			LastObject->AccessSparseGridData().SetCellSubIndex(SwapIndex);
 		}
 
-		checkfSlow(CellObjects.Last() == InObject, TEXT("TST_SparseGridCell::Remove - Old Object Not Last Element In Array!"));
-
-		CellObjects.RemoveAt(CellObjects.Num() - 1, 1, false);
+		NumObjects--;
 		InObject->AccessSparseGridData().SetCellSubIndex(INDEX_NONE);
 
+		// Bounds only shrink in RefreshBounds()
+		if (NumObjects == 0)
+		{
+			Bounds = FST_SparseGridBounds();
+		}
+
 		// Shrink in Blocks Too
-		const int32 Slack = CellObjects.GetSlack();
-		if (ShrinkMultiplier >= 0 && Slack % AllocSize == 0 && Slack > AllocSize * ShrinkMultiplier)
+		const int32 BlockSize = Storage->GetBlockSize();
+		const int32 ShrinkMultiplier = Storage->GetShrinkMultiplier();
+		const int32 Slack = NumBlocks * BlockSize - NumObjects;
+		if (bAllowShrink && ShrinkMultiplier >= 0 && Slack % BlockSize == 0 && Slack > BlockSize * ShrinkMultiplier)
+		{
+			Reallocate(NumObjects / BlockSize);
+		}
+	}
+
+	/*
+	* Gives back whole blocks of slack in one reallocation, following the storage shrink multiplier.
+	*/
+	void ShrinkToFit()
+	{
+		const int32 BlockSize = Storage->GetBlockSize();
+		const int32 ShrinkMultiplier = Storage->GetShrinkMultiplier();
+		const int32 Slack = NumBlocks * BlockSize - NumObjects;
+		if (ShrinkMultiplier >= 0 && Slack >= BlockSize && Slack > BlockSize * ShrinkMultiplier)
+		{
+			Reallocate(FMath::DivideAndRoundUp(NumObjects, BlockSize));
+		}
+	}
+
+	/*
+	* Removes all elements without updating their grid data, and returns the chunk to the storage.
+	*/
+	void Empty()
+	{
+		if (NumBlocks > 0)
+		{
+			Storage->Free(Offset, NumBlocks);
+		}
+
+		Offset = INDEX_NONE;
+		NumObjects = 0;
+		NumBlocks = 0;
+		Bounds = FST_SparseGridBounds();
+	}
+
+	/*
+	* Refreshes the cached position of an object already in this cell.
+	* Does not touch the cell bounds, so objects in one cell can be refreshed from different threads. See RefreshBounds().
+	*/
+	FORCEINLINE void SetPosition(const int32 InSubIndex, const FVector& InPosition)
+	{
+		checkfSlow(InSubIndex >= 0 && InSubIndex < NumObjects, TEXT("TST_SparseGridCell::SetPosition - Invalid Cell Sub Index '%i'!"), InSubIndex);
+
+		Storage->GetPositionsX(Offset)[InSubIndex] = InPosition.X;
+		Storage->GetPositionsY(Offset)[InSubIndex] = InPosition.Y;
+		Storage->GetPositionsZ(Offset)[InSubIndex] = InPosition.Z;
+	}
+
+	/*
+	* Refreshes the cached category mask of an object already in this cell.
+	*/
+	FORCEINLINE void SetCategoryMask(const int32 InSubIndex, const uint32 InCategoryMask)
+	{
+		checkfSlow(InSubIndex >= 0 && InSubIndex < NumObjects, TEXT("TST_SparseGridCell::SetCategoryMask - Invalid Cell Sub Index '%i'!"), InSubIndex);
+
+		Storage->GetCategories(Offset)[InSubIndex] = InCategoryMask;
+	}
+
+	FORCEINLINE FVector GetPosition(const int32 InSubIndex) const
+	{
+		const TST_SparseGridCellStorage<T>& ConstStorage = *Storage;
+		return FVector(ConstStorage.GetPositionsX(Offset)[InSubIndex], ConstStorage.GetPositionsY(Offset)[InSubIndex], ConstStorage.GetPositionsZ(Offset)[InSubIndex]);
+	}
+
+	/*
+	* Recomputes the tight bounds of the cached positions in this cell.
+	*/
+	void RefreshBounds()
+	{
+		Bounds = FST_SparseGridBounds();
+
+		const float* PosX = GetPositionsX();
+		const float* PosY = GetPositionsY();
+		const float* PosZ = GetPositionsZ();
+		for (int32 SubIdx = 0; SubIdx < NumObjects; SubIdx++)
 		{
-			CellObjects.Shrink();
+			Bounds.Update(FVector(PosX[SubIdx], PosY[SubIdx], PosZ[SubIdx]));
 		}
 	}
 
-	FORCEINLINE const TArray<T*>& GetObjects() const
+	/*
+	* Bounds of the cached positions in this cell.
+	* Tight after RefreshBounds(), and only ever grows until the next refresh.
+	*/
+	FORCEINLINE const FST_SparseGridBounds& GetBounds() const { return Bounds; }
+
+	FORCEINLINE TArrayView<T* const> GetObjects() const
 	{
-		return CellObjects;
+		const TST_SparseGridCellStorage<T>& ConstStorage = *Storage;
+		return TArrayView<T* const>(NumBlocks > 0 ? ConstStorage.GetObjects(Offset) : nullptr, NumObjects);
 	}
 
+	/*
+	* Packed object positions, in the same order as GetObjects().
+	* Snapshotted during TST_SparseGrid::Update() (or on registration).
+	* Only valid until the next change to any cell sharing the same storage.
+	*/
+	FORCEINLINE const float* GetPositionsX() const { return NumBlocks > 0 ? static_cast<const TST_SparseGridCellStorage<T>*>(Storage)->GetPositionsX(Offset) : nullptr; }
+	FORCEINLINE const float* GetPositionsY() const { return NumBlocks > 0 ? static_cast<const TST_SparseGridCellStorage<T>*>(Storage)->GetPositionsY(Offset) : nullptr; }
+	FORCEINLINE const float* GetPositionsZ() const { return NumBlocks > 0 ? static_cast<const TST_SparseGridCellStorage<T>*>(Storage)->GetPositionsZ(Offset) : nullptr; }
+
+	/*
+	* Packed object category masks, in the same order as GetObjects().
+	*/
+	FORCEINLINE const uint32* GetCategories() const { return NumBlocks > 0 ? static_cast<const TST_SparseGridCellStorage<T>*>(Storage)->GetCategories(Offset) : nullptr; }
+
 #if WITH_EDITOR
 	void GetMemoryInfo(uint64& OutAlloc, uint64& OutUsed) const
 	{
-		OutAlloc = sizeof(void*) * CellObjects.Max();
-		OutUsed = sizeof(void*) * CellObjects.Num();
+		OutAlloc = (sizeof(void*) + sizeof(float) * 3 + sizeof(uint32)) * NumBlocks * Storage->GetBlockSize();
+		OutUsed = (sizeof(void*) + sizeof(float) * 3 + sizeof(uint32)) * NumObjects;
 	}
 #endif
 
@@ -129,25 +549,146 @@ private:
 	// Allow Private Access
 	friend class TST_SparseGrid<T>;
 
-	TArray<T*> CellObjects;
-	int32 AllocSize;
-	int32 ShrinkMultiplier;
+	/*
+	* Points the cell at a chunk already filled by the grid, see TST_SparseGrid::Update_Rebuild()
+	*/
+	FORCEINLINE void Assign(const int32 InOffset, const int32 InNumObjects)
+	{
+		Offset = InNumObjects > 0 ? InOffset : INDEX_NONE;
+		NumObjects = InNumObjects;
+		NumBlocks = FMath::DivideAndRoundUp(InNumObjects, Storage->GetBlockSize());
+		Bounds = FST_SparseGridBounds();
+	}
+
+	/*
+	* Copies the cell contents into a tight chunk of InPackedStorage, keeping their order, sub-indices and bounds.
+	* The cell then points into InPackedStorage's slab, which must replace its storage. See TST_SparseGrid::Compact()
+	*/
+	void RepackInto(TST_SparseGridCellStorage<T>& InPackedStorage)
+	{
+		const int32 PackedNumBlocks = FMath::DivideAndRoundUp(NumObjects, Storage->GetBlockSize());
+		const int32 PackedOffset = PackedNumBlocks > 0 ? InPackedStorage.Allocate(PackedNumBlocks) : INDEX_NONE;
+
+		if (NumObjects > 0)
+		{
+			InPackedStorage.CopyFrom(*Storage, Offset, PackedOffset, NumObjects);
+		}
+
+		Offset = PackedOffset;
+		NumBlocks = PackedNumBlocks;
+	}
+
+	/*
+	* Moves the cell contents into a chunk of InNumBlocks blocks, releasing the old chunk.
+	*/
+	void Reallocate(const int32 InNumBlocks)
+	{
+		checkSlow(InNumBlocks * Storage->GetBlockSize() >= NumObjects);
+
+		const int32 OldOffset = Offset;
+		const int32 OldNumBlocks = NumBlocks;
+
+		Offset = InNumBlocks > 0 ? Storage->Allocate(InNumBlocks) : INDEX_NONE;
+		NumBlocks = InNumBlocks;
+
+		if (NumObjects > 0)
+		{
+			Storage->Copy(OldOffset, Offset, NumObjects);
+		}
+
+		if (OldNumBlocks > 0)
+		{
+			Storage->Free(OldOffset, OldNumBlocks);
+		}
+	}
+
+	// Storage shared by all cells of the grid, owned by the grid
+	TST_SparseGridCellStorage<T>* Storage;
+
+	// Chunk of the storage holding this cell's objects and Structure-of-Arrays position cache
+	int32 Offset;
+	int32 NumObjects;
+	int32 NumBlocks;
+
+	// Bounds of the cached positions, lets queries skip the whole cell
+	FST_SparseGridBounds Bounds;
 
 	// Required for TSharedPtr<>
- 	TST_SparseGridCell()
-		: CellObjects(TArray<T*>())
- 		, AllocSize(16)
- 		, ShrinkMultiplier(1)
- 	{}
+	TST_SparseGridCell()
+		: Storage(nullptr)
+		, Offset(INDEX_NONE)
+		, NumObjects(0)
+		, NumBlocks(0)
+		, Bounds()
+	{}
+};
+
+/////////////////////////////////////
+///// Sparse Grid Batch Results /////
+/////////////////////////////////////
+
+/*
+* Results of a batched query.
+* Results for all queries are stored in one flattened buffer, results for query i are the range [Offsets[i], Offsets[i + 1]).
+* Can be reused between batches to avoid reallocating.
+*/
+template<class T>
+class TST_SparseGridBatchResults
+{
+public:
+	FORCEINLINE int32 GetNumQueries() const { return FMath::Max(Offsets.Num() - 1, 0); }
+
+	FORCEINLINE TArrayView<T* const> GetResults(const int32 QueryIndex) const
+	{
+		checkf(Offsets.IsValidIndex(QueryIndex + 1), TEXT("TST_SparseGridBatchResults::GetResults - Invalid Query Index '%i'!"), QueryIndex);
+		return TArrayView<T* const>(Objects.GetData() + Offsets[QueryIndex], Offsets[QueryIndex + 1] - Offsets[QueryIndex]);
+	}
+
+	FORCEINLINE const TArray<T*>& GetAllResults() const { return Objects; }
+	FORCEINLINE const TArray<int32>& GetOffsets() const { return Offsets; }
+
+	void Reset()
+	{
+		Objects.Reset();
+		Offsets.Reset();
+	}
+
+private:
+	friend class TST_SparseGrid<T>;
+
+	TArray<T*> Objects;
+	TArray<int32> Offsets;
 };
 
 //////////////////////////////////////
 ///// Sparse Grid Cell Container /////
 //////////////////////////////////////
 
+/*
+* Threading Contract
+*
+* Write Phase:	Update(), Add(), Remove(), MarkDirty(), Init() and Empty() take an exclusive lock, and should be called from the game thread.
+* Read Phase:	QueryGrid_*() and GetGridCellPopulations() take a shared lock, and are safe to call from any thread.
+*
+* A query running on another thread either completes before the next write begins, or waits for it to finish, so it always
+* sees a single consistent frame. GetUpdateEpoch() identifies which update a result came from.
+* Debug drawing is ignored for queries made off the game thread.
+*
+* Accessors returning references to internal arrays (GetRegisteredObjects(), GetGridCells()) are not guarded and are game thread only.
+*
+* Visitors:	ForEachIn*(), CountInSphere() and AnyInSphere() call back while the read lock is held. A visitor must not add, remove
+*			or destroy objects in the grid it is visiting (destroying an actor unregisters its component), nor query that grid again.
+*			Either would deadlock, debug builds assert instead. To damage or destroy what a shape overlaps, collect it with
+*			QueryGrid_*() first and act on the results once the query has returned.
+*
+* For work that spans the whole frame, enable snapshot publishing and query an immutable TST_SparseGridSnapshot instead.
+* Snapshots never block Update().
+*/
 template<class T>
-class TST_SparseGrid
+class TST_SparseGrid : public TST_SparseGridQueries<T, TST_SparseGrid<T>>
 {
+	typedef TST_SparseGridQueries<T, TST_SparseGrid<T>> Super;
+
 	//////////////////////
 	////// Lifecycle /////
 	//////////////////////
@@ -163,11 +704,19 @@ public:
 			const int32 InCellAllocSize,
 			const int32 InCellShrinkMultiplier)
 		: GridWorld(InGridWorld)
+		, CellStorage(InCellAllocSize, InCellShrinkMultiplier)
 		, GridOrigin(InGridOrigin)
 		, NumCells(InNumCells)
 		, CellSize(InCellSize)
 		, RegisterAllocSize(InRegisterAllocSize)
 		, RegisterAllocShrinkMultiplier(InRegisterShrinkMultiplier)
+		, CellLayout(EST_SparseGridCellLayout::RowMajor)
+		, MortonBits(FST_GridRef2D(0))
+		, UpdateMode(EST_SparseGridUpdateMode::Serial)
+		, ParallelUpdateBatchSize(2048)
+		, bIncrementalUpdate(false)
+		, AutoRebuildThreshold(0.5f)
+		, LastMovedFraction(0.f)
 	{
 		// Ensure we have *some* cells, to prevent divide by zero errors
 		check(GridWorld.IsValid() && NumCells.X > 0 && NumCells.Y > 0 && CellSize > 0);
@@ -178,13 +727,15 @@ public:
 		GridCells.Reserve(TotalCells);
 		for (int32 CellIdx = 0; CellIdx < TotalCells; CellIdx++)
 		{
-			GridCells.Add(TST_SparseGridCell<T>(InCellAllocSize, InCellShrinkMultiplier));
+			GridCells.Add(TST_SparseGridCell<T>(&CellStorage));
 		}
 
-		// Initialize Culling Properties
-		const float HalfCellSize = (float)CellSize * 0.5f;
-		CellBoundsRadius = FVector2D(HalfCellSize, HalfCellSize).Size();
-		CellBoundsRadiusSqrd = CellBoundsRadius * CellBoundsRadius;
+		OccupancyBits.SetNumZeroed(FMath::DivideAndRoundUp(TotalCells, 32));
+		BoundsDirtyBits.SetNumZeroed(FMath::DivideAndRoundUp(TotalCells, 32));
+
+		// Snapshots are opt-in
+		bPublishSnapshots = false;
+		LatestSnapshotSlot = INDEX_NONE;
 	}
 
 	// Destructor
@@ -202,15 +753,24 @@ protected:
 	TST_SparseGrid()
 		: GridWorld(nullptr)
 		, RegisteredObjects(TArray<T>())
+		, CellStorage(16, 1)
 		, GridCells(TArray<T>())
 		, GridOrigin(FST_GridRef2D(-2500, -2500))
 		, NumCells(FST_GridRef2D(5))
 		, CellSize(1000)
 		, RegisterAllocSize(128)
 		, RegisterAllocShrinkMultiplier(1)
-		, CellBoundsRadius(0.f)
-		, CellBoundsRadiusSqrd(0.f)
-	{}
+		, CellLayout(EST_SparseGridCellLayout::RowMajor)
+		, MortonBits(FST_GridRef2D(0))
+		, UpdateMode(EST_SparseGridUpdateMode::Serial)
+		, ParallelUpdateBatchSize(2048)
+		, bIncrementalUpdate(false)
+		, AutoRebuildThreshold(0.5f)
+		, LastMovedFraction(0.f)
+	{
+		bPublishSnapshots = false;
+		LatestSnapshotSlot = INDEX_NONE;
+	}
 
 	//////////////////////////////
 	///// Grid Functionality /////
@@ -219,212 +779,1562 @@ public:
 	/*
 	* Updates object placement in the grid.
 	* Typically once per-frame for each grid instance.
+	*
+	* Also snapshots the position of every object into its cell, queries test against these cached positions
+	* rather than calling GetSparseGridLocation() on each candidate.
+	*
+	* With incremental updates enabled, only dynamic objects and static objects marked dirty are visited.
+	* Cell bounds are only refreshed for cells an object entered, left or moved within, unless the grid was rebuilt.
 	*/
 	void Update()
 	{
 		SCOPE_CYCLE_COUNTER(STAT_UpdateGrid)
 
-#if ENABLE_GRID_BOUNDS
-		// Reset Bounds
-		ObjectBounds = FST_SparseGridBounds();
-#endif
+		SPARSE_GRID_CHECK_NOT_VISITING();
+		FRWScopeLock WriteLock(GridLock, SLT_Write);
 
-		for (T* ObjectItr : RegisteredObjects)
+		bool bRebuilt = false;
+		if (bIncrementalUpdate)
+		{
+			// Bounds are maintained incrementally, and only ever grow in this mode
+			UpdateObjects(DynamicObjects);
+			Update_Serial(DirtyObjects);
+		}
+		else
 		{
-			checkSlow(ObjectItr != nullptr);
-
-			const FVector WorldPosition = ObjectItr->GetSparseGridLocation();
-
 #if ENABLE_GRID_BOUNDS
-			// Update Bounds
-			ObjectBounds.Update(WorldPosition);
+			// Reset Bounds
+			ObjectBounds = FST_SparseGridBounds();
 #endif
 
-			const int32 DesiredCell = WorldToCell(FVector2D(WorldPosition));
-			const int32 CurrentCell = ObjectItr->GetSparseGridData().GetCellIndex();
+			bRebuilt = ShouldRebuild();
 
-			if (DesiredCell != CurrentCell)
+			const int32 NumMoved = bRebuilt ? Update_Rebuild() : UpdateObjects(RegisteredObjects);
+			LastMovedFraction = RegisteredObjects.Num() > 0 ? (float)NumMoved / (float)RegisteredObjects.Num() : 0.f;
+		}
+
+		for (T* ObjectItr : DirtyObjects)
+		{
+			ObjectItr->AccessSparseGridData().SetDirty(false);
+		}
+
+		DirtyObjects.Reset();
+
+		if (bRebuilt)
+		{
+			RefreshCellBounds();
+		}
+		else
+		{
+			RefreshDirtyCellBounds();
+		}
+
+		UpdateEpoch.Increment();
+
+		if (bPublishSnapshots)
+		{
+			PublishSnapshot();
+		}
+	}
+
+	/*
+	* Incremented after each Update().
+	* Allows callers on other threads to tell which frame of data their query results came from.
+	*/
+	FORCEINLINE int32 GetUpdateEpoch() const { return UpdateEpoch.GetValue(); }
+
+	/*
+	* Flags a static object as moved, so it is re-bucketed during the next Update().
+	* Does nothing for dynamic objects, since they are updated every frame anyway.
+	*/
+	void MarkDirty(T* InObject)
+	{
+		checkf(InObject != nullptr, TEXT("Invalid Object!"));
+
+		SPARSE_GRID_CHECK_NOT_VISITING();
+		FRWScopeLock WriteLock(GridLock, SLT_Write);
+
+		FST_SparseGridData& GridData = InObject->AccessSparseGridData();
+		if (GridData.IsStatic() && !GridData.IsDirty() && IsRegistered(InObject))
+		{
+			GridData.SetDirty(true);
+			DirtyObjects.Add(InObject);
+		}
+	}
+
+	/*
+	* Enables incremental updates, where static objects are skipped unless marked dirty.
+	*/
+	void SetIncrementalUpdate(const bool bInIncrementalUpdate)
+	{
+		bIncrementalUpdate = bInIncrementalUpdate;
+	}
+
+	FORCEINLINE bool IsIncrementalUpdate() const { return bIncrementalUpdate; }
+
+	/*
+	* Sets how object placement is refreshed in Update()
+	* Grids with fewer than InBatchSize registered objects always update serially.
+	*/
+	void SetUpdateMode(const EST_SparseGridUpdateMode InUpdateMode, const int32 InBatchSize)
+	{
+		UpdateMode = InUpdateMode;
+		ParallelUpdateBatchSize = FMath::Max(1, InBatchSize);
+	}
+
+	FORCEINLINE EST_SparseGridUpdateMode GetUpdateMode() const { return UpdateMode; }
+
+	/*
+	* Fraction of registered objects that must have changed cell in the last update for Automatic mode to rebuild.
+	*/
+	void SetAutoRebuildThreshold(const float InThreshold)
+	{
+		AutoRebuildThreshold = FMath::Clamp(InThreshold, 0.f, 1.f);
+	}
+
+	/*
+	* Fraction of registered objects that changed cell during the last full update.
+	*/
+	FORCEINLINE float GetLastMovedFraction() const { return LastMovedFraction; }
+
+private:
+	/*
+	* Rebuilds only apply to full updates. Incremental updates use the parallel path instead.
+	*/
+	FORCEINLINE bool ShouldRebuild() const
+	{
+		return UpdateMode == EST_SparseGridUpdateMode::Rebuild
+			|| (UpdateMode == EST_SparseGridUpdateMode::Automatic && LastMovedFraction >= AutoRebuildThreshold);
+	}
+
+	/*
+	* Returns the number of objects that changed cell.
+	*/
+	int32 UpdateObjects(const TArray<T*>& InObjects)
+	{
+		if (UpdateMode != EST_SparseGridUpdateMode::Serial && InObjects.Num() > ParallelUpdateBatchSize)
+		{
+			return Update_Parallel(InObjects);
+		}
+
+		return Update_Serial(InObjects);
+	}
+
+	int32 Update_Serial(const TArray<T*>& InObjects)
+	{
+		int32 NumMoved = 0;
+		for (T* ObjectItr : InObjects)
+		{
+			checkSlow(ObjectItr != nullptr);
+
+			const FVector WorldPosition = ObjectItr->GetSparseGridLocation();
+
+#if ENABLE_GRID_BOUNDS
+			// Update Bounds
+			ObjectBounds.Update(WorldPosition);
+#endif
+
+			const int32 DesiredCell = WorldToCell(FVector2D(WorldPosition));
+			const int32 CurrentCell = ObjectItr->GetSparseGridData().GetCellIndex();
+
+			if (DesiredCell != CurrentCell)
+			{
+				MoveObject(ObjectItr, CurrentCell, DesiredCell, WorldPosition);
+				NumMoved++;
+			}
+			else
+			{
+				GridCells[CurrentCell].SetPosition(ObjectItr->GetSparseGridData().GetCellSubIndex(), WorldPosition);
+				GridCells[CurrentCell].SetCategoryMask(ObjectItr->GetSparseGridData().GetCellSubIndex(), ObjectItr->GetSparseGridData().GetCategoryMask());
+				MarkCellBoundsDirty(CurrentCell);
+			}
+		}
+
+		return NumMoved;
+	}
+
+	/*
+	* Parallel Update
+	* Each batch of registered objects computes its desired cells on a worker thread. Objects staying in their cell only
+	* write their own cached position slot, so no synchronisation is needed. Objects changing cell are collected per-batch
+	* and migrated afterwards on the calling thread, since cell add/remove reorders the cell arrays.
+	*/
+	int32 Update_Parallel(const TArray<T*>& InObjects)
+	{
+		const int32 NumObjects = InObjects.Num();
+		const int32 NumBatches = FMath::DivideAndRoundUp(NumObjects, ParallelUpdateBatchSize);
+
+		BatchMovers.SetNum(NumBatches, false);
+		BatchTouchedCells.SetNum(NumBatches, false);
+#if ENABLE_GRID_BOUNDS
+		BatchBounds.Reset(NumBatches);
+		BatchBounds.AddDefaulted(NumBatches);
+#endif
+
+		ParallelFor(NumBatches, [this, &InObjects, NumObjects](const int32 BatchIdx)
+		{
+			TArray<FST_SparseGridMover>& Movers = BatchMovers[BatchIdx];
+			Movers.Reset();
+
+			// Cells written by this batch, consecutive repeats skipped
+			TArray<int32>& TouchedCells = BatchTouchedCells[BatchIdx];
+			TouchedCells.Reset();
+
+#if ENABLE_GRID_BOUNDS
+			FST_SparseGridBounds& Bounds = BatchBounds[BatchIdx];
+#endif
+
+			const int32 StartIdx = BatchIdx * ParallelUpdateBatchSize;
+			const int32 EndIdx = FMath::Min(StartIdx + ParallelUpdateBatchSize, NumObjects);
+			for (int32 ObjIdx = StartIdx; ObjIdx < EndIdx; ObjIdx++)
+			{
+				T* ObjectItr = InObjects[ObjIdx];
+				checkSlow(ObjectItr != nullptr);
+
+				const FVector WorldPosition = ObjectItr->GetSparseGridLocation();
+
+#if ENABLE_GRID_BOUNDS
+				Bounds.Update(WorldPosition);
+#endif
+
+				const int32 DesiredCell = WorldToCell(FVector2D(WorldPosition));
+				const int32 CurrentCell = ObjectItr->GetSparseGridData().GetCellIndex();
+
+				if (DesiredCell != CurrentCell)
+				{
+					Movers.Add(FST_SparseGridMover(ObjectItr, WorldPosition, DesiredCell));
+				}
+				else
+				{
+					GridCells[CurrentCell].SetPosition(ObjectItr->GetSparseGridData().GetCellSubIndex(), WorldPosition);
+					GridCells[CurrentCell].SetCategoryMask(ObjectItr->GetSparseGridData().GetCellSubIndex(), ObjectItr->GetSparseGridData().GetCategoryMask());
+
+					if (TouchedCells.Num() == 0 || TouchedCells.Last() != CurrentCell)
+					{
+						TouchedCells.Add(CurrentCell);
+					}
+				}
+			}
+		});
+
+		SCOPE_CYCLE_COUNTER(STAT_UpdateGrid_Migrate)
+
+#if ENABLE_GRID_BOUNDS
+		for (const FST_SparseGridBounds& Bounds : BatchBounds)
+		{
+			ObjectBounds.Merge(Bounds);
+		}
+#endif
+
+		for (const TArray<int32>& TouchedCells : BatchTouchedCells)
+		{
+			for (const int32 CellIdx : TouchedCells)
+			{
+				MarkCellBoundsDirty(CellIdx);
+			}
+		}
+
+		int32 NumMoved = 0;
+		for (const TArray<FST_SparseGridMover>& Movers : BatchMovers)
+		{
+			for (const FST_SparseGridMover& Mover : Movers)
+			{
+				MoveObject(Mover.Object, Mover.Object->GetSparseGridData().GetCellIndex(), Mover.DesiredCell, Mover.Position);
+			}
+
+			NumMoved += Movers.Num();
+		}
+
+		return NumMoved;
+	}
+
+	/*
+	* Recomputes tight bounds for every cell from its cached positions.
+	* Only needed once every cell has been laid out again (rebuilds and layout changes), clears the dirty cell list.
+	*/
+	void RefreshCellBounds()
+	{
+		SCOPE_CYCLE_COUNTER(STAT_UpdateGrid_CellBounds)
+
+		const int32 NumGridCells = GridCells.Num();
+		const int32 CellBatchSize = 256;
+		ParallelFor(FMath::DivideAndRoundUp(NumGridCells, CellBatchSize), [this, NumGridCells, CellBatchSize](const int32 BatchIdx)
+		{
+			const int32 EndIdx = FMath::Min((BatchIdx + 1) * CellBatchSize, NumGridCells);
+			for (int32 CellIdx = BatchIdx * CellBatchSize; CellIdx < EndIdx; CellIdx++)
 			{
-				UE_LOG(LogST_SparseGrid, VeryVerbose, TEXT("Moving Object '%s' from Cell ID '%i' to Cell ID '%i'"), *GetNameSafe(ObjectItr), CurrentCell, DesiredCell);
+				GridCells[CellIdx].RefreshBounds();
+			}
+		}, UpdateMode == EST_SparseGridUpdateMode::Serial);
+
+		BoundsDirtyCells.Reset();
+		BoundsDirtyBits.Reset();
+		BoundsDirtyBits.SetNumZeroed(FMath::DivideAndRoundUp(NumGridCells, 32));
+	}
+
+	/*
+	* Recomputes tight bounds for the cells touched since the last refresh.
+	* Objects that stay in their cell only refresh their cached position during the update, and removals never shrink
+	* the bounds, so each touched cell is refreshed once afterwards. Cost scales with the objects visited, not the grid size.
+	*/
+	void RefreshDirtyCellBounds()
+	{
+		SCOPE_CYCLE_COUNTER(STAT_UpdateGrid_CellBounds)
+
+		const int32 NumDirtyCells = BoundsDirtyCells.Num();
+		const int32 CellBatchSize = 256;
+		ParallelFor(FMath::DivideAndRoundUp(NumDirtyCells, CellBatchSize), [this, NumDirtyCells, CellBatchSize](const int32 BatchIdx)
+		{
+			const int32 EndIdx = FMath::Min((BatchIdx + 1) * CellBatchSize, NumDirtyCells);
+			for (int32 DirtyIdx = BatchIdx * CellBatchSize; DirtyIdx < EndIdx; DirtyIdx++)
+			{
+				GridCells[BoundsDirtyCells[DirtyIdx]].RefreshBounds();
+			}
+		}, UpdateMode == EST_SparseGridUpdateMode::Serial || NumDirtyCells <= CellBatchSize);
+
+		for (const int32 CellIdx : BoundsDirtyCells)
+		{
+			BoundsDirtyBits[CellIdx >> 5] &= ~(1u << (CellIdx & 31));
+		}
+
+		BoundsDirtyCells.Reset();
+	}
+
+	/*
+	* Queues a cell for RefreshDirtyCellBounds(). Game thread (write lock) only.
+	*/
+	FORCEINLINE void MarkCellBoundsDirty(const int32 InCellIndex)
+	{
+		uint32& Word = BoundsDirtyBits[InCellIndex >> 5];
+		const uint32 Mask = 1u << (InCellIndex & 31);
+		if ((Word & Mask) == 0)
+		{
+			Word |= Mask;
+			BoundsDirtyCells.Add(InCellIndex);
+		}
+	}
+
+	// Cells whose bounds may be loose or stale, as a list and a per-cell bit to skip duplicates
+	TArray<int32> BoundsDirtyCells;
+	TArray<uint32> BoundsDirtyBits;
+
+	/*
+	* Rebuild Update
+	* Rather than moving objects between cells one at a time, every cell is laid out again from scratch:
+	*
+	* 1. Positions and desired cells of all objects are gathered in parallel batches.
+	* 2. Objects are counted into cells in registration order, which also gives each object its sub-index.
+	* 3. A parallel prefix sum over the block-rounded cell sizes gives each cell's offset in the storage slab.
+	* 4. Objects are scattered into their slots in parallel, and their cell and sub-indices rewritten.
+	*
+	* Cells end up packed back-to-back in cell order, so this also compacts the storage.
+	* Returns the number of objects that changed cell.
+	*/
+	int32 Update_Rebuild()
+	{
+		const int32 NumObjects = RegisteredObjects.Num();
+		const int32 BatchSize = ParallelUpdateBatchSize;
+		const int32 NumBatches = FMath::DivideAndRoundUp(NumObjects, BatchSize);
+		const bool bSingleThread = NumBatches <= 1;
+
+		RebuildPositions.SetNumUninitialized(NumObjects, false);
+		RebuildCells.SetNumUninitialized(NumObjects, false);
+		RebuildRanks.SetNumUninitialized(NumObjects, false);
+		BatchNumMoved.Reset(NumBatches);
+		BatchNumMoved.AddZeroed(NumBatches);
+#if ENABLE_GRID_BOUNDS
+		BatchBounds.Reset(NumBatches);
+		BatchBounds.AddDefaulted(NumBatches);
+#endif
+
+		// Gather
+		ParallelFor(NumBatches, [this, NumObjects, BatchSize](const int32 BatchIdx)
+		{
+			const int32 StartIdx = BatchIdx * BatchSize;
+			const int32 EndIdx = FMath::Min(StartIdx + BatchSize, NumObjects);
+			for (int32 ObjIdx = StartIdx; ObjIdx < EndIdx; ObjIdx++)
+			{
+				T* ObjectItr = RegisteredObjects[ObjIdx];
+				checkSlow(ObjectItr != nullptr);
+
+				const FVector WorldPosition = ObjectItr->GetSparseGridLocation();
+
+#if ENABLE_GRID_BOUNDS
+				BatchBounds[BatchIdx].Update(WorldPosition);
+#endif
+
+				const int32 DesiredCell = WorldToCell(FVector2D(WorldPosition));
+				if (DesiredCell != ObjectItr->GetSparseGridData().GetCellIndex())
+				{
+					BatchNumMoved[BatchIdx]++;
+				}
+
+				RebuildPositions[ObjIdx] = WorldPosition;
+				RebuildCells[ObjIdx] = DesiredCell;
+			}
+		}, bSingleThread);
+
+		SCOPE_CYCLE_COUNTER(STAT_UpdateGrid_Migrate)
+
+		// Count
+		CellCounts.Reset(GridCells.Num());
+		CellCounts.AddZeroed(GridCells.Num());
+		for (int32 ObjIdx = 0; ObjIdx < NumObjects; ObjIdx++)
+		{
+			RebuildRanks[ObjIdx] = CellCounts[RebuildCells[ObjIdx]]++;
+		}
+
+		// Prefix Sum
+		const int32 NumSlots = PrefixSumCellCounts();
+		CellStorage.Reset(NumSlots);
+
+		for (int32 CellIdx = 0; CellIdx < GridCells.Num(); CellIdx++)
+		{
+			GridCells[CellIdx].Assign(CellOffsets[CellIdx], CellCounts[CellIdx]);
+		}
+
+		// Scatter
+		ParallelFor(NumBatches, [this, NumObjects, BatchSize](const int32 BatchIdx)
+		{
+			const int32 StartIdx = BatchIdx * BatchSize;
+			const int32 EndIdx = FMath::Min(StartIdx + BatchSize, NumObjects);
+			for (int32 ObjIdx = StartIdx; ObjIdx < EndIdx; ObjIdx++)
+			{
+				T* ObjectItr = RegisteredObjects[ObjIdx];
+				const int32 CellIdx = RebuildCells[ObjIdx];
+				const int32 SubIdx = RebuildRanks[ObjIdx];
+				const int32 Slot = CellOffsets[CellIdx] + SubIdx;
+				const FVector& WorldPosition = RebuildPositions[ObjIdx];
+
+				*CellStorage.GetObjects(Slot) = ObjectItr;
+				*CellStorage.GetPositionsX(Slot) = WorldPosition.X;
+				*CellStorage.GetPositionsY(Slot) = WorldPosition.Y;
+				*CellStorage.GetPositionsZ(Slot) = WorldPosition.Z;
+
+				FST_SparseGridData& GridData = ObjectItr->AccessSparseGridData();
+				*CellStorage.GetCategories(Slot) = GridData.GetCategoryMask();
+				GridData.SetCellIndex(CellIdx);
+				GridData.SetCellSubIndex(SubIdx);
+			}
+		}, bSingleThread);
+
+		RebuildCoarseCounts();
+		RebuildOccupancy();
+
+#if ENABLE_GRID_BOUNDS
+		for (const FST_SparseGridBounds& Bounds : BatchBounds)
+		{
+			ObjectBounds.Merge(Bounds);
+		}
+#endif
+
+		int32 NumMoved = 0;
+		for (const int32 BatchMoved : BatchNumMoved)
+		{
+			NumMoved += BatchMoved;
+		}
+
+		return NumMoved;
+	}
+
+	/*
+	* Exclusive prefix sum of CellCounts, rounded up to whole storage blocks, into CellOffsets. Returns the total.
+	* Chunks of cells are scanned in parallel, then each chunk is offset by the total of the chunks before it.
+	*/
+	int32 PrefixSumCellCounts()
+	{
+		const int32 NumGridCells = CellCounts.Num();
+		const int32 BlockSize = CellStorage.GetBlockSize();
+		const int32 ChunkSize = 4096;
+		const int32 NumChunks = FMath::DivideAndRoundUp(NumGridCells, ChunkSize);
+		const bool bSingleThread = NumChunks <= 1;
+
+		CellOffsets.SetNumUninitialized(NumGridCells, false);
+		ChunkTotals.SetNumUninitialized(NumChunks, false);
+
+		ParallelFor(NumChunks, [this, NumGridCells, BlockSize, ChunkSize](const int32 ChunkIdx)
+		{
+			const int32 EndIdx = FMath::Min((ChunkIdx + 1) * ChunkSize, NumGridCells);
+
+			int32 Sum = 0;
+			for (int32 CellIdx = ChunkIdx * ChunkSize; CellIdx < EndIdx; CellIdx++)
+			{
+				CellOffsets[CellIdx] = Sum;
+				Sum += FMath::DivideAndRoundUp(CellCounts[CellIdx], BlockSize) * BlockSize;
+			}
+
+			ChunkTotals[ChunkIdx] = Sum;
+		}, bSingleThread);
+
+		int32 Total = 0;
+		for (int32& ChunkTotal : ChunkTotals)
+		{
+			const int32 ChunkSum = ChunkTotal;
+			ChunkTotal = Total;
+			Total += ChunkSum;
+		}
+
+		ParallelFor(NumChunks, [this, NumGridCells, ChunkSize](const int32 ChunkIdx)
+		{
+			const int32 ChunkBase = ChunkTotals[ChunkIdx];
+			if (ChunkBase == 0) { return; }
+
+			const int32 EndIdx = FMath::Min((ChunkIdx + 1) * ChunkSize, NumGridCells);
+			for (int32 CellIdx = ChunkIdx * ChunkSize; CellIdx < EndIdx; CellIdx++)
+			{
+				CellOffsets[CellIdx] += ChunkBase;
+			}
+		}, bSingleThread);
+
+		return Total;
+	}
+
+	FORCEINLINE void MoveObject(T* InObject, const int32 InCurrentCell, const int32 InDesiredCell, const FVector& InPosition)
+	{
+		UE_LOG(LogST_SparseGrid, VeryVerbose, TEXT("Moving Object '%s' from Cell ID '%i' to Cell ID '%i'"), *GetNameSafe(InObject), InCurrentCell, InDesiredCell);
+
+		GridCells[InCurrentCell].Remove(InObject);
+		GridCells[InDesiredCell].Add(InObject, InPosition);
+
+		// Adding only grows the destination's bounds, the source needs a refresh to shrink
+		MarkCellBoundsDirty(InCurrentCell);
+
+		UpdateCoarseCounts(InCurrentCell, -1);
+		UpdateCoarseCounts(InDesiredCell, 1);
+		UpdateOccupancy(InCurrentCell);
+		UpdateOccupancy(InDesiredCell);
+
+		InObject->AccessSparseGridData().SetCellIndex(InDesiredCell);
+	}
+
+	/*
+	* An object leaving its cell, found during a parallel update.
+	*/
+	struct FST_SparseGridMover
+	{
+		FST_SparseGridMover(T* InObject, const FVector& InPosition, const int32 InDesiredCell)
+			: Object(InObject)
+			, Position(InPosition)
+			, DesiredCell(InDesiredCell)
+		{}
+
+		T* Object;
+		FVector Position;
+		int32 DesiredCell;
+	};
+
+	// Per-batch scratch for parallel updates, kept between frames to avoid reallocating
+	TArray<TArray<FST_SparseGridMover>> BatchMovers;
+	TArray<TArray<int32>> BatchTouchedCells;
+	TArray<int32> BatchNumMoved;
+#if ENABLE_GRID_BOUNDS
+	TArray<FST_SparseGridBounds> BatchBounds;
+#endif
+
+	// Scratch for rebuild updates, batch registration and batch removal, per-object and per-cell
+	TArray<FVector> RebuildPositions;
+	TArray<int32> RebuildCells;
+	TArray<int32> RebuildRanks;
+	TArray<int32> CellCounts;
+	TArray<int32> CellOffsets;
+	TArray<int32> ChunkTotals;
+
+public:
+	/*
+	* Registers an object with the grid.
+	* Returns true if successfully registered (or already registered)
+	*/
+	bool Add(T* InObject)
+	{
+		SPARSE_GRID_CHECK_NOT_VISITING();
+		FRWScopeLock WriteLock(GridLock, SLT_Write);
+		return Add_Unlocked(InObject);
+	}
+
+	/*
+	* Registers many objects at once, such as a wave of spawns.
+	* The register grows once, cells are computed in parallel, and each cell grows once before its objects are appended.
+	* Objects already registered (in this or another grid), and repeats of an object within the batch, are skipped.
+	* Returns the number of newly registered objects.
+	*/
+	int32 AddBatch(TArrayView<T* const> InObjects)
+	{
+		SPARSE_GRID_CHECK_NOT_VISITING();
+		FRWScopeLock WriteLock(GridLock, SLT_Write);
+		return AddBatch_Unlocked(InObjects);
+	}
+
+	/*
+	* Unregisters an object with the grid. 
+	* Returns true if successfully unregistered (or already unregistered)
+	*/
+	bool Remove(T* InObject)
+	{
+		SPARSE_GRID_CHECK_NOT_VISITING();
+		FRWScopeLock WriteLock(GridLock, SLT_Write);
+		return Remove_Unlocked(InObject);
+	}
+
+	/*
+	* Unregisters every object InPredicate accepts in a single pass, such as the contents of a streaming level being unloaded.
+	* The register is compacted in place and, with bShrinkCells, the cells that lost objects give back their slack once at the end rather than once per object.
+	* Pass bShrinkCells = false when Compact() follows, as it repacks every cell anyway.
+	* Returns the number of objects removed.
+	*/
+	template<class PredicateType>
+	int32 RemoveAll(const PredicateType& InPredicate, const bool bShrinkCells = true)
+	{
+		SPARSE_GRID_CHECK_NOT_VISITING();
+		FRWScopeLock WriteLock(GridLock, SLT_Write);
+
+		// Cells that lost objects, may hold repeats
+		RebuildCells.Reset();
+
+		int32 NumKept = 0;
+		for (int32 ObjIdx = 0; ObjIdx < RegisteredObjects.Num(); ObjIdx++)
+		{
+			T* ObjectItr = RegisteredObjects[ObjIdx];
+			FST_SparseGridData& GridData = ObjectItr->AccessSparseGridData();
+
+			if (!InPredicate(ObjectItr))
+			{
+				if (NumKept != ObjIdx)
+				{
+					RegisteredObjects[NumKept] = ObjectItr;
+					GridData.SetGridIndex(NumKept);
+				}
+
+				NumKept++;
+				continue;
+			}
+
+			const int32 CurrentCell = GridData.GetCellIndex();
+			GridData.SetCellIndex(INDEX_NONE);
+			GridCells[CurrentCell].Remove(ObjectItr, false);
+			MarkCellBoundsDirty(CurrentCell);
+
+			if (bShrinkCells && (RebuildCells.Num() == 0 || RebuildCells.Last() != CurrentCell))
+			{
+				RebuildCells.Add(CurrentCell);
+			}
+
+			UpdateCoarseCounts(CurrentCell, -1);
+			UpdateOccupancy(CurrentCell);
+
+			RemoveFromUpdateLists(ObjectItr);
+			GridData.SetGridIndex(INDEX_NONE);
+		}
+
+		const int32 NumRemoved = RegisteredObjects.Num() - NumKept;
+		if (NumRemoved > 0)
+		{
+			RegisteredObjects.SetNum(NumKept, false);
+
+			for (const int32 CellIdx : RebuildCells)
+			{
+				GridCells[CellIdx].ShrinkToFit();
+			}
+
+			if (RegisterAllocShrinkMultiplier >= 0 && RegisteredObjects.GetSlack() > RegisterAllocSize * FMath::Max(RegisterAllocShrinkMultiplier, 1))
+			{
+				RegisteredObjects.Shrink();
+			}
+
+			UE_LOG(LogST_SparseGrid, Verbose, TEXT("Removed '%i' Sparse Grid Objects in one pass, '%i' remaining."), NumRemoved, NumKept);
+		}
+
+		return NumRemoved;
+	}
+
+	/*
+	* Lays every cell out again back-to-back in a slab sized to fit and releases the old one, along with every free chunk.
+	* Storage only: the cached positions, counts and bounds are kept as they are and no object location is read, and as each cell keeps its order, CellSubIndex stays valid.
+	* Use after removing many objects, so the memory held by the grid follows the objects still registered.
+	*/
+	void Compact()
+	{
+		SPARSE_GRID_CHECK_NOT_VISITING();
+		FRWScopeLock WriteLock(GridLock, SLT_Write);
+
+		const int32 BlockSize = CellStorage.GetBlockSize();
+
+		int32 NumPackedSlots = 0;
+		for (const TST_SparseGridCell<T>& CellItr : GridCells)
+		{
+			NumPackedSlots += FMath::DivideAndRoundUp(CellItr.NumObjects, BlockSize) * BlockSize;
+		}
+
+		TST_SparseGridCellStorage<T> PackedStorage(BlockSize, CellStorage.GetShrinkMultiplier());
+		PackedStorage.Reserve(NumPackedSlots);
+
+		for (TST_SparseGridCell<T>& CellItr : GridCells)
+		{
+			CellItr.RepackInto(PackedStorage);
+		}
+
+		// Cells keep pointing at CellStorage, which now holds the packed slab
+		CellStorage = MoveTemp(PackedStorage);
+	}
+
+private:
+	bool Add_Unlocked(T* InObject)
+	{
+		checkf(InObject != nullptr, TEXT("Invalid Object!"));
+		checkf(InObject->GetWorld() == GetGridWorld(), TEXT("Invalid Object World!"));
+
+		if (InObject->GetSparseGridData().IsValid())
+		{
+			// If the object has valid data, it should *only* exist in this grid.
+			const int32 GridIndex = InObject->GetSparseGridData().GetGridIndex();
+			if (RegisteredObjects.IsValidIndex(GridIndex) && RegisteredObjects[GridIndex] == InObject)
+			{
+				UE_LOG(LogST_SparseGrid, Verbose, TEXT("'%s' is already registered!"), *GetNameSafe(InObject));
+
+				// The static flag or categories may have been set since the object was first added, e.g. by Init() before the owner registered it
+				SyncUpdateLists(InObject);
+				return true;
+			}
+			else
+			{
+				UE_LOG(LogST_SparseGrid, Warning, TEXT("'%s' is already registered in another grid!"), *GetNameSafe(InObject));
+				return false;
+			}
+		}
+		else
+		{
+			UE_LOG(LogST_SparseGrid, VeryVerbose, TEXT("Registering Sparse Grid Object: '%s'"), *GetNameSafe(InObject));
+
+			// Grow Array if Required
+			if (RegisteredObjects.GetSlack() <= 0)
+			{
+				RegisteredObjects.Reserve(RegisteredObjects.Max() + RegisterAllocSize);
+				UE_LOG(LogST_SparseGrid, Verbose, TEXT("Registered Grid Objects Array Resized! '%i' Max elements."), RegisteredObjects.Max());
+			}
+
+			InObject->AccessSparseGridData().SetGridIndex(RegisteredObjects.Add(InObject));
+
+			// Add to Cell (Ensure Is Valid)
+			const FVector WorldPosition = InObject->GetSparseGridLocation();
+			const int32 DesiredCell = WorldToCell(FVector2D(WorldPosition));
+			checkfSlow(GridCells.IsValidIndex(DesiredCell), TEXT("Object '%s' at position '%s' cannot be registered in Sparse Grid Cell '%i'"), *GetNameSafe(InObject), *WorldPosition.ToString(), DesiredCell);
+
+			InObject->AccessSparseGridData().SetCellIndex(DesiredCell);
+			GridCells[DesiredCell].Add(InObject, WorldPosition);
+
+#if ENABLE_GRID_BOUNDS
+			// Boundary cell culling relies on the bounds covering every object
+			ObjectBounds.Update(WorldPosition);
+#endif
+
+			UpdateCoarseCounts(DesiredCell, 1);
+			UpdateOccupancy(DesiredCell);
+
+			// Static objects are skipped by incremental updates
+			if (!InObject->GetSparseGridData().IsStatic())
+			{
+				InObject->AccessSparseGridData().SetDynamicIndex(DynamicObjects.Add(InObject));
+			}
+
+			return true;
+		}
+	}
+
+	int32 AddBatch_Unlocked(TArrayView<T* const> InObjects)
+	{
+		const UWorld* lWorld = GetGridWorld();
+
+		// Grow the register once, in whole allocation blocks
+		const int32 FirstNewIdx = RegisteredObjects.Num();
+		const int32 RequiredMax = FMath::DivideAndRoundUp(FirstNewIdx + InObjects.Num(), RegisterAllocSize) * RegisterAllocSize;
+		if (RegisteredObjects.Max() < RequiredMax)
+		{
+			RegisteredObjects.Reserve(RequiredMax);
+			UE_LOG(LogST_SparseGrid, Verbose, TEXT("Registered Grid Objects Array Resized! '%i' Max elements."), RegisteredObjects.Max());
+		}
+
+		// Accept serially, taking a register slot also dedupes the batch
+		// Accepted objects only have a grid index until they are appended, so anything not fully clear is skipped
+		for (T* ObjectItr : InObjects)
+		{
+			checkf(ObjectItr != nullptr, TEXT("Invalid Object!"));
+			checkf(ObjectItr->GetWorld() == lWorld, TEXT("Invalid Object World!"));
+
+			if (!ObjectItr->GetSparseGridData().IsClear())
+			{
+				UE_LOG(LogST_SparseGrid, Verbose, TEXT("Skipped batch registration of '%s' because it is already registered or repeated in the batch."), *GetNameSafe(ObjectItr));
+				continue;
+			}
+
+			ObjectItr->AccessSparseGridData().SetGridIndex(RegisteredObjects.Add(ObjectItr));
+		}
+
+		const int32 NumNew = RegisteredObjects.Num() - FirstNewIdx;
+		if (NumNew == 0)
+		{
+			return 0;
+		}
+
+		const int32 BatchSize = ParallelUpdateBatchSize;
+		const int32 NumBatches = FMath::DivideAndRoundUp(NumNew, BatchSize);
+		const bool bSingleThread = NumBatches <= 1 || UpdateMode == EST_SparseGridUpdateMode::Serial;
+
+		RebuildPositions.SetNumUninitialized(NumNew, false);
+		RebuildCells.SetNumUninitialized(NumNew, false);
+#if ENABLE_GRID_BOUNDS
+		BatchBounds.Reset(NumBatches);
+		BatchBounds.AddDefaulted(NumBatches);
+#endif
+
+		// Gather positions and cells
+		ParallelFor(NumBatches, [this, FirstNewIdx, NumNew, BatchSize](const int32 BatchIdx)
+		{
+			const int32 StartIdx = BatchIdx * BatchSize;
+			const int32 EndIdx = FMath::Min(StartIdx + BatchSize, NumNew);
+			for (int32 NewIdx = StartIdx; NewIdx < EndIdx; NewIdx++)
+			{
+				const FVector WorldPosition = RegisteredObjects[FirstNewIdx + NewIdx]->GetSparseGridLocation();
+
+#if ENABLE_GRID_BOUNDS
+				BatchBounds[BatchIdx].Update(WorldPosition);
+#endif
+
+				RebuildPositions[NewIdx] = WorldPosition;
+				RebuildCells[NewIdx] = WorldToCell(FVector2D(WorldPosition));
+			}
+		}, bSingleThread);
+
+		// Count, then grow each cell once
+		CellCounts.Reset(GridCells.Num());
+		CellCounts.AddZeroed(GridCells.Num());
+		for (int32 NewIdx = 0; NewIdx < NumNew; NewIdx++)
+		{
+			CellCounts[RebuildCells[NewIdx]]++;
+		}
+
+		for (int32 CellIdx = 0; CellIdx < GridCells.Num(); CellIdx++)
+		{
+			if (CellCounts[CellIdx] > 0)
+			{
+				GridCells[CellIdx].Reserve(CellCounts[CellIdx]);
+			}
+		}
+
+		// Append
+		for (int32 NewIdx = 0; NewIdx < NumNew; NewIdx++)
+		{
+			T* ObjectItr = RegisteredObjects[FirstNewIdx + NewIdx];
+			const int32 CellIdx = RebuildCells[NewIdx];
+
+			// An object taking two register slots would be left dangling in one of them once removed
+			checkf(ObjectItr->GetSparseGridData().GetGridIndex() == FirstNewIdx + NewIdx, TEXT("'%s' was registered twice in one batch!"), *GetNameSafe(ObjectItr));
+
+			ObjectItr->AccessSparseGridData().SetCellIndex(CellIdx);
+			GridCells[CellIdx].Add(ObjectItr, RebuildPositions[NewIdx]);
+
+			// Static objects are skipped by incremental updates
+			if (!ObjectItr->GetSparseGridData().IsStatic())
+			{
+				ObjectItr->AccessSparseGridData().SetDynamicIndex(DynamicObjects.Add(ObjectItr));
+			}
+		}
+
+		for (int32 CellIdx = 0; CellIdx < GridCells.Num(); CellIdx++)
+		{
+			if (CellCounts[CellIdx] > 0)
+			{
+				UpdateCoarseCounts(CellIdx, CellCounts[CellIdx]);
+				UpdateOccupancy(CellIdx);
+			}
+		}
+
+#if ENABLE_GRID_BOUNDS
+		// Boundary cell culling relies on the bounds covering every object
+		for (const FST_SparseGridBounds& Bounds : BatchBounds)
+		{
+			ObjectBounds.Merge(Bounds);
+		}
+#endif
+
+		UE_LOG(LogST_SparseGrid, Verbose, TEXT("Batch registered '%i' Sparse Grid Objects."), NumNew);
+		return NumNew;
+	}
+
+	bool Remove_Unlocked(T* InObject)
+	{
+		checkf(InObject != nullptr, TEXT("Invalid Component!"));
+
+		if (InObject->GetSparseGridData().IsClear())
+		{
+			UE_LOG(LogST_SparseGrid, Verbose, TEXT("'%s' is not registered!"), *GetNameSafe(InObject));
+			return true;
+		}
+		else
+		{
+			// If the object has valid data, we can only unregister if it belongs to this grid.
+			const int32 GridIndex = InObject->GetSparseGridData().GetGridIndex();
+			if (!RegisteredObjects.IsValidIndex(GridIndex) || RegisteredObjects[GridIndex] != InObject)
+			{
+				UE_LOG(LogST_SparseGrid, Warning, TEXT("'%s' is registered in another grid - cannot unregister!"), *GetNameSafe(InObject));
+				return false;
+			}
+			else
+			{
+				UE_LOG(LogST_SparseGrid, VeryVerbose, TEXT("Unregistering Sparse Grid Object: '%s'"), *GetNameSafe(InObject));
+
+				// Remove from Cell
+				const int32 CurrentCell = InObject->GetSparseGridData().GetCellIndex();
+				InObject->AccessSparseGridData().SetCellIndex(INDEX_NONE);
+				GridCells[CurrentCell].Remove(InObject);
+				MarkCellBoundsDirty(CurrentCell);
+				UpdateCoarseCounts(CurrentCell, -1);
+				UpdateOccupancy(CurrentCell);
+
+				RemoveFromUpdateLists(InObject);
+
+				// We want to move the component the end of the registered array
+				// Need to swap if it's not already there
+				if (InObject != RegisteredObjects.Last())
+				{
+					const int32 SwapIndex = InObject->GetSparseGridData().GetGridIndex();
+					RegisteredObjects.Swap(SwapIndex, RegisteredObjects.Num() - 1);
+
+					// Update the component we swapped with so it has the correct index
+					T* LastObject = RegisteredObjects[SwapIndex];
+					checkSlow(LastObject != nullptr);
+
+					LastObject->AccessSparseGridData().SetGridIndex(SwapIndex);
+				}
+
+				// Check Last Element is the InObject
+				checkfSlow(RegisteredObjects.Last() == InObject, TEXT("Old Object Not Last In Array!"));
 
-				GridCells[CurrentCell].Remove(ObjectItr);
-				GridCells[DesiredCell].Add(ObjectItr);
+				// Remove and clear cell index
+				RegisteredObjects.RemoveAt(RegisteredObjects.Num() - 1, 1, false);
+				InObject->AccessSparseGridData().SetGridIndex(INDEX_NONE);
+
+				// Shrink if required
+				const int32 Slack = RegisteredObjects.GetSlack();
+				if (Slack >= 0 && Slack % RegisterAllocSize == 0 && Slack > RegisterAllocSize * RegisterAllocShrinkMultiplier)
+				{
+					RegisteredObjects.Shrink();
+				}
 
-				ObjectItr->AccessSparseGridData().SetCellIndex(DesiredCell);
+				return true;
 			}
 		}
 	}
 
+public:
 	/*
-	* Registers an object with the grid.
-	* Returns true if successfully registered (or already registered)
+	* Initializes the sparse grid with all grid objects in it's assigned world
+	* If bAllowChildClasses is true, then we will also register child classes of the given type (must be true for blueprint classes)
+	* This function is expensive, do not use it often.
 	*/
-	bool Add(T* InObject)
+	void Init(const bool bAllowChildClasses = false)
 	{
-		checkf(InObject != nullptr, TEXT("Invalid Object!"));
-		checkf(InObject->GetWorld() == GetGridWorld(), TEXT("Invalid Object World!"));
+		Init(bAllowChildClasses, [](const T* Object) { return true; });
+	}
 
-		if (InObject->GetSparseGridData().IsValid())
+	/*
+	* As above, but only registers objects InPredicate accepts.
+	* Allows several grids of the same object type to share a world, with each taking its own objects.
+	*/
+	template<class PredicateType>
+	void Init(const bool bAllowChildClasses, const PredicateType& InPredicate)
+	{
+		const UWorld* lWorld = GetGridWorld();
+		check(lWorld);
+
+		SPARSE_GRID_CHECK_NOT_VISITING();
+		FRWScopeLock WriteLock(GridLock, SLT_Write);
+
+		TArray<T*> NewObjects;
+		TST_SparseGridWorldObjects<T>::ForEach(lWorld, [&NewObjects, &InPredicate, bAllowChildClasses](T* ObjectItr)
 		{
-			// If the object has valid data, it should *only* exist in this grid.
-			const int32 GridIndex = InObject->GetSparseGridData().GetGridIndex();
-			if (RegisteredObjects.IsValidIndex(GridIndex) && RegisteredObjects[GridIndex] == InObject)
+			if (!ObjectItr || ObjectItr->IsPendingKillOrUnreachable())
 			{
-				UE_LOG(LogST_SparseGrid, Verbose, TEXT("'%s' is already registered!"), *GetNameSafe(InObject));
-				return true;
+				return;
+			}
+
+			if (!bAllowChildClasses && ExactCast<T>(ObjectItr) == nullptr)
+			{
+				UE_LOG(LogST_SparseGrid, VeryVerbose, TEXT("Skipped Sparse Grid registration of '%s' because it does not match exact class '%s'"), *GetNameSafe(ObjectItr), *GetNameSafe(T::StaticClass()));
+				return;
+			}
+
+			if (!InPredicate(ObjectItr))
+			{
+				return;
+			}
+
+			if (ObjectItr->GetSparseGridData().IsClear())
+			{
+				NewObjects.Add(ObjectItr);
 			}
 			else
 			{
-				UE_LOG(LogST_SparseGrid, Warning, TEXT("'%s' is already registered in another grid!"), *GetNameSafe(InObject));
-				return false;
+				UE_LOG(LogST_SparseGrid, VeryVerbose, TEXT("Skipped Sparse Grid registration of '%s' because it is already registered."), *GetNameSafe(ObjectItr));
 			}
+		});
+
+		AddBatch_Unlocked(NewObjects);
+	}
+
+	/*
+	* Unregisters all registered objects.
+	* Does not destroy cells but clears all allocations.
+	*/
+	void Empty()
+	{
+		SPARSE_GRID_CHECK_NOT_VISITING();
+		FRWScopeLock WriteLock(GridLock, SLT_Write);
+
+		for (TST_SparseGridCell<T>& CellItr : GridCells)
+		{
+			CellItr.Empty();
 		}
-		else
+
+		CellStorage.Empty();
+
+		for (FST_SparseGridLevel& LevelItr : CoarseLevels)
 		{
-			UE_LOG(LogST_SparseGrid, VeryVerbose, TEXT("Registering Sparse Grid Object: '%s'"), *GetNameSafe(InObject));
+			FMemory::Memzero(LevelItr.Counts.GetData(), LevelItr.Counts.Num() * sizeof(int32));
+		}
 
-			// Grow Array if Required
-			if (RegisteredObjects.GetSlack() <= 0)
+		FMemory::Memzero(OccupancyBits.GetData(), OccupancyBits.Num() * sizeof(uint32));
+		FMemory::Memzero(BoundsDirtyBits.GetData(), BoundsDirtyBits.Num() * sizeof(uint32));
+		BoundsDirtyCells.Reset();
+
+		for (T* ObjectItr : RegisteredObjects)
+		{
+			checkSlow(ObjectItr != nullptr);
+
+			ObjectItr->AccessSparseGridData().SetGridIndex(INDEX_NONE);
+			ObjectItr->AccessSparseGridData().SetCellIndex(INDEX_NONE);
+			ObjectItr->AccessSparseGridData().SetCellSubIndex(INDEX_NONE);
+			ObjectItr->AccessSparseGridData().SetDynamicIndex(INDEX_NONE);
+			ObjectItr->AccessSparseGridData().SetDirty(false);
+		}
+
+		RegisteredObjects.Empty();
+		DynamicObjects.Empty();
+		DirtyObjects.Empty();
+
+#if ENABLE_GRID_BOUNDS
+		ObjectBounds = FST_SparseGridBounds();
+#endif
+	}
+
+	/*
+	* Whether the object is registered in this grid.
+	*/
+	FORCEINLINE bool IsRegistered(const T* InObject) const
+	{
+		const int32 GridIndex = InObject->GetSparseGridData().GetGridIndex();
+		return RegisteredObjects.IsValidIndex(GridIndex) && RegisteredObjects[GridIndex] == InObject;
+	}
+
+private:
+	/*
+	* Moves a registered object between the dynamic and dirty lists to match its static flag.
+	* Static objects are marked dirty so their cached category mask is refreshed during the next Update().
+	*/
+	void SyncUpdateLists(T* InObject)
+	{
+		FST_SparseGridData& GridData = InObject->AccessSparseGridData();
+		if (GridData.IsStatic())
+		{
+			if (GridData.GetDynamicIndex() != INDEX_NONE)
 			{
-				RegisteredObjects.Reserve(RegisteredObjects.Max() + RegisterAllocSize);
-				UE_LOG(LogST_SparseGrid, Verbose, TEXT("Registered Grid Objects Array Resized! '%i' Max elements."), RegisteredObjects.Max());
+				RemoveFromUpdateLists(InObject);
 			}
 
-			InObject->AccessSparseGridData().SetGridIndex(RegisteredObjects.Add(InObject));
+			if (!GridData.IsDirty())
+			{
+				GridData.SetDirty(true);
+				DirtyObjects.Add(InObject);
+			}
+		}
+		else if (GridData.GetDynamicIndex() == INDEX_NONE)
+		{
+			RemoveFromUpdateLists(InObject);
+			GridData.SetDynamicIndex(DynamicObjects.Add(InObject));
+		}
+	}
 
-			// Add to Cell (Ensure Is Valid)
-			const int32 DesiredCell = WorldToCell(FVector2D(InObject->GetSparseGridLocation()));
-			checkfSlow(GridCells.IsValidIndex(DesiredCell), TEXT("Object '%s' at position '%s' cannot be registered in Sparse Grid Cell '%i'"), *GetNameSafe(InObject), *InObject->GetSparseGridLocation().ToString(), DesiredCell);
+	void RemoveFromUpdateLists(T* InObject)
+	{
+		FST_SparseGridData& GridData = InObject->AccessSparseGridData();
 
-			InObject->AccessSparseGridData().SetCellIndex(DesiredCell);
-			GridCells[DesiredCell].Add(InObject);
+		const int32 DynamicIndex = GridData.GetDynamicIndex();
+		if (DynamicIndex != INDEX_NONE)
+		{
+			checkfSlow(DynamicObjects.IsValidIndex(DynamicIndex) && DynamicObjects[DynamicIndex] == InObject, TEXT("Invalid Dynamic Index '%i'"), DynamicIndex);
+
+			DynamicObjects.RemoveAtSwap(DynamicIndex, 1, false);
+			if (DynamicObjects.IsValidIndex(DynamicIndex))
+			{
+				DynamicObjects[DynamicIndex]->AccessSparseGridData().SetDynamicIndex(DynamicIndex);
+			}
+
+			GridData.SetDynamicIndex(INDEX_NONE);
+		}
+
+		if (GridData.IsDirty())
+		{
+			DirtyObjects.RemoveSingleSwap(InObject, false);
+			GridData.SetDirty(false);
+		}
+	}
+
+	///////////////////////
+	///// Cell Layout /////
+	///////////////////////
+public:
+	/*
+	* Sets how cells are ordered in memory.
+	* With the Morton layout, the cells of a search tile sit close together in memory rather than NumCellsY apart.
+	* Existing cells are moved as a whole, so this is cheap before Init() but touches every registered object after it.
+	*/
+	void SetCellLayout(const EST_SparseGridCellLayout InCellLayout)
+	{
+		SPARSE_GRID_CHECK_NOT_VISITING();
+		FRWScopeLock WriteLock(GridLock, SLT_Write);
+
+		if (InCellLayout == CellLayout) { return; }
+
+		// Logical cell order doesn't depend on the layout, remember where each cell currently lives
+		TArray<int32> OldCellIndices;
+		OldCellIndices.Reserve(NumCells.X * NumCells.Y);
+		for (int32 XIdx = 0; XIdx < NumCells.X; XIdx++)
+		{
+			for (int32 YIdx = 0; YIdx < NumCells.Y; YIdx++)
+			{
+				OldCellIndices.Add(GetCellIndex(FST_GridRef2D(XIdx, YIdx)));
+			}
+		}
+
+		CellLayout = InCellLayout;
+		MortonBits = FST_GridRef2D(FMath::CeilLogTwo(NumCells.X), FMath::CeilLogTwo(NumCells.Y));
+
+		const int32 TotalCells = CellLayout == EST_SparseGridCellLayout::Morton ? 1 << (MortonBits.X + MortonBits.Y) : NumCells.X * NumCells.Y;
+
+		TArray<TST_SparseGridCell<T>> OldCells = MoveTemp(GridCells);
+		GridCells.Reset(TotalCells);
+		for (int32 CellIdx = 0; CellIdx < TotalCells; CellIdx++)
+		{
+			GridCells.Add(TST_SparseGridCell<T>(&CellStorage));
+		}
+
+		int32 LogicalIdx = 0;
+		for (int32 XIdx = 0; XIdx < NumCells.X; XIdx++)
+		{
+			for (int32 YIdx = 0; YIdx < NumCells.Y; YIdx++)
+			{
+				const int32 NewCellIndex = GetCellIndex(FST_GridRef2D(XIdx, YIdx));
+				GridCells[NewCellIndex] = MoveTemp(OldCells[OldCellIndices[LogicalIdx++]]);
+
+				// Sub-indices are unchanged, only the cell moved
+				for (T* ObjectItr : GridCells[NewCellIndex].GetObjects())
+				{
+					ObjectItr->AccessSparseGridData().SetCellIndex(NewCellIndex);
+				}
+			}
+		}
+
+		// Dirty cell indices refer to the old layout
+		RefreshCellBounds();
+	}
+
+	FORCEINLINE EST_SparseGridCellLayout GetCellLayout() const { return CellLayout; }
+
+private:
+	/*
+	* Interleaves the low bits of both axes, Y in the lowest bit to match row-major order within a column.
+	* When one axis has more bits than the other, its remaining bits are stored above the interleaved bits.
+	*/
+	FORCEINLINE int32 MortonEncode(const FST_GridRef2D& CellXY) const
+	{
+		const int32 SharedBits = FMath::Min(MortonBits.X, MortonBits.Y);
+		const uint32 SharedMask = (1u << SharedBits) - 1u;
+
+		const uint32 Interleaved = (SpreadBits(static_cast<uint32>(CellXY.X) & SharedMask) << 1) | SpreadBits(static_cast<uint32>(CellXY.Y) & SharedMask);
+		const uint32 Upper = static_cast<uint32>(MortonBits.X > MortonBits.Y ? CellXY.X : CellXY.Y) >> SharedBits;
+
+		return static_cast<int32>(Interleaved | (Upper << (SharedBits * 2)));
+	}
+
+	FORCEINLINE FST_GridRef2D MortonDecode(const int32 CellID) const
+	{
+		const int32 SharedBits = FMath::Min(MortonBits.X, MortonBits.Y);
+		const uint32 Index = static_cast<uint32>(CellID);
+		const uint32 Upper = (Index >> (SharedBits * 2)) << SharedBits;
+
+		const uint32 SharedMask = (1u << SharedBits) - 1u;
+
+		uint32 CellX = CompactBits(Index >> 1) & SharedMask;
+		uint32 CellY = CompactBits(Index) & SharedMask;
+
+		if (MortonBits.X > MortonBits.Y) { CellX |= Upper; }
+		else { CellY |= Upper; }
+
+		return FST_GridRef2D(static_cast<int32>(CellX), static_cast<int32>(CellY));
+	}
+
+	// Inserts a zero bit between each of the low 16 bits
+	static FORCEINLINE uint32 SpreadBits(uint32 InValue)
+	{
+		InValue = (InValue | (InValue << 8)) & 0x00FF00FF;
+		InValue = (InValue | (InValue << 4)) & 0x0F0F0F0F;
+		InValue = (InValue | (InValue << 2)) & 0x33333333;
+		InValue = (InValue | (InValue << 1)) & 0x55555555;
+		return InValue;
+	}
+
+	// Inverse of SpreadBits(), gathers every other bit
+	static FORCEINLINE uint32 CompactBits(uint32 InValue)
+	{
+		InValue &= 0x55555555;
+		InValue = (InValue | (InValue >> 1)) & 0x33333333;
+		InValue = (InValue | (InValue >> 2)) & 0x0F0F0F0F;
+		InValue = (InValue | (InValue >> 4)) & 0x00FF00FF;
+		InValue = (InValue | (InValue >> 8)) & 0x0000FFFF;
+		return InValue;
+	}
+
+	/////////////////////
+	///// Hierarchy /////
+	/////////////////////
+public:
+	/*
+	* Builds coarse occupancy levels on top of the grid cells.
+	* Each level groups InRatio x InRatio cells of the level below, and keeps a count of the objects inside each group.
+	* Queries covering many cells start from the coarsest level that fits their tile and skip empty groups in one step.
+	* Zero levels disables the hierarchy.
+	*/
+	void SetCoarseLevels(const int32 InNumLevels, const int32 InRatio)
+	{
+		SPARSE_GRID_CHECK_NOT_VISITING();
+		FRWScopeLock WriteLock(GridLock, SLT_Write);
+
+		CoarseLevels.Reset();
+
+		const int32 Ratio = FMath::Max(InRatio, 2);
+		int32 CellsPerBlock = 1;
+		for (int32 LevelIdx = 0; LevelIdx < InNumLevels; LevelIdx++)
+		{
+			CellsPerBlock *= Ratio;
+
+			// No point adding levels that cover the whole grid with a single block
+			if (CellsPerBlock >= FMath::Max(NumCells.X, NumCells.Y))
+			{
+				break;
+			}
+
+			FST_SparseGridLevel& NewLevel = CoarseLevels.AddDefaulted_GetRef();
+			NewLevel.CellsPerBlock = CellsPerBlock;
+			NewLevel.NumBlocks = FST_GridRef2D(FMath::DivideAndRoundUp(NumCells.X, CellsPerBlock), FMath::DivideAndRoundUp(NumCells.Y, CellsPerBlock));
+			NewLevel.Counts.SetNumZeroed(NewLevel.NumBlocks.X * NewLevel.NumBlocks.Y);
+		}
+
+		RebuildCoarseCounts();
+	}
+
+	FORCEINLINE int32 GetNumCoarseLevels() const { return CoarseLevels.Num(); }
+
+private:
+	/*
+	* A coarse level of the hierarchy.
+	* Blocks are indexed in the same order as cells.
+	*/
+	struct FST_SparseGridLevel
+	{
+		int32 CellsPerBlock;
+		FST_GridRef2D NumBlocks;
+		TArray<int32> Counts;
+
+		FORCEINLINE int32 GetBlockIndex(const int32 InBlockX, const int32 InBlockY) const
+		{
+			return InBlockY + InBlockX * NumBlocks.Y;
+		}
+	};
+
+	/*
+	* Recounts every coarse level from the cells.
+	*/
+	void RebuildCoarseCounts()
+	{
+		if (CoarseLevels.Num() == 0) { return; }
+
+		for (FST_SparseGridLevel& LevelItr : CoarseLevels)
+		{
+			FMemory::Memzero(LevelItr.Counts.GetData(), LevelItr.Counts.Num() * sizeof(int32));
+		}
+
+		for (int32 CellIdx = 0; CellIdx < GridCells.Num(); CellIdx++)
+		{
+			UpdateCoarseCounts(CellIdx, GridCells[CellIdx].GetObjects().Num());
+		}
+	}
+
+	FORCEINLINE void UpdateCoarseCounts(const int32 InCellIndex, const int32 InDelta)
+	{
+		if (CoarseLevels.Num() == 0 || InDelta == 0) { return; }
+
+		const FST_GridRef2D CellXY = CellLayout == EST_SparseGridCellLayout::Morton ? MortonDecode(InCellIndex) : FST_GridRef2D(InCellIndex / NumCells.Y, InCellIndex % NumCells.Y);
+		for (FST_SparseGridLevel& LevelItr : CoarseLevels)
+		{
+			LevelItr.Counts[LevelItr.GetBlockIndex(CellXY.X / LevelItr.CellsPerBlock, CellXY.Y / LevelItr.CellsPerBlock)] += InDelta;
+			checkSlow(LevelItr.Counts[LevelItr.GetBlockIndex(CellXY.X / LevelItr.CellsPerBlock, CellXY.Y / LevelItr.CellsPerBlock)] >= 0);
+		}
+	}
+
+	/*
+	* Calls InFunc(CellXY) for each occupied cell in the tile, in tile order.
+	* Starts from the coarsest level with blocks no larger than half the tile, so small queries go straight to the cells.
+	* InFunc returns false to stop walking. Returns false if stopped.
+	*/
+	template<class FuncType>
+	FORCEINLINE bool ForEachTileCell(const FST_SparseGridCellTile& Tile, FuncType&& InFunc) const
+	{
+		return ForEachTileCell(Tile, [](const int32 InRow) { return FST_GridRef2D(0, MAX_int32); }, InFunc);
+	}
+
+	/*
+	* As above, but InRowSpan(Row) narrows each row of the tile to the [X, Y) range of columns the query shape overlaps.
+	*/
+	template<class RowSpanType, class FuncType>
+	FORCEINLINE bool ForEachTileCell(const FST_SparseGridCellTile& Tile, const RowSpanType& InRowSpan, FuncType&& InFunc) const
+	{
+		if (Tile.End.X <= Tile.Start.X || Tile.End.Y <= Tile.Start.Y) { return true; }
+
+		const int32 TileSize = FMath::Max(Tile.End.X - Tile.Start.X, Tile.End.Y - Tile.Start.Y);
+
+		int32 StartLevel = CoarseLevels.Num() - 1;
+		while (StartLevel >= 0 && CoarseLevels[StartLevel].CellsPerBlock * 2 > TileSize)
+		{
+			StartLevel--;
+		}
+
+		return ForEachTileCell_Level(StartLevel, Tile, InRowSpan, InFunc);
+	}
+
+	template<class RowSpanType, class FuncType>
+	bool ForEachTileCell_Level(const int32 InLevel, const FST_SparseGridCellTile& Tile, const RowSpanType& InRowSpan, FuncType& InFunc) const
+	{
+		if (InLevel < 0)
+		{
+			for (int32 CIdx = Tile.Start.Y; CIdx < Tile.End.Y; CIdx++)
+			{
+				const FST_GridRef2D RowSpan = InRowSpan(CIdx);
+				if (!ForEachOccupiedRowCell(CIdx, FMath::Max(Tile.Start.X, RowSpan.X), FMath::Min(Tile.End.X, RowSpan.Y), InFunc))
+				{
+					return false;
+				}
+			}
 
 			return true;
 		}
+
+		const FST_SparseGridLevel& Level = CoarseLevels[InLevel];
+		const int32 Block = Level.CellsPerBlock;
+
+		for (int32 BlockY = Tile.Start.Y / Block; BlockY <= (Tile.End.Y - 1) / Block; BlockY++)
+		{
+			for (int32 BlockX = Tile.Start.X / Block; BlockX <= (Tile.End.X - 1) / Block; BlockX++)
+			{
+				if (Level.Counts[Level.GetBlockIndex(BlockX, BlockY)] == 0)
+				{
+					continue;
+				}
+
+				const FST_SparseGridCellTile SubTile = FST_SparseGridCellTile(
+					FST_GridRef2D(FMath::Max(Tile.Start.X, BlockX * Block), FMath::Max(Tile.Start.Y, BlockY * Block)),
+					FST_GridRef2D(FMath::Min(Tile.End.X, (BlockX + 1) * Block), FMath::Min(Tile.End.Y, (BlockY + 1) * Block)));
+
+				if (!ForEachTileCell_Level(InLevel - 1, SubTile, InRowSpan, InFunc))
+				{
+					return false;
+				}
+			}
+		}
+
+		return true;
 	}
 
 	/*
-	* Unregisters an object with the grid. 
-	* Returns true if successfully unregistered (or already unregistered)
+	* Coarse occupancy levels, finest first.
+	*/
+	TArray<FST_SparseGridLevel> CoarseLevels;
+
+	/*
+	* Occupancy Bitmap
+	* One bit per cell, set while the cell holds any objects.
+	* Bits are ordered X-first regardless of the cell layout, so each row of a search tile is a contiguous run of bits.
+	*/
+	TArray<uint32> OccupancyBits;
+
+	FORCEINLINE bool IsCellOccupied(const FST_GridRef2D& CellXY) const
+	{
+		const int32 Bit = CellXY.X + CellXY.Y * NumCells.X;
+		return (OccupancyBits[Bit >> 5] & (1u << (Bit & 31))) != 0;
+	}
+
+	/*
+	* Visits the occupied cells of a row in [InStartX, InEndX), stopping early if InFunc returns false.
+	* Each row is a contiguous run of occupancy bits, so empty cells are skipped a word at a time.
 	*/
-	bool Remove(T* InObject)
+	template<class FuncType>
+	FORCEINLINE bool ForEachOccupiedRowCell(const int32 InRow, const int32 InStartX, const int32 InEndX, FuncType& InFunc) const
 	{
-		checkf(InObject != nullptr, TEXT("Invalid Component!"));
+		if (InEndX <= InStartX) { return true; }
 
-		if (InObject->GetSparseGridData().IsClear())
-		{
-			UE_LOG(LogST_SparseGrid, Verbose, TEXT("'%s' is not registered!"), *GetNameSafe(InObject));
-			return true;
-		}
-		else
+		const int32 RowBit = InRow * NumCells.X;
+		const int32 FirstBit = RowBit + InStartX;
+		const int32 LastBit = RowBit + InEndX - 1;
+
+		for (int32 WordIdx = FirstBit >> 5; WordIdx <= LastBit >> 5; WordIdx++)
 		{
-			// If the object has valid data, we can only unregister if it belongs to this grid.
-			const int32 GridIndex = InObject->GetSparseGridData().GetGridIndex();
-			if (!RegisteredObjects.IsValidIndex(GridIndex) || RegisteredObjects[GridIndex] != InObject)
-			{
-				UE_LOG(LogST_SparseGrid, Warning, TEXT("'%s' is registered in another grid - cannot unregister!"), *GetNameSafe(InObject));
-				return false;
-			}
-			else
-			{
-				UE_LOG(LogST_SparseGrid, VeryVerbose, TEXT("Unregistering Sparse Grid Object: '%s'"), *GetNameSafe(InObject));
+			uint32 Bits = OccupancyBits[WordIdx];
+			if (WordIdx == FirstBit >> 5) { Bits &= ~0u << (FirstBit & 31); }
+			if (WordIdx == LastBit >> 5) { Bits &= ~0u >> (31 - (LastBit & 31)); }
 
-				// Remove from Cell
-				const int32 CurrentCell = InObject->GetSparseGridData().GetCellIndex();
-				InObject->AccessSparseGridData().SetCellIndex(INDEX_NONE);
-				GridCells[CurrentCell].Remove(InObject);
+			while (Bits)
+			{
+				const int32 RIdx = (WordIdx << 5) + (int32)FMath::CountTrailingZeros(Bits) - RowBit;
+				Bits &= Bits - 1;
 
-				// We want to move the component the end of the registered array
-				// Need to swap if it's not already there
-				if (InObject != RegisteredObjects.Last())
+				if (!InFunc(FST_GridRef2D(RIdx, InRow)))
 				{
-					const int32 SwapIndex = InObject->GetSparseGridData().GetGridIndex();
-					RegisteredObjects.Swap(SwapIndex, RegisteredObjects.Num() - 1);
+					return false;
+				}
+			}
+		}
 
-					// Update the component we swapped with so it has the correct index
-					T* LastObject = RegisteredObjects[SwapIndex];
-					checkSlow(LastObject != nullptr);
+		return true;
+	}
 
-					LastObject->AccessSparseGridData().SetGridIndex(SwapIndex);
-				}
+	FORCEINLINE void UpdateOccupancy(const int32 InCellIndex)
+	{
+		// Only the first add and the last remove change the bit
+		const int32 NumCellObjects = GridCells[InCellIndex].GetObjects().Num();
+		if (NumCellObjects > 1) { return; }
 
-				// Check Last Element is the InObject
-				checkfSlow(RegisteredObjects.Last() == InObject, TEXT("Old Object Not Last In Array!"));
+		const FST_GridRef2D CellXY = GetCellXY(InCellIndex);
+		const int32 Bit = CellXY.X + CellXY.Y * NumCells.X;
+		if (NumCellObjects > 0)
+		{
+			OccupancyBits[Bit >> 5] |= 1u << (Bit & 31);
+		}
+		else
+		{
+			OccupancyBits[Bit >> 5] &= ~(1u << (Bit & 31));
+		}
+	}
 
-				// Remove and clear cell index
-				RegisteredObjects.RemoveAt(RegisteredObjects.Num() - 1, 1, false);
-				InObject->AccessSparseGridData().SetGridIndex(INDEX_NONE);
+	void RebuildOccupancy()
+	{
+		FMemory::Memzero(OccupancyBits.GetData(), OccupancyBits.Num() * sizeof(uint32));
 
-				// Shrink if required
-				const int32 Slack = RegisteredObjects.GetSlack();
-				if (Slack >= 0 && Slack % RegisterAllocSize == 0 && Slack > RegisterAllocSize * RegisterAllocShrinkMultiplier)
+		for (int32 XIdx = 0; XIdx < NumCells.X; XIdx++)
+		{
+			for (int32 YIdx = 0; YIdx < NumCells.Y; YIdx++)
+			{
+				if (GridCells[GetCellIndex(FST_GridRef2D(XIdx, YIdx))].GetObjects().Num() > 0)
 				{
-					RegisteredObjects.Shrink();
+					const int32 Bit = XIdx + YIdx * NumCells.X;
+					OccupancyBits[Bit >> 5] |= 1u << (Bit & 31);
 				}
-
-				return true;
 			}
 		}
 	}
 
+	/////////////////////
+	///// Snapshots /////
+	/////////////////////
+public:
+	typedef TST_SparseGridSnapshot<T> FSnapshot;
+	typedef TSharedPtr<const FSnapshot, ESPMode::ThreadSafe> FSnapshotPtr;
+
 	/*
-	* Initializes the sparse grid with all grid objects in it's assigned world
-	* If bAllowChildClasses is true, then we will also register child classes of the given type (must be true for blueprint classes)
-	* This function is expensive, do not use it often.
+	* Enables publishing an immutable snapshot at the end of each Update().
+	* Disabling releases the grid's references to any published snapshots.
 	*/
-	void Init(const bool bAllowChildClasses = false)
+	void SetPublishSnapshots(const bool bInPublishSnapshots)
 	{
-		const UWorld* lWorld = GetGridWorld();
-		check(lWorld);
+		bPublishSnapshots = bInPublishSnapshots;
 
-		for (TObjectIterator<T> SGIterator; SGIterator; ++SGIterator)
+		if (!bPublishSnapshots)
 		{
-			T* ObjectItr = *SGIterator;
-			if (!ObjectItr || ObjectItr->GetWorld() != lWorld || ObjectItr->IsPendingKillOrUnreachable())
-			{
-				continue;
-			}
+			FScopeLock SnapshotScopeLock(&SnapshotLock);
+			SnapshotSlots[0].Reset();
+			SnapshotSlots[1].Reset();
+			LatestSnapshotSlot = INDEX_NONE;
+		}
+	}
 
-			if (!bAllowChildClasses && ExactCast<T>(ObjectItr) == nullptr)
-			{
-				UE_LOG(LogST_SparseGrid, VeryVerbose, TEXT("Skipped Sparse Grid registration of '%s' because it does not match exact class '%s'"), *GetNameSafe(ObjectItr), *GetNameSafe(T::StaticClass()));
-				continue;
-			}
+	FORCEINLINE bool IsPublishingSnapshots() const { return bPublishSnapshots; }
 
-			if (ObjectItr->GetSparseGridData().IsClear())
-			{
-				Add(ObjectItr);
-			}
-			else
+	/*
+	* Acquires the most recently published snapshot.
+	* Safe to call from any thread. Returns an invalid pointer if no snapshot has been published.
+	*/
+	FSnapshotPtr AcquireSnapshot() const
+	{
+		FScopeLock SnapshotScopeLock(&SnapshotLock);
+		return LatestSnapshotSlot != INDEX_NONE ? FSnapshotPtr(SnapshotSlots[LatestSnapshotSlot]) : FSnapshotPtr();
+	}
+
+	/*
+	* Acquires the snapshot published on a given engine frame, if it is still held by the grid.
+	* The grid keeps the two most recent snapshots. Safe to call from any thread.
+	*/
+	FSnapshotPtr AcquireSnapshot(const uint64 InFrameNumber) const
+	{
+		FScopeLock SnapshotScopeLock(&SnapshotLock);
+		for (const TSharedPtr<FSnapshot, ESPMode::ThreadSafe>& SlotItr : SnapshotSlots)
+		{
+			if (SlotItr.IsValid() && SlotItr->GetFrameNumber() == InFrameNumber)
 			{
-				UE_LOG(LogST_SparseGrid, VeryVerbose, TEXT("Skipped Sparse Grid registration of '%s' because it is already registered."), *GetNameSafe(ObjectItr));
+				return FSnapshotPtr(SlotItr);
 			}
 		}
+
+		return FSnapshotPtr();
 	}
 
+private:
 	/*
-	* Unregisters all registered objects.
-	* Does not destroy cells but clears all allocations.
+	* Builds a snapshot into the slot not holding the latest one.
+	* If a reader still holds that slot, it keeps its copy and a new buffer is allocated instead.
 	*/
-	void Empty()
+	void PublishSnapshot()
 	{
-		for (TST_SparseGridCell<T>& CellItr : GridCells)
+		const int32 WriteSlot = LatestSnapshotSlot == 0 ? 1 : 0;
+
+		TSharedPtr<FSnapshot, ESPMode::ThreadSafe> Snapshot;
 		{
-			CellItr.CellObjects.Empty();
+			FScopeLock SnapshotScopeLock(&SnapshotLock);
+			Snapshot = MoveTemp(SnapshotSlots[WriteSlot]);
 		}
 
-		for (T* ObjectItr : RegisteredObjects)
+		if (!Snapshot.IsValid() || !Snapshot.IsUnique())
 		{
-			checkSlow(ObjectItr != nullptr);
-
-			ObjectItr->AccessSparseGridData().SetGridIndex(INDEX_NONE);
-			ObjectItr->AccessSparseGridData().SetCellIndex(INDEX_NONE);
-			ObjectItr->AccessSparseGridData().SetCellSubIndex(INDEX_NONE);
+			Snapshot = MakeShared<FSnapshot, ESPMode::ThreadSafe>();
 		}
 
-		RegisteredObjects.Empty();
+		Snapshot->Build(*this, GFrameCounter);
+
+		FScopeLock SnapshotScopeLock(&SnapshotLock);
+		SnapshotSlots[WriteSlot] = MoveTemp(Snapshot);
+		LatestSnapshotSlot = WriteSlot;
 	}
 
+	bool bPublishSnapshots;
+	int32 LatestSnapshotSlot;
+	TSharedPtr<FSnapshot, ESPMode::ThreadSafe> SnapshotSlots[2];
+	mutable FCriticalSection SnapshotLock;
+
 	//////////////////////
 	///// Properties /////
 	//////////////////////
@@ -471,11 +2381,36 @@ private:
 	*/
 	TWeakObjectPtr<const UWorld> GridWorld;
 
+	/*
+	* Guards all grid state. Exclusive during the write phase, shared during queries.
+	*/
+	mutable FRWLock GridLock;
+
+	/*
+	* Number of completed updates.
+	*/
+	FThreadSafeCounter UpdateEpoch;
+
 	/*
 	* All objects registered in the grid.
 	*/
 	TArray<T*> RegisteredObjects;
 
+	/*
+	* Registered objects visited every frame by incremental updates.
+	*/
+	TArray<T*> DynamicObjects;
+
+	/*
+	* Static objects marked dirty since the last update.
+	*/
+	TArray<T*> DirtyObjects;
+
+	/*
+	* Backing store for the contents of all cells.
+	*/
+	TST_SparseGridCellStorage<T> CellStorage;
+
 	/*
 	* All cells in the grid.
 	*/
@@ -511,6 +2446,17 @@ private:
 	int32 RegisterAllocSize;
 	int32 RegisterAllocShrinkMultiplier;
 
+	// Cell Layout, MortonBits is the number of index bits per axis when Morton ordered
+	EST_SparseGridCellLayout CellLayout;
+	FST_GridRef2D MortonBits;
+
+	// Update Mode
+	EST_SparseGridUpdateMode UpdateMode;
+	int32 ParallelUpdateBatchSize;
+	bool bIncrementalUpdate;
+	float AutoRebuildThreshold;
+	float LastMovedFraction;
+
 	/////////////////////
 	///// Utilities /////
 	/////////////////////
@@ -526,19 +2472,37 @@ public:
 
 	FORCEINLINE int32 GetCellIndex(const FST_GridRef2D& CellXY) const
 	{
+		if (CellLayout == EST_SparseGridCellLayout::Morton)
+		{
+			return MortonEncode(CellXY);
+		}
+
 		return CellXY.Y + CellXY.X * NumCells.Y;
-		// CellXY.X + CellXY.Y * NumCells.X;
 	}
 
+	/*
+	* True if the index refers to a cell inside the grid.
+	* Padding cells of the Morton layout are not valid cells.
+	*/
 	FORCEINLINE bool IsValidCellIndex(const int32 CellID) const
 	{
-		return GridCells.IsValidIndex(CellID);
+		if (!GridCells.IsValidIndex(CellID)) { return false; }
+		if (CellLayout == EST_SparseGridCellLayout::RowMajor) { return true; }
+
+		const FST_GridRef2D CellXY = MortonDecode(CellID);
+		return CellXY.X < NumCells.X && CellXY.Y < NumCells.Y;
 	}
 
 	FORCEINLINE FST_GridRef2D GetCellXY(const int32 CellID) const
 	{
-		return IsValidCellIndex(CellID) ? FST_GridRef2D(CellID & NumCells.Y, CellID / NumCells.Y) : FST_GridRef2D(INDEX_NONE);
-		//return IsValidCellIndex(CellID) ? FST_GridRef2D(CellID & NumCells.X, CellID / NumCells.X) : FST_GridRef2D(INDEX_NONE);
+		if (!IsValidCellIndex(CellID)) { return FST_GridRef2D(INDEX_NONE); }
+
+		if (CellLayout == EST_SparseGridCellLayout::Morton)
+		{
+			return MortonDecode(CellID);
+		}
+
+		return FST_GridRef2D(CellID / NumCells.Y, CellID % NumCells.Y);
 	}
 
 	FORCEINLINE FVector2D GetCellCenter(const FST_GridRef2D& CellXY) const
@@ -562,19 +2526,48 @@ public:
 	}
 
 	/*
-	* Get Populations of each cell in cell order
+	* Get Populations of each cell in row-major cell order, regardless of cell layout
 	* Useful for drawing heat-map data
 	*/
 	void GetGridCellPopulations(TArray<uint32>& OutPopulation) const
 	{
 		SCOPE_CYCLE_COUNTER(STAT_QueryPopulation);
 
-		const int32 NumGridCells = GridCells.Num();
-		OutPopulation.Reset(NumGridCells);
+		SPARSE_GRID_CHECK_NOT_VISITING();
+		FRWScopeLock ReadLock(GridLock, SLT_ReadOnly);
+
+		OutPopulation.Reset(NumCells.X * NumCells.Y);
+
+		for (int32 XIdx = 0; XIdx < NumCells.X; XIdx++)
+		{
+			for (int32 YIdx = 0; YIdx < NumCells.Y; YIdx++)
+			{
+				OutPopulation.Add(static_cast<uint32>(GridCells[GetCellIndex(FST_GridRef2D(XIdx, YIdx))].GetObjects().Num()));
+			}
+		}
+	}
 
-		for (int32 CellId = 0; CellId < NumGridCells; CellId++)
+	/*
+	* Get Populations over a window of cells, which may differ in size from the grid's own cells.
+	* Each window cell reports the population of the grid cell under its centre, so grids of different cell sizes can share one heat-map.
+	*/
+	void GetGridCellPopulations(TArray<uint32>& OutPopulation, const FST_GridRef2D& InWindowOrigin, const FST_GridRef2D& InWindowNumCells, const int32 InWindowCellSize) const
+	{
+		SCOPE_CYCLE_COUNTER(STAT_QueryPopulation);
+
+		SPARSE_GRID_CHECK_NOT_VISITING();
+		FRWScopeLock ReadLock(GridLock, SLT_ReadOnly);
+
+		OutPopulation.Reset(InWindowNumCells.X * InWindowNumCells.Y);
+
+		const FVector2D WindowStart = InWindowOrigin.ToVector() + ((float)InWindowCellSize * 0.5f);
+		for (int32 XIdx = 0; XIdx < InWindowNumCells.X; XIdx++)
 		{
-			OutPopulation.Add(static_cast<uint32>(GridCells[CellId].GetObjects().Num()));
+			for (int32 YIdx = 0; YIdx < InWindowNumCells.Y; YIdx++)
+			{
+				const int32 CellIndex = WorldToCell(WindowStart + FVector2D(XIdx * InWindowCellSize, YIdx * InWindowCellSize));
+				OutPopulation.Add(static_cast<uint32>(GridCells[CellIndex].GetObjects().Num()));
+			}
 		}
 	}
 
@@ -630,51 +2623,190 @@ public:
 		return ReturnVal;
 	}
 
-	FORCEINLINE float GetCellBoundsRadius() const
+#if ENABLE_GRID_BOUNDS
+	FORCEINLINE const FST_SparseGridBounds& GetObjectBounds() const
+	{
+		return ObjectBounds;
+	}
+#endif
+
+	/*
+	* Cull cells based on distance from a point to the cell bounds
+	* Currently used for sphere tests.
+	*/
+	FORCEINLINE bool CullCell_Range(const FST_GridRef2D& CellXY, const FVector2D& InPoint, const float Distance) const
+	{
+		return GetPointBoxDistSqrd(InPoint, GetCellCullBounds(CellXY)) > FMath::Square(Distance);
+	}
+
+	/*
+	* Cull cells based on distance from a line segment to the cell bounds
+	* Currently used for Capsule and Cone tests
+	*/
+	bool CullCell_Line(const FST_GridRef2D& CellXY, const FVector2D& InLineStart, const FVector2D& InLineEnd, const float DistFromLine) const
 	{
-		return CellBoundsRadius;
+		return GetSegmentBoxDistSqrd(InLineStart, InLineEnd, GetCellCullBounds(CellXY)) > FMath::Square(DistFromLine);
 	}
 
-	FORCEINLINE float GetCellBoundsRadiusSquared() const
+	/*
+	* Range of columns in a row that a circle overlaps, as [X, Y)
+	* Exact for the row, so cells inside the span don't need culling.
+	*/
+	FST_GridRef2D GetRowSpan_Range(const int32 InRow, const FVector2D& InPoint, const float Distance) const
 	{
-		return CellBoundsRadiusSqrd;
+		float RowMinY, RowMaxY;
+		GetRowCullBand(InRow, RowMinY, RowMaxY);
+
+		const float DY = FMath::Max3(RowMinY - InPoint.Y, 0.f, InPoint.Y - RowMaxY);
+		if (DY > Distance) { return FST_GridRef2D(0, 0); }
+
+		const float HalfWidth = FMath::Sqrt(FMath::Square(Distance) - FMath::Square(DY));
+		return GetColumnSpan(InPoint.X - HalfWidth, InPoint.X + HalfWidth);
 	}
 
-#if ENABLE_GRID_BOUNDS
-	FORCEINLINE const FST_SparseGridBounds& GetObjectBounds() const
+	/*
+	* Range of columns in a row that a capsule (line segment and radius) may overlap, as [X, Y)
+	* Conservative, cells inside the span should still be culled with CullCell_Line().
+	*/
+	FST_GridRef2D GetRowSpan_Line(const int32 InRow, const FVector2D& InLineStart, const FVector2D& InLineEnd, const float DistFromLine) const
 	{
-		return ObjectBounds;
+		float RowMinY, RowMaxY;
+		GetRowCullBand(InRow, RowMinY, RowMaxY);
+
+		// Clip the segment to the rows it can reach from
+		const float ReachMinY = RowMinY - DistFromLine;
+		const float ReachMaxY = RowMaxY + DistFromLine;
+		const FVector2D Dir = InLineEnd - InLineStart;
+
+		float TMin = 0.f;
+		float TMax = 1.f;
+		if (FMath::Abs(Dir.Y) < KINDA_SMALL_NUMBER)
+		{
+			if (InLineStart.Y < ReachMinY || InLineStart.Y > ReachMaxY) { return FST_GridRef2D(0, 0); }
+		}
+		else
+		{
+			const float T1 = (ReachMinY - InLineStart.Y) / Dir.Y;
+			const float T2 = (ReachMaxY - InLineStart.Y) / Dir.Y;
+			TMin = FMath::Max(TMin, FMath::Min(T1, T2));
+			TMax = FMath::Min(TMax, FMath::Max(T1, T2));
+			if (TMin > TMax) { return FST_GridRef2D(0, 0); }
+		}
+
+		const float X1 = InLineStart.X + Dir.X * TMin;
+		const float X2 = InLineStart.X + Dir.X * TMax;
+		return GetColumnSpan(FMath::Min(X1, X2) - DistFromLine, FMath::Max(X1, X2) + DistFromLine);
+	}
+
+private:
+	/*
+	* World-space XY bounds of everything a cell can hold.
+	* Objects outside the grid are clamped to boundary cells, so boundary cells are extended outwards to the object bounds.
+	*/
+	FORCEINLINE FBox2D GetCellCullBounds(const FST_GridRef2D& CellXY) const
+	{
+		FBox2D CellBounds = FBox2D(GetCellMin(CellXY).ToVector(), GetCellMax(CellXY).ToVector());
+		if (IsBoundaryCell(CellXY))
+		{
+			const FBox2D OuterBounds = GetOuterCullBounds();
+			if (CellXY.X == 0) { CellBounds.Min.X = FMath::Min(CellBounds.Min.X, OuterBounds.Min.X); }
+			if (CellXY.Y == 0) { CellBounds.Min.Y = FMath::Min(CellBounds.Min.Y, OuterBounds.Min.Y); }
+			if (CellXY.X == NumCells.X - 1) { CellBounds.Max.X = FMath::Max(CellBounds.Max.X, OuterBounds.Max.X); }
+			if (CellXY.Y == NumCells.Y - 1) { CellBounds.Max.Y = FMath::Max(CellBounds.Max.Y, OuterBounds.Max.Y); }
+		}
+
+		return CellBounds;
+	}
+
+	/*
+	* World-space Y range of everything a row of cells can hold, extended outwards for the boundary rows.
+	*/
+	FORCEINLINE void GetRowCullBand(const int32 InRow, float& OutMinY, float& OutMaxY) const
+	{
+		OutMinY = GridOrigin.Y + InRow * CellSize;
+		OutMaxY = OutMinY + CellSize;
+
+		if (InRow == 0 || InRow == NumCells.Y - 1)
+		{
+			const FBox2D OuterBounds = GetOuterCullBounds();
+			if (InRow == 0) { OutMinY = FMath::Min(OutMinY, OuterBounds.Min.Y); }
+			if (InRow == NumCells.Y - 1) { OutMaxY = FMath::Max(OutMaxY, OuterBounds.Max.Y); }
+		}
 	}
+
+	/*
+	* Bounds that any object clamped into a boundary cell lies within.
+	*/
+	FORCEINLINE FBox2D GetOuterCullBounds() const
+	{
+#if ENABLE_GRID_BOUNDS
+		if (!ObjectBounds.IsClear())
+		{
+			return FBox2D(FVector2D(ObjectBounds.GetMin()), FVector2D(ObjectBounds.GetMax()));
+		}
+
+		return FBox2D(GridOrigin.ToVector(), GetGridMax().ToVector());
+#else
+		return FBox2D(FVector2D(-HALF_WORLD_MAX, -HALF_WORLD_MAX), FVector2D(HALF_WORLD_MAX, HALF_WORLD_MAX));
 #endif
+	}
 
 	/*
-	* Cull cells based on distance to point (cell bounds radius)
-	* Currently used for sphere tests.
+	* Columns covering the world-space X range, as [X, Y). Objects beyond the grid edge live in the boundary columns.
 	*/
-	FORCEINLINE bool CullCell_Range(const FST_GridRef2D& CellXY, const FVector2D& InPoint, const double Distance) const
+	FORCEINLINE FST_GridRef2D GetColumnSpan(const float InMinX, const float InMaxX) const
 	{
-		// Skip cell culling for boundary cells, since it won't work if we're outside the grid
-		if (IsBoundaryCell(CellXY)) { return false; }
+		return FST_GridRef2D(
+			FMath::Clamp(FMath::FloorToInt((InMinX - GridOrigin.X) / CellSize), 0, NumCells.X - 1),
+			FMath::Clamp(FMath::FloorToInt((InMaxX - GridOrigin.X) / CellSize), 0, NumCells.X - 1) + 1);
+	}
 
-		return FVector2D(GetCellCenter(CellXY) - InPoint).SizeSquared() > FMath::Square(Distance + CellBoundsRadius);
+	static FORCEINLINE float GetPointBoxDistSqrd(const FVector2D& InPoint, const FBox2D& InBox)
+	{
+		const float DX = FMath::Max3(InBox.Min.X - InPoint.X, 0.f, InPoint.X - InBox.Max.X);
+		const float DY = FMath::Max3(InBox.Min.Y - InPoint.Y, 0.f, InPoint.Y - InBox.Max.Y);
+		return DX * DX + DY * DY;
 	}
 
 	/*
-	* Cull cells based on distance from line (Cell Bounds Radius)
-	* Currently used for Capsule and Cone tests
+	* Squared distance between a line segment and a box, zero if they overlap.
+	* When apart, the closest points are a segment end-point and the box, or a box corner and the segment.
 	*/
-	bool CullCell_Line(const FST_GridRef2D& CellXY, const FVector2D& InLineStart, const FVector2D& InLineEnd, const float DistFromLine) const
+	static float GetSegmentBoxDistSqrd(const FVector2D& InStart, const FVector2D& InEnd, const FBox2D& InBox)
 	{
-		// Skip cell culling for boundary cells, since it won't work if we're outside the grid
-		if (IsBoundaryCell(CellXY)) { return false; }
+		// Slab test
+		const FVector2D Dir = InEnd - InStart;
+
+		float TMin = 0.f;
+		float TMax = 1.f;
+		bool bOverlaps = true;
+		for (int32 Axis = 0; Axis < 2 && bOverlaps; Axis++)
+		{
+			if (FMath::Abs(Dir[Axis]) < KINDA_SMALL_NUMBER)
+			{
+				bOverlaps = InStart[Axis] >= InBox.Min[Axis] && InStart[Axis] <= InBox.Max[Axis];
+			}
+			else
+			{
+				const float T1 = (InBox.Min[Axis] - InStart[Axis]) / Dir[Axis];
+				const float T2 = (InBox.Max[Axis] - InStart[Axis]) / Dir[Axis];
+				TMin = FMath::Max(TMin, FMath::Min(T1, T2));
+				TMax = FMath::Min(TMax, FMath::Max(T1, T2));
+				bOverlaps = TMin <= TMax;
+			}
+		}
 
-		const FVector2D CellCenter = GetCellCenter(CellXY);
-		const FVector2D ClosestPoint = FMath::ClosestPointOnSegment2D(CellCenter, InLineStart, InLineEnd);
+		if (bOverlaps) { return 0.f; }
 
-		const double DSqrd = FVector2D(CellCenter - ClosestPoint).SizeSquared();
-		const double XSqrd = FMath::Square(DistFromLine + CellBoundsRadius);
+		float DistSqrd = FMath::Min(GetPointBoxDistSqrd(InStart, InBox), GetPointBoxDistSqrd(InEnd, InBox));
+
+		const FVector2D Corners[4] = { InBox.Min, FVector2D(InBox.Min.X, InBox.Max.Y), InBox.Max, FVector2D(InBox.Max.X, InBox.Min.Y) };
+		for (const FVector2D& Corner : Corners)
+		{
+			DistSqrd = FMath::Min(DistSqrd, FVector2D(Corner - FMath::ClosestPointOnSegment2D(Corner, InStart, InEnd)).SizeSquared());
+		}
 
-		return DSqrd > XSqrd;
+		return DistSqrd;
 	}
 
 private:
@@ -686,80 +2818,65 @@ private:
 	FST_SparseGridBounds ObjectBounds;
 #endif
 
-	double CellBoundsRadius;
-	double CellBoundsRadiusSqrd;
-
 	//////////////////////////
 	///// Search Queries /////
 	//////////////////////////
 public:
+	// Unfiltered, fixed-capacity and visitor overloads, see TST_SparseGridQueries
+	using Super::QueryGrid_Sphere;
+	using Super::QueryGrid_Capsule;
+	using Super::QueryGrid_Box;
+	using Super::QueryGrid_RotatedBox;
+	using Super::QueryGrid_Cone;
+
 	/*
 	* Sphere Query
 	* Returns all registered objects within a sphere.
 	*/
-	template<class AllocatorType>
-	void QueryGrid_Sphere(TArray<T*, AllocatorType>& OutObjects, const FVector& InWorldLocation, const float InSphereRadius, const bool bDrawDebug = false) const
+	template<class OutputType>
+	void QueryGrid_Sphere(OutputType& OutObjects, const FVector& InWorldLocation, const float InSphereRadius, const FST_SparseGridCategoryFilter& InFilter, bool bDrawDebug = false) const
 	{
 		SCOPE_CYCLE_COUNTER(STAT_QueryGrid_Sphere)
 
+		SPARSE_GRID_CHECK_NOT_VISITING();
+		FRWScopeLock ReadLock(GridLock, SLT_ReadOnly);
+
 #if SPARSE_GRID_DEBUG
-		GATHER_DEBUG_PARAMETERS;
-
-		if (bDrawDebug) { DrawDebugSphere(DebugWorld, InWorldLocation, InSphereRadius, 12, FColor::Green, false, DrawQueryTime, 0, DrawQueryThickness); }
-#endif
-
-#if ENABLE_GRID_BOUNDS
-		// Skip if the search bounds do not overlap object bounds, as we won't return anything anyway
-		if (ObjectBounds.CanFastReject(InWorldLocation, FVector(InSphereRadius, InSphereRadius, InSphereRadius))) { return; }
-#endif
-
-		const FVector2D TileBoundsXY = FVector2D(InWorldLocation.X, InWorldLocation.Y);
-		const FST_SparseGridCellTile Tile = GetSearchTile(TileBoundsXY, FVector2D(InSphereRadius, InSphereRadius));
-
-		const FST_GridRef2D GridMax = GetGridMax();
-		const FVector2D XYClamped = FVector2D(FMath::Clamp<float>(TileBoundsXY.X, GridOrigin.X, GridMax.X), FMath::Clamp<float>(TileBoundsXY.Y, GridOrigin.Y, GridMax.Y));
-
-		const double DistSqrd = InSphereRadius * InSphereRadius;
-		for (int32 CIdx = Tile.Start.Y; CIdx < Tile.End.Y; CIdx++)
-		{
-			for (int32 RIdx = Tile.Start.X; RIdx < Tile.End.X; RIdx++)
-			{
-				const FST_GridRef2D CellXY = FST_GridRef2D(RIdx, CIdx);
-				const int32 CellIndex = GetCellIndex(CellXY);
-				if (GridCells[CellIndex].GetObjects().Num() && !CullCell_Range(CellXY, XYClamped, InSphereRadius))
-				{
-#if SPARSE_GRID_DEBUG
-					if (bDrawDebug) { DrawDebugCell(CellXY, FLinearColor(0.f, 1.f, 0.f, 0.25f)); }
-#endif
-					for (T* ObjectItr : GridCells[CellIndex].GetObjects())
-					{
-						const FVector ObjectLoc = ObjectItr->GetSparseGridLocation();
-						if (FVector::DistSquared(InWorldLocation, ObjectLoc) <= DistSqrd)
-						{
-#if SPARSE_GRID_DEBUG
-							if (bDrawDebug) { DrawDebugLine(DebugWorld, InWorldLocation, ObjectLoc, FColor::Green, false, DrawQueryTime, 0, DrawQueryThickness); }
+		// Debug drawing is game thread only
+		bDrawDebug &= IsInGameThread();
+		GATHER_DEBUG_PARAMETERS;
+
+		if (bDrawDebug) { DrawDebugSphere(DebugWorld, InWorldLocation, InSphereRadius, 12, FColor::Green, false, DrawQueryTime, 0, DrawQueryThickness); }
 #endif
 
-							OutObjects.Add(ObjectItr);
-						}
-					}
-				}
-#if SPARSE_GRID_DEBUG
-				else if (bDrawDebug) { DrawDebugCell(CellXY, FLinearColor(1.f, 0.f, 0.f, 0.25f), DrawQueryTime); }
+#if ENABLE_GRID_BOUNDS
+		// Skip if the search bounds do not overlap object bounds, as we won't return anything anyway
+		if (ObjectBounds.CanFastReject(InWorldLocation, FVector(InSphereRadius, InSphereRadius, InSphereRadius))) { return; }
 #endif
-			}
-		}
+
+		const FVector2D TileBoundsXY = FVector2D(InWorldLocation.X, InWorldLocation.Y);
+		const FST_SparseGridCellTile Tile = GetSearchTile(TileBoundsXY, FVector2D(InSphereRadius, InSphereRadius));
+
+		// Row spans are exact for circles, no further cell culling required
+		const FST_SparseGridKernel_Sphere Kernel = FST_SparseGridKernel_Sphere(InWorldLocation, InSphereRadius);
+		QueryCells(OutObjects, Tile, Kernel, InFilter, InWorldLocation, FVector(InSphereRadius),
+			[this, &TileBoundsXY, InSphereRadius](const int32 InRow) { return GetRowSpan_Range(InRow, TileBoundsXY, InSphereRadius); },
+			[](const FST_GridRef2D& CellXY) { return false; },
+			InWorldLocation, bDrawDebug);
 	}
 
 	/*
 	* Capsule Query
 	* Returns all registered objects within an orientated capsule.
 	*/
-	template<class AllocatorType>
-	void QueryGrid_Capsule(TArray<T*, AllocatorType>& OutObjects, const FVector& InWorldLocation, const FVector& InUpAxis, float InCapsuleRadius, float InCapsuleHalfHeight, const bool bDrawDebug = false) const
+	template<class OutputType>
+	void QueryGrid_Capsule(OutputType& OutObjects, const FVector& InWorldLocation, const FVector& InUpAxis, float InCapsuleRadius, float InCapsuleHalfHeight, const FST_SparseGridCategoryFilter& InFilter, bool bDrawDebug = false) const
 	{
 		SCOPE_CYCLE_COUNTER(STAT_QueryGrid_Capsule)
 
+		SPARSE_GRID_CHECK_NOT_VISITING();
+		FRWScopeLock ReadLock(GridLock, SLT_ReadOnly);
+
 		// Clamp to sensible values
 		InCapsuleHalfHeight = FMath::Max3(0.f, InCapsuleHalfHeight, InCapsuleRadius);
 		InCapsuleRadius = FMath::Clamp(InCapsuleRadius, 0.f, InCapsuleHalfHeight);
@@ -769,6 +2886,8 @@ public:
 		const FBoxSphereBounds AABB = FBoxSphereBounds(FBox(-CapsuleBoundsExtents, CapsuleBoundsExtents)).TransformBy(CapsuleToWorld);
 
 #if SPARSE_GRID_DEBUG
+		// Debug drawing is game thread only
+		bDrawDebug &= IsInGameThread();
 		GATHER_DEBUG_PARAMETERS;
 
 		if (bDrawDebug)
@@ -789,59 +2908,32 @@ public:
 		const FVector Dir = InUpAxis * (InCapsuleHalfHeight - InCapsuleRadius);
 		const FVector CapsuleStart = InWorldLocation + Dir;
 		const FVector CapsuleEnd = InWorldLocation - Dir;
-		const float RSq = InCapsuleRadius * InCapsuleRadius;
-
-		const FST_GridRef2D GridMax = GetGridMax();
-		const FVector2D XYClamped = FVector2D(FMath::Clamp<float>(TileBoundsXY.X, GridOrigin.X, GridMax.X), FMath::Clamp<float>(TileBoundsXY.Y, GridOrigin.Y, GridMax.Y));
-		const FVector2D CullStart = XYClamped + FVector2D(Dir);
-		const FVector2D CullEnd = XYClamped - FVector2D(Dir);
-
-		for (int32 CIdx = Tile.Start.Y; CIdx < Tile.End.Y; CIdx++)
-		{
-			for (int32 RIdx = Tile.Start.X; RIdx < Tile.End.X; RIdx++)
-			{
-				const FST_GridRef2D CellXY = FST_GridRef2D(RIdx, CIdx);
-				const int32 CellIndex = GetCellIndex(CellXY);
-				if (GridCells[CellIndex].GetObjects().Num() && !CullCell_Line(CellXY, CullStart, CullEnd, InCapsuleRadius))
-				{
-#if SPARSE_GRID_DEBUG
-					if (bDrawDebug) { DrawDebugCell(CellXY, FLinearColor(0.f, 1.f, 0.f, 0.25f), DrawQueryTime); }
-#endif
 
-					for (T* ObjectItr : GridCells[CellIndex].GetObjects())
-					{
-						const FVector Location = ObjectItr->GetSparseGridLocation();
-						const FVector ClosestPoint = FMath::ClosestPointOnSegment(Location, CapsuleStart, CapsuleEnd);
+		const FVector2D CullStart = FVector2D(CapsuleStart);
+		const FVector2D CullEnd = FVector2D(CapsuleEnd);
 
-						if (FVector::DistSquared(ClosestPoint, Location) <= RSq)
-						{
-#if SPARSE_GRID_DEBUG
-							if (bDrawDebug) { DrawDebugLine(DebugWorld, ClosestPoint, Location, FLinearColor(0.f, 1.f, 0.f, 0.25f).ToFColor(false), false, DrawQueryThickness, 0, DrawQueryThickness); }
-#endif
-							OutObjects.Add(ObjectItr);
-						}
-					}
-				}
-#if SPARSE_GRID_DEBUG
-				else if (bDrawDebug) { DrawDebugCell(CellXY, FLinearColor(1.f, 0.f, 0.f, 0.25f), DrawQueryTime); }
-#endif
-			}
-		}
+		const FST_SparseGridKernel_Capsule Kernel = FST_SparseGridKernel_Capsule(CapsuleStart, CapsuleEnd, InCapsuleRadius);
+		QueryCells(OutObjects, Tile, Kernel, InFilter, InWorldLocation, AABB.BoxExtent,
+			[this, &CullStart, &CullEnd, InCapsuleRadius](const int32 InRow) { return GetRowSpan_Line(InRow, CullStart, CullEnd, InCapsuleRadius); },
+			[this, &CullStart, &CullEnd, InCapsuleRadius](const FST_GridRef2D& CellXY) { return CullCell_Line(CellXY, CullStart, CullEnd, InCapsuleRadius); },
+			InWorldLocation, bDrawDebug);
 	}
 
 	/*
 	* Box Query
 	* Returns all registered objects in an axis-aligned bounding box.
 	*/
-	template<class AllocatorType>
-	void QueryGrid_Box(TArray<T*, AllocatorType>& OutObjects, const FVector& InWorldLocation, const FVector& InBoxExtents, const bool bDrawDebug = false) const
+	template<class OutputType>
+	void QueryGrid_Box(OutputType& OutObjects, const FVector& InWorldLocation, const FVector& InBoxExtents, const FST_SparseGridCategoryFilter& InFilter, bool bDrawDebug = false) const
 	{
 		SCOPE_CYCLE_COUNTER(STAT_QueryGrid_Box)
 
-		const FVector ExtentMin = InWorldLocation - InBoxExtents;
-		const FVector ExtentMax = InWorldLocation + InBoxExtents;
+		SPARSE_GRID_CHECK_NOT_VISITING();
+		FRWScopeLock ReadLock(GridLock, SLT_ReadOnly);
 
 #if SPARSE_GRID_DEBUG
+		// Debug drawing is game thread only
+		bDrawDebug &= IsInGameThread();
 		GATHER_DEBUG_PARAMETERS;
 
 		if (bDrawDebug) { DrawDebugBox(DebugWorld, InWorldLocation, InBoxExtents, FColor::Blue, false, DrawQueryTime, 0, DrawQueryThickness); }
@@ -851,54 +2943,38 @@ public:
 		if (ObjectBounds.CanFastReject(InWorldLocation, InBoxExtents)) { return; }
 #endif
 
-		// Axis-Aligned Tiles
-		const FVector2D TileBoundsXY = FVector2D(InBoxExtents.X, InBoxExtents.Y);
+		// Axis-Aligned Tiles, no cell culling required
 		const FST_SparseGridCellTile Tile = GetSearchTile(FVector2D(InWorldLocation), FVector2D(InBoxExtents));
 
-		// Iterate All Tiles
-		for (int32 CIdx = Tile.Start.Y; CIdx < Tile.End.Y; CIdx++)
-		{
-			for (int32 RIdx = Tile.Start.X; RIdx < Tile.End.X; RIdx++)
-			{
-#if SPARSE_GRID_DEBUG
-				if (bDrawDebug) { DrawDebugCell(FST_GridRef2D(RIdx, CIdx), FLinearColor(0.f, 1.f, 0.f, 0.25f), DrawQueryTime); }
-#endif
-				const int32 CellIndex = GetCellIndex(FST_GridRef2D(RIdx, CIdx));
-				for (T* ObjectItr : GridCells[CellIndex].GetObjects())
-				{
-					const FVector Location = ObjectItr->GetSparseGridLocation();
-					if (Location.X >= ExtentMin.X && Location.X <= ExtentMax.X && Location.Y >= ExtentMin.Y && Location.Y <= ExtentMax.Y && Location.Z >= ExtentMin.Z && Location.Z <= ExtentMax.Z)
-					{
-#if SPARSE_GRID_DEBUG
-						if (bDrawDebug) { DrawDebugLine(DebugWorld, InWorldLocation, ObjectItr->GetSparseGridLocation(), FColor::Green, false, DrawQueryTime, 0, DrawQueryThickness); }
-#endif
-						OutObjects.Add(ObjectItr);
-					}
-				}
-			}
-		}
+		const FST_SparseGridKernel_Box Kernel = FST_SparseGridKernel_Box(InWorldLocation, InBoxExtents);
+		QueryCells(OutObjects, Tile, Kernel, InFilter, InWorldLocation, InBoxExtents, [](const FST_GridRef2D& CellXY) { return false; }, InWorldLocation, bDrawDebug);
 	}
 
 	/*
 	* Rotated Box Query
 	* Finds all registered objects within an non-axis-aligned bounding box.
 	*/
-	template<class AllocatorType>
-	void QueryGrid_RotatedBox(TArray<T*, AllocatorType>& OutObjects, const FVector& InWorldLocation, const FQuat& InBoxRotation, const FVector& InBoxExtents, const bool bDrawDebug = false) const
+	template<class OutputType>
+	void QueryGrid_RotatedBox(OutputType& OutObjects, const FVector& InWorldLocation, const FQuat& InBoxRotation, const FVector& InBoxExtents, const FST_SparseGridCategoryFilter& InFilter, bool bDrawDebug = false) const
 	{
 		// Skip transforms if rotation is zero
 		if (InBoxRotation.IsIdentity())
 		{
-			QueryGrid_Box(OutObjects, InWorldLocation, InBoxExtents, bDrawDebug);
+			QueryGrid_Box(OutObjects, InWorldLocation, InBoxExtents, InFilter, bDrawDebug);
 			return;
 		}
 
 		SCOPE_CYCLE_COUNTER(STAT_QueryGrid_RotatedBox)
 
+		SPARSE_GRID_CHECK_NOT_VISITING();
+		FRWScopeLock ReadLock(GridLock, SLT_ReadOnly);
+
 		const FMatrix BoxToWorld = FTransform(InBoxRotation, InWorldLocation).ToMatrixNoScale();
 		const FBoxSphereBounds AABB = FBoxSphereBounds(FBox(-InBoxExtents, InBoxExtents)).TransformBy(BoxToWorld);
 
 #if SPARSE_GRID_DEBUG
+		// Debug drawing is game thread only
+		bDrawDebug &= IsInGameThread();
 		GATHER_DEBUG_PARAMETERS;
 
 		if (bDrawDebug)
@@ -915,41 +2991,22 @@ public:
 		const FVector2D TileBoundsXY = FVector2D(InWorldLocation.X, InWorldLocation.Y);
 		const FST_SparseGridCellTile Tile = GetSearchTile(TileBoundsXY, FVector2D(AABB.BoxExtent.X, AABB.BoxExtent.Y));
 
-		for (int32 CIdx = Tile.Start.Y; CIdx < Tile.End.Y; CIdx++)
-		{
-			for (int32 RIdx = Tile.Start.X; RIdx < Tile.End.X; RIdx++)
-			{
-#if SPARSE_GRID_DEBUG
-				if (bDrawDebug) { DrawDebugCell(FST_GridRef2D(RIdx, CIdx), FLinearColor(0.f, 1.f, 0.f, 0.25f), DrawQueryTime); }
-#endif
-				const int32 CellIndex = GetCellIndex(FST_GridRef2D(RIdx, CIdx));
-				for (T* ObjectItr : GridCells[CellIndex].GetObjects())
-				{
-					const FVector TransformedLocation = BoxToWorld.InverseTransformPosition(ObjectItr->GetSparseGridLocation());
-					if (TransformedLocation.X >= -InBoxExtents.X && TransformedLocation.X <= InBoxExtents.X
-						&& TransformedLocation.Y >= -InBoxExtents.Y && TransformedLocation.Y <= InBoxExtents.Y
-						&& TransformedLocation.Z >= -InBoxExtents.Z && TransformedLocation.Z <= InBoxExtents.Z)
-					{
-#if SPARSE_GRID_DEBUG
-						if (bDrawDebug) { DrawDebugLine(DebugWorld, InWorldLocation, ObjectItr->GetSparseGridLocation(), FColor::Green, false, DrawQueryTime, 0, DrawQueryThickness); }
-#endif
-
-						OutObjects.Add(ObjectItr);
-					}
-				}
-			}
-		}
+		const FST_SparseGridKernel_RotatedBox Kernel = FST_SparseGridKernel_RotatedBox(InWorldLocation, InBoxRotation, InBoxExtents);
+		QueryCells(OutObjects, Tile, Kernel, InFilter, InWorldLocation, AABB.BoxExtent, [](const FST_GridRef2D& CellXY) { return false; }, InWorldLocation, bDrawDebug);
 	}
 
 	/*
 	* Cone Query
 	* Finds all registered objects within a cone.
 	*/
-	template<class AllocatorType>
-	void QueryGrid_Cone(TArray<T*, AllocatorType>& OutObjects, const FVector& InWorldLocation, const float InConeLength, const float InConeHalfAngleRadians, const FVector& InAxis, const bool bDrawDebug = false) const
+	template<class OutputType>
+	void QueryGrid_Cone(OutputType& OutObjects, const FVector& InWorldLocation, const float InConeLength, const float InConeHalfAngleRadians, const FVector& InAxis, const FST_SparseGridCategoryFilter& InFilter, bool bDrawDebug = false) const
 	{
 		SCOPE_CYCLE_COUNTER(STAT_QueryGrid_Cone)
 
+		SPARSE_GRID_CHECK_NOT_VISITING();
+		FRWScopeLock ReadLock(GridLock, SLT_ReadOnly);
+
 		const FVector ConeCenter = InWorldLocation + InAxis * (InConeLength * 0.5f);
 		const float ConeEndRadius = InConeLength * FMath::Tan(InConeHalfAngleRadians);
 		const FMatrix ConeToWorld = FTransform(FRotationMatrix::MakeFromX(InAxis).ToQuat(), ConeCenter).ToMatrixNoScale();
@@ -957,6 +3014,8 @@ public:
 		const FBoxSphereBounds AABB = FBoxSphereBounds(FBox(-ConeBoundsExtents, ConeBoundsExtents)).TransformBy(ConeToWorld);
 
 #if SPARSE_GRID_DEBUG
+		// Debug drawing is game thread only
+		bDrawDebug &= IsInGameThread();
 		GATHER_DEBUG_PARAMETERS;
 
 		if (bDrawDebug)
@@ -968,60 +3027,430 @@ public:
 #endif
 
 #if ENABLE_GRID_BOUNDS
-		if (ObjectBounds.CanFastReject(InWorldLocation, AABB.BoxExtent)) { return; }
+		if (ObjectBounds.CanFastReject(AABB.Origin, AABB.BoxExtent)) { return; }
 #endif
 
 		const FVector2D TileBoundsXY = FVector2D(ConeCenter.X, ConeCenter.Y);
 		const FST_SparseGridCellTile Tile = GetSearchTile(TileBoundsXY, FVector2D(AABB.BoxExtent.X, AABB.BoxExtent.Y));
 
-		const FST_GridRef2D GridMax = GetGridMax();
-		const FVector2D ConeEnd2D = FVector2D(InAxis) * InConeLength;
-		const FVector2D LineStart2D = FVector2D(FMath::Clamp<float>(InWorldLocation.X, GridOrigin.X, GridMax.X), FMath::Clamp<float>(InWorldLocation.Y, GridOrigin.Y, GridMax.Y));
-		const FVector2D LineEnd2D = FVector2D(FMath::Clamp<float>(ConeEnd2D.X, GridOrigin.X, GridMax.X), FMath::Clamp<float>(ConeEnd2D.Y, GridOrigin.Y, GridMax.Y));
+		// The cone fits inside a capsule along its axis with the radius of its end
+		const FVector2D LineStart2D = FVector2D(InWorldLocation);
+		const FVector2D LineEnd2D = FVector2D(InWorldLocation + InAxis * InConeLength);
+
+		const FST_SparseGridKernel_Cone Kernel = FST_SparseGridKernel_Cone(InWorldLocation, InAxis, InConeLength, InConeHalfAngleRadians);
+		QueryCells(OutObjects, Tile, Kernel, InFilter, AABB.Origin, AABB.BoxExtent,
+			[this, &LineStart2D, &LineEnd2D, ConeEndRadius](const int32 InRow) { return GetRowSpan_Line(InRow, LineStart2D, LineEnd2D, ConeEndRadius); },
+			[this, &LineStart2D, &LineEnd2D, ConeEndRadius](const FST_GridRef2D& CellXY) { return CullCell_Line(CellXY, LineStart2D, LineEnd2D, ConeEndRadius); },
+			InWorldLocation, bDrawDebug);
+	}
+
+	/*
+	* Batched Sphere Query
+	* Runs many sphere queries at once. Query/cell overlaps are sorted by cell, so all the queries overlapping a cell
+	* are tested back-to-back while its positions are still in cache. Each (cell, query) pair still runs its own kernel pass.
+	* Scratch buffers come from the calling thread's FMemStack, so only the results are heap allocated.
+	*
+	* Results are returned in a flattened buffer, see TST_SparseGridBatchResults.
+	*/
+	void QueryGrid_SphereBatch(TST_SparseGridBatchResults<T>& OutResults, const TArrayView<const FST_SparseGridSphereQuery> InQueries) const
+	{
+		SCOPE_CYCLE_COUNTER(STAT_QueryGrid_SphereBatch)
 
-		const float ConeLenSq = InConeLength * InConeLength;
-		const float ConeCos = FMath::Cos(InConeHalfAngleRadians);
+		SPARSE_GRID_CHECK_NOT_VISITING();
+		FRWScopeLock ReadLock(GridLock, SLT_ReadOnly);
 
-		for (int32 CIdx = Tile.Start.Y; CIdx < Tile.End.Y; CIdx++)
+		const int32 NumQueries = InQueries.Num();
+		OutResults.Reset();
+		OutResults.Offsets.SetNumZeroed(NumQueries + 1, false);
+
+		FMemMark Mark(FMemStack::Get());
+
+		// Gather all (Cell, Query) overlaps, packed so that sorting groups them by cell
+		TArray<uint64, TMemStackAllocator<>> CellQueryPairs;
+
+		for (int32 QueryIdx = 0; QueryIdx < NumQueries; QueryIdx++)
 		{
-			for (int32 RIdx = Tile.Start.X; RIdx < Tile.End.X; RIdx++)
+			const FST_SparseGridSphereQuery& Query = InQueries[QueryIdx];
+
+#if ENABLE_GRID_BOUNDS
+			if (ObjectBounds.CanFastReject(Query.Location, FVector(Query.Radius))) { continue; }
+#endif
+
+			const FVector2D TileBoundsXY = FVector2D(Query.Location.X, Query.Location.Y);
+			const FST_SparseGridCellTile Tile = GetSearchTile(TileBoundsXY, FVector2D(Query.Radius, Query.Radius));
+
+			ForEachTileCell(Tile, [&](const int32 InRow) { return GetRowSpan_Range(InRow, TileBoundsXY, Query.Radius); }, [&](const FST_GridRef2D& CellXY)
 			{
-				const FST_GridRef2D CellXY = FST_GridRef2D(RIdx, CIdx);
 				const int32 CellIndex = GetCellIndex(CellXY);
-				if (GridCells[CellIndex].GetObjects().Num() && !CullCell_Line(CellXY, LineStart2D, LineEnd2D, ConeEndRadius))
+				if (!GridCells[CellIndex].GetBounds().CanFastReject(Query.Location, FVector(Query.Radius)))
+				{
+					CellQueryPairs.Add((static_cast<uint64>(CellIndex) << 32) | static_cast<uint32>(QueryIdx));
+				}
+
+				return true;
+			});
+		}
+
+		CellQueryPairs.Sort();
+
+		// Test the queries overlapping each cell back-to-back
+		TArray<int32, TMemStackAllocator<>> HitQueries;
+		TArray<T*, TMemStackAllocator<>> HitObjects;
+		TArray<uint32, TInlineAllocator<8>> HitMask;
+
+		for (const uint64 PairItr : CellQueryPairs)
+		{
+			const int32 CellIndex = static_cast<int32>(PairItr >> 32);
+			const int32 QueryIdx = static_cast<int32>(PairItr & 0xFFFFFFFF);
+
+			const TST_SparseGridCell<T>& Cell = GridCells[CellIndex];
+			const int32 NumCellObjects = Cell.GetObjects().Num();
+			const FST_SparseGridKernel_Sphere Kernel = FST_SparseGridKernel_Sphere(InQueries[QueryIdx].Location, InQueries[QueryIdx].Radius);
+
+			HitMask.SetNumUninitialized(FST_SparseGridKernels::GetNumMaskWords(NumCellObjects), false);
+
+			int32 NumHits = FST_SparseGridKernels::BuildHitMask(Kernel, Cell.GetPositionsX(), Cell.GetPositionsY(), Cell.GetPositionsZ(), NumCellObjects, HitMask.GetData());
+			NumHits = FST_SparseGridKernels::FilterHitMask(InQueries[QueryIdx].Filter, Cell.GetCategories(), HitMask.GetData(), HitMask.Num(), NumHits);
+			if (NumHits > 0)
+			{
+				FST_SparseGridKernels::AppendMasked(HitObjects, Cell.GetObjects().GetData(), HitMask.GetData(), HitMask.Num(), NumHits);
+				const int32 FirstHit = HitQueries.AddUninitialized(NumHits);
+				for (int32 HitIdx = 0; HitIdx < NumHits; HitIdx++)
 				{
+					HitQueries[FirstHit + HitIdx] = QueryIdx;
+				}
+
+				OutResults.Offsets[QueryIdx + 1] += NumHits;
+			}
+		}
+
+		// Counting-sort hits by query into the flattened result buffer
+		for (int32 QueryIdx = 0; QueryIdx < NumQueries; QueryIdx++)
+		{
+			OutResults.Offsets[QueryIdx + 1] += OutResults.Offsets[QueryIdx];
+		}
+
+		OutResults.Objects.SetNumUninitialized(HitObjects.Num(), false);
+
+		TArray<int32, TMemStackAllocator<>> WriteOffsets;
+		WriteOffsets.Append(OutResults.Offsets.GetData(), NumQueries);
+		for (int32 HitIdx = 0; HitIdx < HitObjects.Num(); HitIdx++)
+		{
+			OutResults.Objects[WriteOffsets[HitQueries[HitIdx]]++] = HitObjects[HitIdx];
+		}
+	}
+
+	/*
+	* K-Nearest Query
+	* Finds up to InK registered objects closest to a location, sorted nearest first.
+	*
+	* Occupied cells are searched ring by ring outwards from the query cell. The search stops once the closest possible object
+	* in the next ring is further away than the current Kth nearest, or than InMaxDistance (if positive).
+	* Objects failing InFilter are skipped before their distance is tested.
+	* InPredicate is only called for objects that would make it into the current K nearest.
+	*/
+	template<class PredicateType, class AllocatorType>
+	void QueryGrid_KNearest(TArray<T*, AllocatorType>& OutObjects, const FVector& InWorldLocation, const int32 InK, const float InMaxDistance, const FST_SparseGridCategoryFilter& InFilter, const PredicateType& InPredicate, bool bDrawDebug = false) const
+	{
+		SCOPE_CYCLE_COUNTER(STAT_QueryGrid_Nearest)
+
+		if (InK <= 0) { return; }
+
+		SPARSE_GRID_CHECK_NOT_VISITING();
+		FRWScopeLock ReadLock(GridLock, SLT_ReadOnly);
+
 #if SPARSE_GRID_DEBUG
-					if (bDrawDebug) { DrawDebugCell(CellXY, FLinearColor(0.f, 1.f, 0.f, 0.25f), DrawQueryTime); }
+		// Debug drawing is game thread only
+		bDrawDebug &= IsInGameThread();
+		GATHER_DEBUG_PARAMETERS;
+
+		if (bDrawDebug && InMaxDistance > 0.f) { DrawDebugSphere(DebugWorld, InWorldLocation, InMaxDistance, 12, FColor::Green, false, DrawQueryTime, 0, DrawQueryThickness); }
 #endif
-					for (T* ObjectItr : GridCells[CellIndex].GetObjects())
-					{
-						const FVector OwnerLocation = ObjectItr->GetSparseGridLocation();
-						const float DSqrd = FVector::DistSquared(InWorldLocation, OwnerLocation);
-						if (DSqrd > ConeLenSq)
-						{
-							continue;
-						}
 
-						const float Dot = FVector::DotProduct(InAxis, FVector(OwnerLocation - InWorldLocation).GetSafeNormal());
-						if (Dot < ConeCos)
-						{
-							continue;
-						}
+		const float MaxDistSqrd = InMaxDistance > 0.f ? FMath::Square(InMaxDistance) : MAX_flt;
+
+		// Max-Heap of the best candidates so far, furthest at the top
+		TArray<FST_SparseGridNearest, TInlineAllocator<16>> Nearest;
+		const auto FurthestFirst = [](const FST_SparseGridNearest& A, const FST_SparseGridNearest& B) { return A.DistSqrd > B.DistSqrd; };
+
+		const FVector2D LocalXY = FVector2D(InWorldLocation) - GridOrigin.ToVector();
+		const FST_GridRef2D QueryCell = FST_GridRef2D(
+			FMath::Clamp(FMath::FloorToInt(LocalXY.X / CellSize), 0, NumCells.X - 1),
+			FMath::Clamp(FMath::FloorToInt(LocalXY.Y / CellSize), 0, NumCells.Y - 1));
+
+		const int32 MaxRing = FMath::Max(FMath::Max(QueryCell.X, NumCells.X - 1 - QueryCell.X), FMath::Max(QueryCell.Y, NumCells.Y - 1 - QueryCell.Y));
+		for (int32 Ring = 0; Ring <= MaxRing; Ring++)
+		{
+			// Closest any object in this ring (or beyond) can be
+			const float RingDistSqrd = FMath::Square(GetRingMinDistance(LocalXY, QueryCell, Ring));
+			if (RingDistSqrd > MaxDistSqrd || (Nearest.Num() == InK && RingDistSqrd > Nearest.HeapTop().DistSqrd))
+			{
+				break;
+			}
+
+			ForEachRingCell(QueryCell, Ring, [&](const FST_GridRef2D& CellXY)
+			{
+				const TST_SparseGridCell<T>& Cell = GridCells[GetCellIndex(CellXY)];
+				const int32 NumCellObjects = Cell.GetObjects().Num();
 
 #if SPARSE_GRID_DEBUG
-						if (bDrawDebug) { DrawDebugLine(DebugWorld, InWorldLocation, OwnerLocation, FColor::Green, false, DrawQueryTime, 0, DrawQueryThickness); }
+				if (bDrawDebug) { DrawDebugCell(CellXY, FLinearColor(0.f, 1.f, 0.f, 0.25f), DrawQueryTime); }
 #endif
 
-						OutObjects.Add(ObjectItr);
+				const float* PosX = Cell.GetPositionsX();
+				const float* PosY = Cell.GetPositionsY();
+				const float* PosZ = Cell.GetPositionsZ();
+				const uint32* Categories = Cell.GetCategories();
+				for (int32 SubIdx = 0; SubIdx < NumCellObjects; SubIdx++)
+				{
+					if (!InFilter.Passes(Categories[SubIdx]))
+					{
+						continue;
+					}
+
+					const float DistSqrd = FMath::Square(PosX[SubIdx] - InWorldLocation.X) + FMath::Square(PosY[SubIdx] - InWorldLocation.Y) + FMath::Square(PosZ[SubIdx] - InWorldLocation.Z);
+					if (DistSqrd > MaxDistSqrd || (Nearest.Num() == InK && DistSqrd >= Nearest.HeapTop().DistSqrd))
+					{
+						continue;
+					}
+
+					T* Object = Cell.GetObjects()[SubIdx];
+					if (!InPredicate(Object))
+					{
+						continue;
+					}
+
+					if (Nearest.Num() == InK)
+					{
+						Nearest.HeapPopDiscard(FurthestFirst, false);
 					}
+
+					Nearest.HeapPush(FST_SparseGridNearest(DistSqrd, Object), FurthestFirst);
 				}
+			});
+		}
+
+		// Nearest First
+		Nearest.Sort([](const FST_SparseGridNearest& A, const FST_SparseGridNearest& B) { return A.DistSqrd < B.DistSqrd; });
+
+		OutObjects.Reserve(OutObjects.Num() + Nearest.Num());
+		for (const FST_SparseGridNearest& NearestItr : Nearest)
+		{
 #if SPARSE_GRID_DEBUG
-				else if (bDrawDebug) { DrawDebugCell(CellXY, FLinearColor(1.f, 0.f, 0.f, 0.25f), DrawQueryTime); }
+			if (bDrawDebug)
+			{
+				// Cached position, queries never call back into objects
+				const FST_SparseGridData& GridData = NearestItr.Object->GetSparseGridData();
+				const TST_SparseGridCell<T>& Cell = GridCells[GridData.GetCellIndex()];
+				const int32 SubIdx = GridData.GetCellSubIndex();
+				DrawDebugLine(DebugWorld, InWorldLocation, FVector(Cell.GetPositionsX()[SubIdx], Cell.GetPositionsY()[SubIdx], Cell.GetPositionsZ()[SubIdx]), FColor::Green, false, DrawQueryTime, 0, DrawQueryThickness);
+			}
 #endif
+
+			OutObjects.Add(NearestItr.Object);
+		}
+	}
+
+	template<class PredicateType, class AllocatorType>
+	FORCEINLINE void QueryGrid_KNearest(TArray<T*, AllocatorType>& OutObjects, const FVector& InWorldLocation, const int32 InK, const float InMaxDistance, const PredicateType& InPredicate, bool bDrawDebug = false) const
+	{
+		QueryGrid_KNearest(OutObjects, InWorldLocation, InK, InMaxDistance, FST_SparseGridCategoryFilter(), InPredicate, bDrawDebug);
+	}
+
+	template<class AllocatorType>
+	FORCEINLINE void QueryGrid_KNearest(TArray<T*, AllocatorType>& OutObjects, const FVector& InWorldLocation, const int32 InK, const float InMaxDistance, const FST_SparseGridCategoryFilter& InFilter, bool bDrawDebug = false) const
+	{
+		QueryGrid_KNearest(OutObjects, InWorldLocation, InK, InMaxDistance, InFilter, [](const T* Object) { return true; }, bDrawDebug);
+	}
+
+	template<class AllocatorType>
+	void QueryGrid_KNearest(TArray<T*, AllocatorType>& OutObjects, const FVector& InWorldLocation, const int32 InK, const float InMaxDistance = 0.f, bool bDrawDebug = false) const
+	{
+		QueryGrid_KNearest(OutObjects, InWorldLocation, InK, InMaxDistance, FST_SparseGridCategoryFilter(), [](const T* Object) { return true; }, bDrawDebug);
+	}
+
+	/*
+	* Nearest Query
+	* Returns the registered object closest to a location, or nullptr if there is none (within InMaxDistance, if positive).
+	*/
+	template<class PredicateType>
+	T* QueryGrid_Nearest(const FVector& InWorldLocation, const float InMaxDistance, const FST_SparseGridCategoryFilter& InFilter, const PredicateType& InPredicate, bool bDrawDebug = false) const
+	{
+		TArray<T*, TInlineAllocator<1>> Result;
+		QueryGrid_KNearest(Result, InWorldLocation, 1, InMaxDistance, InFilter, InPredicate, bDrawDebug);
+
+		return Result.Num() ? Result[0] : nullptr;
+	}
+
+	template<class PredicateType>
+	FORCEINLINE T* QueryGrid_Nearest(const FVector& InWorldLocation, const float InMaxDistance, const PredicateType& InPredicate, bool bDrawDebug = false) const
+	{
+		return QueryGrid_Nearest(InWorldLocation, InMaxDistance, FST_SparseGridCategoryFilter(), InPredicate, bDrawDebug);
+	}
+
+	FORCEINLINE T* QueryGrid_Nearest(const FVector& InWorldLocation, const float InMaxDistance, const FST_SparseGridCategoryFilter& InFilter, bool bDrawDebug = false) const
+	{
+		return QueryGrid_Nearest(InWorldLocation, InMaxDistance, InFilter, [](const T* Object) { return true; }, bDrawDebug);
+	}
+
+	T* QueryGrid_Nearest(const FVector& InWorldLocation, const float InMaxDistance = 0.f, bool bDrawDebug = false) const
+	{
+		return QueryGrid_Nearest(InWorldLocation, InMaxDistance, FST_SparseGridCategoryFilter(), [](const T* Object) { return true; }, bDrawDebug);
+	}
+
+private:
+	struct FST_SparseGridNearest
+	{
+		FST_SparseGridNearest(const float InDistSqrd, T* InObject)
+			: DistSqrd(InDistSqrd)
+			, Object(InObject)
+		{}
+
+		float DistSqrd;
+		T* Object;
+	};
+
+	/*
+	* Visits every occupied in-grid cell exactly InRing cells away from InCenter (Chebyshev distance).
+	* Empty cells are skipped using the occupancy bitmap.
+	*/
+	template<class FuncType>
+	FORCEINLINE void ForEachRingCell(const FST_GridRef2D& InCenter, const int32 InRing, FuncType&& InFunc) const
+	{
+		if (InRing == 0)
+		{
+			if (IsCellOccupied(InCenter))
+			{
+				InFunc(InCenter);
+			}
+
+			return;
+		}
+
+		const int32 MinX = FMath::Max(InCenter.X - InRing, 0);
+		const int32 MaxX = FMath::Min(InCenter.X + InRing, NumCells.X - 1);
+		const int32 MinY = FMath::Max(InCenter.Y - InRing + 1, 0);
+		const int32 MaxY = FMath::Min(InCenter.Y + InRing - 1, NumCells.Y - 1);
+
+		// Top and Bottom Rows
+		const auto VisitCell = [&InFunc](const FST_GridRef2D& CellXY) { InFunc(CellXY); return true; };
+		for (const int32 RowY : { InCenter.Y - InRing, InCenter.Y + InRing })
+		{
+			if (RowY >= 0 && RowY < NumCells.Y)
+			{
+				ForEachOccupiedRowCell(RowY, MinX, MaxX + 1, VisitCell);
+			}
+		}
+
+		// Left and Right Columns
+		for (const int32 ColumnX : { InCenter.X - InRing, InCenter.X + InRing })
+		{
+			if (ColumnX >= 0 && ColumnX < NumCells.X)
+			{
+				for (int32 CIdx = MinY; CIdx <= MaxY; CIdx++)
+				{
+					if (IsCellOccupied(FST_GridRef2D(ColumnX, CIdx)))
+					{
+						InFunc(FST_GridRef2D(ColumnX, CIdx));
+					}
+				}
 			}
 		}
 	}
 
+	/*
+	* Lower bound on the 2D distance from a grid-local point to any object in ring InRing or beyond.
+	* This is the distance to the nearest edge of the square covered by the inner rings. Edges on the grid boundary
+	* are ignored, since objects outside the grid are clamped into the boundary cells of the inner rings.
+	*/
+	float GetRingMinDistance(const FVector2D& InLocalXY, const FST_GridRef2D& InCenter, const int32 InRing) const
+	{
+		if (InRing == 0)
+		{
+			return 0.f;
+		}
+
+		float MinDist = MAX_flt;
+
+		const int32 InnerMinX = InCenter.X - (InRing - 1);
+		const int32 InnerMaxX = InCenter.X + InRing;
+		const int32 InnerMinY = InCenter.Y - (InRing - 1);
+		const int32 InnerMaxY = InCenter.Y + InRing;
+
+		if (InnerMinX > 0) { MinDist = FMath::Min(MinDist, InLocalXY.X - InnerMinX * CellSize); }
+		if (InnerMaxX < NumCells.X) { MinDist = FMath::Min(MinDist, InnerMaxX * CellSize - InLocalXY.X); }
+		if (InnerMinY > 0) { MinDist = FMath::Min(MinDist, InLocalXY.Y - InnerMinY * CellSize); }
+		if (InnerMaxY < NumCells.Y) { MinDist = FMath::Min(MinDist, InnerMaxY * CellSize - InLocalXY.Y); }
+
+		return FMath::Max(MinDist, 0.f);
+	}
+
+private:
+	/*
+	* Shared narrow-phase for all shape queries.
+	* Walks each cell in the tile, skips empty cells, cells whose bounds miss the query bounds (BoundsOrigin +/- BoundsExtent) and culled cells, runs the kernel over the packed positions of the cell,
+	* drops hits failing the category filter and compacts the resulting hit mask into OutObjects.
+	*/
+	template<class KernelType, class CullFuncType, class OutputType>
+	FORCEINLINE void QueryCells(OutputType& OutObjects, const FST_SparseGridCellTile& Tile, const KernelType& Kernel, const FST_SparseGridCategoryFilter& Filter, const FVector& BoundsOrigin, const FVector& BoundsExtent, const CullFuncType& CullCellFunc, const FVector& DebugOrigin, const bool bDrawDebug) const
+	{
+		QueryCells(OutObjects, Tile, Kernel, Filter, BoundsOrigin, BoundsExtent, [](const int32 InRow) { return FST_GridRef2D(0, MAX_int32); }, CullCellFunc, DebugOrigin, bDrawDebug);
+	}
+
+	/*
+	* As above, only walking the span of each tile row returned by RowSpanFunc, see ForEachTileCell().
+	*/
+	template<class KernelType, class RowSpanFuncType, class CullFuncType, class OutputType>
+	void QueryCells(OutputType& OutObjects, const FST_SparseGridCellTile& Tile, const KernelType& Kernel, const FST_SparseGridCategoryFilter& Filter, const FVector& BoundsOrigin, const FVector& BoundsExtent, const RowSpanFuncType& RowSpanFunc, const CullFuncType& CullCellFunc, const FVector& DebugOrigin, const bool bDrawDebug) const
+	{
+#if SPARSE_GRID_DEBUG
+		GATHER_DEBUG_PARAMETERS;
+#endif
+
+		TArray<uint32, TInlineAllocator<8>> HitMask;
+
+		ForEachTileCell(Tile, RowSpanFunc, [&](const FST_GridRef2D& CellXY)
+		{
+			const TST_SparseGridCell<T>& Cell = GridCells[GetCellIndex(CellXY)];
+			const int32 NumCellObjects = Cell.GetObjects().Num();
+			if (NumCellObjects && !Cell.GetBounds().CanFastReject(BoundsOrigin, BoundsExtent) && !CullCellFunc(CellXY))
+			{
+#if SPARSE_GRID_DEBUG
+				if (bDrawDebug) { DrawDebugCell(CellXY, FLinearColor(0.f, 1.f, 0.f, 0.25f), DrawQueryTime); }
+#endif
+				HitMask.SetNumUninitialized(FST_SparseGridKernels::GetNumMaskWords(NumCellObjects), false);
+
+				int32 NumHits = FST_SparseGridKernels::BuildHitMask(Kernel, Cell.GetPositionsX(), Cell.GetPositionsY(), Cell.GetPositionsZ(), NumCellObjects, HitMask.GetData());
+				NumHits = FST_SparseGridKernels::FilterHitMask(Filter, Cell.GetCategories(), HitMask.GetData(), HitMask.Num(), NumHits);
+				if (NumHits > 0)
+				{
+					FST_SparseGridKernels::AppendMasked(OutObjects, Cell.GetObjects().GetData(), HitMask.GetData(), HitMask.Num(), NumHits);
+
+#if SPARSE_GRID_DEBUG
+					if (bDrawDebug)
+					{
+						FST_SparseGridKernels::ForEachSetBit(HitMask.GetData(), HitMask.Num(), [&](const int32 SubIdx)
+						{
+							DrawDebugLine(DebugWorld, DebugOrigin, Cell.GetPosition(SubIdx), FColor::Green, false, DrawQueryTime, 0, DrawQueryThickness);
+						});
+					}
+#endif
+
+					// Visitors can end the query early
+					if (FST_SparseGridKernels::IsStopped(OutObjects))
+					{
+						return false;
+					}
+				}
+			}
+#if SPARSE_GRID_DEBUG
+			else if (bDrawDebug) { DrawDebugCell(CellXY, FLinearColor(1.f, 0.f, 0.f, 0.25f), DrawQueryTime); }
+#endif
+
+			return true;
+		});
+	}
+
 #if WITH_EDITOR
 	//////////////////
 	///// Editor /////
@@ -1033,14 +3462,14 @@ public:
 		OutRegisterAlloc = sizeof(void*) * GetRegisteredObjects().Max();
 		OutRegisterUsed = sizeof(void*) * GetRegisteredObjects().Num();
 
-		OutCellAlloc = 0;
+		// Blocks on the storage free-lists count as allocated but unused
+		OutCellAlloc = CellStorage.GetAllocatedSize() + GridCells.GetAllocatedSize();
 		OutCellUsed = 0;
 		for (const TST_SparseGridCell<T>& Cells : GetGridCells())
 		{
 			uint64 A, U;
 			Cells.GetMemoryInfo(A, U);
 
-			OutCellAlloc += A;
 			OutCellUsed += U;
 		}
 	}
@@ -1124,15 +3553,16 @@ public:
 
 	void DrawDebugCell(const FST_GridRef2D& CellXY, const FLinearColor& Colour, const float DrawTime = -1.f) const
 	{
-		const FVector CellCenter = FVector(GetCellCenter(CellXY), ST_SparseGridCVars::CVarDebugGridHeight.GetValueOnGameThread() + 1.f);
-		FTransform CircleTrans = FTransform(FRotationMatrix::MakeFromX(FVector::UpVector).Rotator(), CellCenter, FVector(1.f));
+		const float DebugHeight = ST_SparseGridCVars::CVarDebugGridHeight.GetValueOnGameThread() + 1.f;
+		const FVector CellCenter = FVector(GetCellCenter(CellXY), DebugHeight);
+
+		// Outline the bounds queries cull the cell against, boundary cells reach out to the object bounds
+		const FBox2D CullBounds = GetCellCullBounds(CellXY);
+		const FVector CullCenter = FVector(CullBounds.GetCenter(), DebugHeight);
+		const FVector CullExtent = FVector(CullBounds.GetExtent(), 0.f);
 
 		DrawDebugSolidPlane(GetGridWorld(), FPlane(CellCenter, FVector::UpVector), CellCenter, FVector2D(CellSize, CellSize) * 0.5f, Colour.ToFColor(true), false, DrawTime);
-		DrawDebugCircle(GetGridWorld(), CircleTrans.ToMatrixWithScale(), CellBoundsRadius, 64, Colour.ToFColor(true), false, DrawTime, 0, 2.f, false);
+		DrawDebugBox(GetGridWorld(), CullCenter, CullExtent, Colour.ToFColor(true), false, DrawTime, 0, 2.f);
 	}
 #endif
-};
-
-#if SPARSE_GRID_DEBUG
-#undef GATHER_DEBUG_PARAMETERS
-#endif
\ No newline at end of file
+};
\ No newline at end of file
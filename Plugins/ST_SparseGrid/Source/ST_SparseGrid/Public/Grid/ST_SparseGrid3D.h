@@ -0,0 +1,684 @@
+// Copyright (C) James Baxter. All Rights Reserved.
+
+#pragma once
+
+#include "ST_SparseGridRegister.h"
+
+//////////////////////////
+///// Sparse Grid 3D /////
+//////////////////////////
+
+/*
+* Voxel Sparse Grid
+* Same object requirements as TST_SparseGrid, but cells are also divided vertically.
+* Shares the TST_SparseGridQueries API with TST_SparseGrid, nearest-neighbour queries are not supported.
+*
+* Stacked floors of a level land in different cells, so queries only scan the floors they overlap rather than every
+* object in the column. Cells have their own vertical size, since vertical gameplay spaces are usually much shallower
+* than they are wide. Objects outside the grid are clamped to boundary cells, including above and below it.
+*
+* Follows the same threading contract as TST_SparseGrid.
+* Incremental updates, parallel updates and snapshots are not supported, every object is re-bucketed serially in Update().
+*/
+template<class T>
+class TST_SparseGrid3D : public TST_SparseGridRegister<T, TST_SparseGrid3D<T>>
+{
+	typedef TST_SparseGridRegister<T, TST_SparseGrid3D<T>> Super;
+	friend class TST_SparseGridRegister<T, TST_SparseGrid3D<T>>;
+
+	using Super::GridWorld;
+	using Super::GridLock;
+	using Super::UpdateEpoch;
+	using Super::RegisteredObjects;
+#if ENABLE_GRID_BOUNDS
+	using Super::ObjectBounds;
+#endif
+
+	//////////////////////
+	////// Lifecycle /////
+	//////////////////////
+public:
+	// Constructor
+	TST_SparseGrid3D(
+			const UWorld* InGridWorld,
+			const FIntVector& InGridOrigin,
+			const FIntVector& InNumCells,
+			const int32 InCellSize,
+			const int32 InCellSizeZ,
+			const int32 InRegisterAllocSize,
+			const int32 InRegisterShrinkMultiplier,
+			const int32 InCellAllocSize,
+			const int32 InCellShrinkMultiplier)
+		: Super(InGridWorld, InRegisterAllocSize, InRegisterShrinkMultiplier)
+		, CellStorage(InCellAllocSize, InCellShrinkMultiplier)
+		, GridOrigin(InGridOrigin)
+		, NumCells(InNumCells)
+		, CellSize(InCellSize)
+		, CellSizeZ(InCellSizeZ)
+	{
+		// Ensure we have *some* cells, to prevent divide by zero errors
+		check(GridWorld.IsValid() && NumCells.X > 0 && NumCells.Y > 0 && NumCells.Z > 0 && CellSize > 0 && CellSizeZ > 0);
+
+		const int32 TotalCells = NumCells.X * NumCells.Y * NumCells.Z;
+		GridCells.Reserve(TotalCells);
+		for (int32 CellIdx = 0; CellIdx < TotalCells; CellIdx++)
+		{
+			GridCells.Add(TST_SparseGridCell<T>(&CellStorage));
+		}
+	}
+
+	// Destructor
+	~TST_SparseGrid3D()
+	{
+		GridWorld = nullptr;
+		Super::Empty();
+		GridCells.Empty();
+	}
+
+	//////////////////////////////
+	///// Grid Functionality /////
+	//////////////////////////////
+public:
+	/*
+	* Updates object placement in the grid.
+	* Typically once per-frame for each grid instance.
+	*/
+	void Update()
+	{
+		SCOPE_CYCLE_COUNTER(STAT_UpdateGrid)
+
+		SPARSE_GRID_CHECK_NOT_VISITING();
+		FRWScopeLock WriteLock(GridLock, SLT_Write);
+
+#if ENABLE_GRID_BOUNDS
+		ObjectBounds = FST_SparseGridBounds();
+#endif
+
+		for (T* ObjectItr : RegisteredObjects)
+		{
+			checkSlow(ObjectItr != nullptr);
+
+			const FVector WorldPosition = ObjectItr->GetSparseGridLocation();
+
+#if ENABLE_GRID_BOUNDS
+			ObjectBounds.Update(WorldPosition);
+#endif
+
+			const int32 DesiredCell = WorldToCell(WorldPosition);
+			const int32 CurrentCell = ObjectItr->GetSparseGridData().GetCellIndex();
+
+			if (DesiredCell != CurrentCell)
+			{
+				GridCells[CurrentCell].Remove(ObjectItr);
+				GridCells[DesiredCell].Add(ObjectItr, WorldPosition);
+				ObjectItr->AccessSparseGridData().SetCellIndex(DesiredCell);
+			}
+			else
+			{
+				GridCells[CurrentCell].SetPosition(ObjectItr->GetSparseGridData().GetCellSubIndex(), WorldPosition);
+				GridCells[CurrentCell].SetCategoryMask(ObjectItr->GetSparseGridData().GetCellSubIndex(), ObjectItr->GetSparseGridData().GetCategoryMask());
+			}
+		}
+
+		UpdateEpoch.Increment();
+	}
+
+private:
+	// TST_SparseGridRegister hooks
+	FORCEINLINE void RegisterInCell(T* InObject, const FVector& InWorldPosition)
+	{
+		const int32 DesiredCell = WorldToCell(InWorldPosition);
+
+		InObject->AccessSparseGridData().SetCellIndex(DesiredCell);
+		GridCells[DesiredCell].Add(InObject, InWorldPosition);
+	}
+
+	FORCEINLINE void UnregisterFromCell(T* InObject)
+	{
+		GridCells[InObject->GetSparseGridData().GetCellIndex()].Remove(InObject);
+		InObject->AccessSparseGridData().SetCellIndex(INDEX_NONE);
+	}
+
+	/*
+	* Does not destroy cells but clears all allocations.
+	*/
+	void EmptyCells()
+	{
+		for (TST_SparseGridCell<T>& CellItr : GridCells)
+		{
+			CellItr.Empty();
+		}
+
+		CellStorage.Empty();
+	}
+
+	//////////////////////
+	///// Properties /////
+	//////////////////////
+public:
+	using Super::GetGridWorld;
+
+	FORCEINLINE FIntVector GetGridOrigin() const { return GridOrigin; }
+	FORCEINLINE FIntVector GetNumCells() const { return NumCells; }
+	FORCEINLINE int32 GetCellSize() const { return CellSize; }
+	FORCEINLINE int32 GetCellSizeZ() const { return CellSizeZ; }
+	FORCEINLINE const TArray<TST_SparseGridCell<T>>& GetGridCells() const { return GridCells; }
+
+	FORCEINLINE FIntVector GetCellSize3D() const
+	{
+		return FIntVector(CellSize, CellSize, CellSizeZ);
+	}
+
+	FORCEINLINE FIntVector GetGridMax() const
+	{
+		return GridOrigin + FIntVector(NumCells.X * CellSize, NumCells.Y * CellSize, NumCells.Z * CellSizeZ);
+	}
+
+private:
+	TST_SparseGridCellStorage<T> CellStorage;
+	TArray<TST_SparseGridCell<T>> GridCells;
+
+	/*
+	* Origin and size of the grid in World-Space
+	* Objects outside of the grid will be clamped to boundary cells.
+	*/
+	FIntVector GridOrigin;
+	FIntVector NumCells;
+
+	/*
+	* Horizontal and vertical world-space size of the cells.
+	*/
+	int32 CellSize;
+	int32 CellSizeZ;
+
+	/////////////////////
+	///// Utilities /////
+	/////////////////////
+public:
+	FORCEINLINE int32 WorldToCell(const FVector& InWorldPosition) const
+	{
+		const FVector Local = InWorldPosition - FVector(GridOrigin);
+
+		return GetCellIndex(FIntVector(
+			FMath::Clamp(FMath::FloorToInt(Local.X / CellSize), 0, NumCells.X - 1),
+			FMath::Clamp(FMath::FloorToInt(Local.Y / CellSize), 0, NumCells.Y - 1),
+			FMath::Clamp(FMath::FloorToInt(Local.Z / CellSizeZ), 0, NumCells.Z - 1)));
+	}
+
+	/*
+	* Cells in a column are contiguous, so the innermost query loop walks vertically through memory.
+	*/
+	FORCEINLINE int32 GetCellIndex(const FIntVector& CellXYZ) const
+	{
+		return CellXYZ.Z + NumCells.Z * (CellXYZ.Y + CellXYZ.X * NumCells.Y);
+	}
+
+	FORCEINLINE FVector GetCellCenter(const FIntVector& CellXYZ) const
+	{
+		return FVector(GridOrigin) + FVector((CellXYZ.X + 0.5f) * CellSize, (CellXYZ.Y + 0.5f) * CellSize, (CellXYZ.Z + 0.5f) * CellSizeZ);
+	}
+
+	FORCEINLINE bool IsBoundaryCell(const FIntVector& CellXYZ) const
+	{
+		return CellXYZ.X == 0 || CellXYZ.Y == 0 || CellXYZ.Z == 0 || CellXYZ.X == NumCells.X - 1 || CellXYZ.Y == NumCells.Y - 1 || CellXYZ.Z == NumCells.Z - 1;
+	}
+
+	/*
+	* Get Populations of each column of cells, in TST_SparseGrid cell order
+	* Useful for drawing heat-map data
+	*/
+	void GetGridCellPopulations(TArray<uint32>& OutPopulation) const
+	{
+		SCOPE_CYCLE_COUNTER(STAT_QueryPopulation);
+
+		SPARSE_GRID_CHECK_NOT_VISITING();
+		FRWScopeLock ReadLock(GridLock, SLT_ReadOnly);
+
+		OutPopulation.Reset(NumCells.X * NumCells.Y);
+		for (int32 CellIdx = 0; CellIdx < GridCells.Num(); CellIdx += NumCells.Z)
+		{
+			uint32 ColumnCount = 0;
+			for (int32 ZIdx = 0; ZIdx < NumCells.Z; ZIdx++)
+			{
+				ColumnCount += static_cast<uint32>(GridCells[CellIdx + ZIdx].GetObjects().Num());
+			}
+
+			OutPopulation.Add(ColumnCount);
+		}
+	}
+
+	//////////////////////////
+	///// Search Culling /////
+	//////////////////////////
+public:
+	/*
+	* Range of cells overlapping a world-space search box.
+	* Searches outside the grid are clamped to the boundary cells, since objects outside the grid are stored there.
+	*/
+	FST_SparseGridCellTile3D GetSearchTile(const FVector& WorldSearchOrigin, const FVector& WorldSearchExtents) const
+	{
+		SCOPE_CYCLE_COUNTER(STAT_QueryTile);
+
+		const FVector SearchMin = WorldSearchOrigin - WorldSearchExtents - FVector(GridOrigin);
+		const FVector SearchMax = WorldSearchOrigin + WorldSearchExtents - FVector(GridOrigin);
+
+		return FST_SparseGridCellTile3D(
+			FIntVector(
+				FMath::Clamp(FMath::FloorToInt(SearchMin.X / CellSize), 0, NumCells.X - 1),
+				FMath::Clamp(FMath::FloorToInt(SearchMin.Y / CellSize), 0, NumCells.Y - 1),
+				FMath::Clamp(FMath::FloorToInt(SearchMin.Z / CellSizeZ), 0, NumCells.Z - 1)),
+			FIntVector(
+				FMath::Clamp(FMath::FloorToInt(SearchMax.X / CellSize) + 1, 1, NumCells.X),
+				FMath::Clamp(FMath::FloorToInt(SearchMax.Y / CellSize) + 1, 1, NumCells.Y),
+				FMath::Clamp(FMath::FloorToInt(SearchMax.Z / CellSizeZ) + 1, 1, NumCells.Z)));
+	}
+
+	/*
+	* Cull cells based on distance from a point to the cell bounds
+	* Currently used for sphere tests.
+	*/
+	FORCEINLINE bool CullCell_Range(const FIntVector& CellXYZ, const FVector& InPoint, const float Distance) const
+	{
+		return GetCellCullBounds(CellXYZ).ComputeSquaredDistanceToPoint(InPoint) > FMath::Square(Distance);
+	}
+
+	/*
+	* Cull cells based on distance from a line segment to the cell bounds
+	* Currently used for Capsule and Cone tests
+	*/
+	FORCEINLINE bool CullCell_Line(const FIntVector& CellXYZ, const FVector& InLineStart, const FVector& InLineEnd, const float DistFromLine) const
+	{
+		return GetSegmentBoxDistSqrd(InLineStart, InLineEnd, GetCellCullBounds(CellXYZ)) > FMath::Square(DistFromLine);
+	}
+
+private:
+	/*
+	* World-space bounds of everything a cell can hold.
+	* Objects outside the grid are clamped to boundary cells, so boundary cells are extended outwards to the object bounds.
+	*/
+	FORCEINLINE FBox GetCellCullBounds(const FIntVector& CellXYZ) const
+	{
+		const FVector CellMin = FVector(GridOrigin) + FVector(CellXYZ.X * CellSize, CellXYZ.Y * CellSize, CellXYZ.Z * CellSizeZ);
+		FBox CellBounds = FBox(CellMin, CellMin + FVector(GetCellSize3D()));
+		if (IsBoundaryCell(CellXYZ))
+		{
+			const FBox OuterBounds = GetOuterCullBounds();
+			for (int32 Axis = 0; Axis < 3; Axis++)
+			{
+				if (CellXYZ[Axis] == 0) { CellBounds.Min[Axis] = FMath::Min(CellBounds.Min[Axis], OuterBounds.Min[Axis]); }
+				if (CellXYZ[Axis] == NumCells[Axis] - 1) { CellBounds.Max[Axis] = FMath::Max(CellBounds.Max[Axis], OuterBounds.Max[Axis]); }
+			}
+		}
+
+		return CellBounds;
+	}
+
+	/*
+	* Bounds that any object clamped into a boundary cell lies within.
+	*/
+	FORCEINLINE FBox GetOuterCullBounds() const
+	{
+#if ENABLE_GRID_BOUNDS
+		if (!ObjectBounds.IsClear())
+		{
+			return FBox(ObjectBounds.GetMin(), ObjectBounds.GetMax());
+		}
+
+		return FBox(FVector(GridOrigin), FVector(GetGridMax()));
+#else
+		return FBox(FVector(-HALF_WORLD_MAX), FVector(HALF_WORLD_MAX));
+#endif
+	}
+
+	/*
+	* Squared distance between a line segment and a box, zero if they overlap.
+	* When apart, the closest points are a segment end-point and a box face, or the segment and a box edge.
+	*/
+	static float GetSegmentBoxDistSqrd(const FVector& InStart, const FVector& InEnd, const FBox& InBox)
+	{
+		// Slab test
+		const FVector Dir = InEnd - InStart;
+
+		float TMin = 0.f;
+		float TMax = 1.f;
+		bool bOverlaps = true;
+		for (int32 Axis = 0; Axis < 3 && bOverlaps; Axis++)
+		{
+			if (FMath::Abs(Dir[Axis]) < KINDA_SMALL_NUMBER)
+			{
+				bOverlaps = InStart[Axis] >= InBox.Min[Axis] && InStart[Axis] <= InBox.Max[Axis];
+			}
+			else
+			{
+				const float T1 = (InBox.Min[Axis] - InStart[Axis]) / Dir[Axis];
+				const float T2 = (InBox.Max[Axis] - InStart[Axis]) / Dir[Axis];
+				TMin = FMath::Max(TMin, FMath::Min(T1, T2));
+				TMax = FMath::Min(TMax, FMath::Max(T1, T2));
+				bOverlaps = TMin <= TMax;
+			}
+		}
+
+		if (bOverlaps) { return 0.f; }
+
+		float DistSqrd = FMath::Min(InBox.ComputeSquaredDistanceToPoint(InStart), InBox.ComputeSquaredDistanceToPoint(InEnd));
+
+		// Corners are indexed by bit, X = 1, Y = 2, Z = 4. Each edge joins a corner to the one across a single axis.
+		const auto GetCorner = [&InBox](const int32 InCorner) { return FVector(InCorner & 1 ? InBox.Max.X : InBox.Min.X, InCorner & 2 ? InBox.Max.Y : InBox.Min.Y, InCorner & 4 ? InBox.Max.Z : InBox.Min.Z); };
+		for (int32 CornerIdx = 0; CornerIdx < 8; CornerIdx++)
+		{
+			for (int32 Axis = 0; Axis < 3; Axis++)
+			{
+				if ((CornerIdx & (1 << Axis)) == 0)
+				{
+					FVector SegmentPoint, EdgePoint;
+					FMath::SegmentDistToSegmentSafe(InStart, InEnd, GetCorner(CornerIdx), GetCorner(CornerIdx | (1 << Axis)), SegmentPoint, EdgePoint);
+					DistSqrd = FMath::Min(DistSqrd, FVector::DistSquared(SegmentPoint, EdgePoint));
+				}
+			}
+		}
+
+		return DistSqrd;
+	}
+
+	//////////////////////////
+	///// Search Queries /////
+	//////////////////////////
+public:
+	// Unfiltered, fixed-capacity and visitor overloads, see TST_SparseGridQueries
+	using Super::QueryGrid_Sphere;
+	using Super::QueryGrid_Capsule;
+	using Super::QueryGrid_Box;
+	using Super::QueryGrid_RotatedBox;
+	using Super::QueryGrid_Cone;
+
+	/*
+	* Sphere Query
+	* Returns all registered objects within a sphere.
+	*/
+	template<class OutputType>
+	void QueryGrid_Sphere(OutputType& OutObjects, const FVector& InWorldLocation, const float InSphereRadius, const FST_SparseGridCategoryFilter& InFilter, bool bDrawDebug = false) const
+	{
+		SCOPE_CYCLE_COUNTER(STAT_QueryGrid_Sphere)
+
+		SPARSE_GRID_CHECK_NOT_VISITING();
+		FRWScopeLock ReadLock(GridLock, SLT_ReadOnly);
+
+#if SPARSE_GRID_DEBUG
+		bDrawDebug &= IsInGameThread();
+		GATHER_DEBUG_PARAMETERS;
+
+		if (bDrawDebug) { DrawDebugSphere(DebugWorld, InWorldLocation, InSphereRadius, 12, FColor::Green, false, DrawQueryTime, 0, DrawQueryThickness); }
+#endif
+
+#if ENABLE_GRID_BOUNDS
+		if (ObjectBounds.CanFastReject(InWorldLocation, FVector(InSphereRadius))) { return; }
+#endif
+
+		const FST_SparseGridCellTile3D Tile = GetSearchTile(InWorldLocation, FVector(InSphereRadius));
+
+		const FST_SparseGridKernel_Sphere Kernel = FST_SparseGridKernel_Sphere(InWorldLocation, InSphereRadius);
+		QueryCells(OutObjects, Tile, Kernel, InFilter, [this, &InWorldLocation, InSphereRadius](const FIntVector& CellXYZ) { return CullCell_Range(CellXYZ, InWorldLocation, InSphereRadius); }, InWorldLocation, bDrawDebug);
+	}
+
+	/*
+	* Capsule Query
+	* Returns all registered objects within an orientated capsule.
+	*/
+	template<class OutputType>
+	void QueryGrid_Capsule(OutputType& OutObjects, const FVector& InWorldLocation, const FVector& InUpAxis, float InCapsuleRadius, float InCapsuleHalfHeight, const FST_SparseGridCategoryFilter& InFilter, bool bDrawDebug = false) const
+	{
+		SCOPE_CYCLE_COUNTER(STAT_QueryGrid_Capsule)
+
+		SPARSE_GRID_CHECK_NOT_VISITING();
+		FRWScopeLock ReadLock(GridLock, SLT_ReadOnly);
+
+		InCapsuleHalfHeight = FMath::Max3(0.f, InCapsuleHalfHeight, InCapsuleRadius);
+		InCapsuleRadius = FMath::Clamp(InCapsuleRadius, 0.f, InCapsuleHalfHeight);
+
+		const FVector Dir = InUpAxis * (InCapsuleHalfHeight - InCapsuleRadius);
+		const FVector Extents = Dir.GetAbs() + FVector(InCapsuleRadius);
+		const FVector CapsuleStart = InWorldLocation + Dir;
+		const FVector CapsuleEnd = InWorldLocation - Dir;
+
+#if SPARSE_GRID_DEBUG
+		bDrawDebug &= IsInGameThread();
+		GATHER_DEBUG_PARAMETERS;
+
+		if (bDrawDebug) { DrawDebugCapsule(DebugWorld, InWorldLocation, InCapsuleHalfHeight, InCapsuleRadius, FRotationMatrix::MakeFromZ(InUpAxis).ToQuat(), FColor::Green, false, DrawQueryTime, 0, DrawQueryThickness); }
+#endif
+
+#if ENABLE_GRID_BOUNDS
+		if (ObjectBounds.CanFastReject(InWorldLocation, Extents)) { return; }
+#endif
+
+		const FST_SparseGridCellTile3D Tile = GetSearchTile(InWorldLocation, Extents);
+
+		const FST_SparseGridKernel_Capsule Kernel = FST_SparseGridKernel_Capsule(CapsuleStart, CapsuleEnd, InCapsuleRadius);
+		QueryCells(OutObjects, Tile, Kernel, InFilter, [this, &CapsuleStart, &CapsuleEnd, InCapsuleRadius](const FIntVector& CellXYZ) { return CullCell_Line(CellXYZ, CapsuleStart, CapsuleEnd, InCapsuleRadius); }, InWorldLocation, bDrawDebug);
+	}
+
+	/*
+	* Box Query
+	* Returns all registered objects in an axis-aligned bounding box.
+	*/
+	template<class OutputType>
+	void QueryGrid_Box(OutputType& OutObjects, const FVector& InWorldLocation, const FVector& InBoxExtents, const FST_SparseGridCategoryFilter& InFilter, bool bDrawDebug = false) const
+	{
+		SCOPE_CYCLE_COUNTER(STAT_QueryGrid_Box)
+
+		SPARSE_GRID_CHECK_NOT_VISITING();
+		FRWScopeLock ReadLock(GridLock, SLT_ReadOnly);
+
+#if SPARSE_GRID_DEBUG
+		bDrawDebug &= IsInGameThread();
+		GATHER_DEBUG_PARAMETERS;
+
+		if (bDrawDebug) { DrawDebugBox(DebugWorld, InWorldLocation, InBoxExtents, FColor::Blue, false, DrawQueryTime, 0, DrawQueryThickness); }
+#endif
+
+#if ENABLE_GRID_BOUNDS
+		if (ObjectBounds.CanFastReject(InWorldLocation, InBoxExtents)) { return; }
+#endif
+
+		// Axis-Aligned Tiles, no cell culling required
+		const FST_SparseGridCellTile3D Tile = GetSearchTile(InWorldLocation, InBoxExtents);
+
+		const FST_SparseGridKernel_Box Kernel = FST_SparseGridKernel_Box(InWorldLocation, InBoxExtents);
+		QueryCells(OutObjects, Tile, Kernel, InFilter, [](const FIntVector& CellXYZ) { return false; }, InWorldLocation, bDrawDebug);
+	}
+
+	/*
+	* Rotated Box Query
+	* Finds all registered objects within an non-axis-aligned bounding box.
+	*/
+	template<class OutputType>
+	void QueryGrid_RotatedBox(OutputType& OutObjects, const FVector& InWorldLocation, const FQuat& InBoxRotation, const FVector& InBoxExtents, const FST_SparseGridCategoryFilter& InFilter, bool bDrawDebug = false) const
+	{
+		if (InBoxRotation.IsIdentity())
+		{
+			QueryGrid_Box(OutObjects, InWorldLocation, InBoxExtents, InFilter, bDrawDebug);
+			return;
+		}
+
+		SCOPE_CYCLE_COUNTER(STAT_QueryGrid_RotatedBox)
+
+		SPARSE_GRID_CHECK_NOT_VISITING();
+		FRWScopeLock ReadLock(GridLock, SLT_ReadOnly);
+
+		const FBoxSphereBounds AABB = FBoxSphereBounds(FBox(-InBoxExtents, InBoxExtents)).TransformBy(FTransform(InBoxRotation, InWorldLocation));
+
+#if SPARSE_GRID_DEBUG
+		bDrawDebug &= IsInGameThread();
+		GATHER_DEBUG_PARAMETERS;
+
+		if (bDrawDebug) { DrawDebugBox(DebugWorld, InWorldLocation, InBoxExtents, InBoxRotation, FColor::Green, false, DrawQueryTime, 0, DrawQueryThickness); }
+#endif
+
+#if ENABLE_GRID_BOUNDS
+		if (ObjectBounds.CanFastReject(AABB.Origin, AABB.BoxExtent)) { return; }
+#endif
+
+		const FST_SparseGridCellTile3D Tile = GetSearchTile(AABB.Origin, AABB.BoxExtent);
+
+		const FST_SparseGridKernel_RotatedBox Kernel = FST_SparseGridKernel_RotatedBox(InWorldLocation, InBoxRotation, InBoxExtents);
+		QueryCells(OutObjects, Tile, Kernel, InFilter, [](const FIntVector& CellXYZ) { return false; }, InWorldLocation, bDrawDebug);
+	}
+
+	/*
+	* Cone Query
+	* Finds all registered objects within a cone.
+	*/
+	template<class OutputType>
+	void QueryGrid_Cone(OutputType& OutObjects, const FVector& InWorldLocation, const float InConeLength, const float InConeHalfAngleRadians, const FVector& InAxis, const FST_SparseGridCategoryFilter& InFilter, bool bDrawDebug = false) const
+	{
+		SCOPE_CYCLE_COUNTER(STAT_QueryGrid_Cone)
+
+		SPARSE_GRID_CHECK_NOT_VISITING();
+		FRWScopeLock ReadLock(GridLock, SLT_ReadOnly);
+
+		const FVector ConeCenter = InWorldLocation + InAxis * (InConeLength * 0.5f);
+		const FVector ConeEnd = InWorldLocation + InAxis * InConeLength;
+		const float ConeEndRadius = InConeLength * FMath::Tan(InConeHalfAngleRadians);
+		const FVector ConeBoundsExtents = FVector(InConeLength * 0.5f, ConeEndRadius, ConeEndRadius);
+		const FBoxSphereBounds AABB = FBoxSphereBounds(FBox(-ConeBoundsExtents, ConeBoundsExtents)).TransformBy(FTransform(FRotationMatrix::MakeFromX(InAxis).ToQuat(), ConeCenter));
+
+#if SPARSE_GRID_DEBUG
+		bDrawDebug &= IsInGameThread();
+		GATHER_DEBUG_PARAMETERS;
+
+		if (bDrawDebug) { DrawDebugCone(DebugWorld, InWorldLocation, InAxis, InConeLength, InConeHalfAngleRadians, InConeHalfAngleRadians, 16, FColor::Green, false, DrawQueryTime, 0, DrawQueryThickness); }
+#endif
+
+#if ENABLE_GRID_BOUNDS
+		if (ObjectBounds.CanFastReject(AABB.Origin, AABB.BoxExtent)) { return; }
+#endif
+
+		const FST_SparseGridCellTile3D Tile = GetSearchTile(AABB.Origin, AABB.BoxExtent);
+
+		const FST_SparseGridKernel_Cone Kernel = FST_SparseGridKernel_Cone(InWorldLocation, InAxis, InConeLength, InConeHalfAngleRadians);
+		QueryCells(OutObjects, Tile, Kernel, InFilter, [this, &InWorldLocation, &ConeEnd, ConeEndRadius](const FIntVector& CellXYZ) { return CullCell_Line(CellXYZ, InWorldLocation, ConeEnd, ConeEndRadius); }, InWorldLocation, bDrawDebug);
+	}
+
+private:
+	/*
+	* Shared narrow-phase for all shape queries, see TST_SparseGrid::QueryCells()
+	*/
+	template<class KernelType, class CullFuncType, class OutputType>
+	void QueryCells(OutputType& OutObjects, const FST_SparseGridCellTile3D& Tile, const KernelType& Kernel, const FST_SparseGridCategoryFilter& Filter, const CullFuncType& CullCellFunc, const FVector& DebugOrigin, const bool bDrawDebug) const
+	{
+#if SPARSE_GRID_DEBUG
+		GATHER_DEBUG_PARAMETERS;
+#endif
+
+		TArray<uint32, TInlineAllocator<8>> HitMask;
+
+		for (int32 XIdx = Tile.Start.X; XIdx < Tile.End.X; XIdx++)
+		{
+			for (int32 YIdx = Tile.Start.Y; YIdx < Tile.End.Y; YIdx++)
+			{
+				for (int32 ZIdx = Tile.Start.Z; ZIdx < Tile.End.Z; ZIdx++)
+				{
+					const FIntVector CellXYZ = FIntVector(XIdx, YIdx, ZIdx);
+					const TST_SparseGridCell<T>& Cell = GridCells[GetCellIndex(CellXYZ)];
+					const int32 NumCellObjects = Cell.GetObjects().Num();
+					if (NumCellObjects == 0 || CullCellFunc(CellXYZ))
+					{
+						continue;
+					}
+
+#if SPARSE_GRID_DEBUG
+					if (bDrawDebug) { DrawDebugCell(CellXYZ, FColor::Green, DrawQueryTime); }
+#endif
+
+					HitMask.SetNumUninitialized(FST_SparseGridKernels::GetNumMaskWords(NumCellObjects), false);
+
+					int32 NumHits = FST_SparseGridKernels::BuildHitMask(Kernel, Cell.GetPositionsX(), Cell.GetPositionsY(), Cell.GetPositionsZ(), NumCellObjects, HitMask.GetData());
+					NumHits = FST_SparseGridKernels::FilterHitMask(Filter, Cell.GetCategories(), HitMask.GetData(), HitMask.Num(), NumHits);
+					if (NumHits > 0)
+					{
+						FST_SparseGridKernels::AppendMasked(OutObjects, Cell.GetObjects().GetData(), HitMask.GetData(), HitMask.Num(), NumHits);
+
+#if SPARSE_GRID_DEBUG
+						if (bDrawDebug)
+						{
+							FST_SparseGridKernels::ForEachSetBit(HitMask.GetData(), HitMask.Num(), [&](const int32 SubIdx)
+							{
+								DrawDebugLine(DebugWorld, DebugOrigin, Cell.GetPosition(SubIdx), FColor::Green, false, DrawQueryTime, 0, DrawQueryThickness);
+							});
+						}
+#endif
+
+						// Visitors can end the query early
+						if (FST_SparseGridKernels::IsStopped(OutObjects))
+						{
+							return;
+						}
+					}
+				}
+			}
+		}
+	}
+
+#if WITH_EDITOR
+	//////////////////
+	///// Editor /////
+	//////////////////
+public:
+	void GetEditorDebugInfo(int32& OutTotalObjects, uint64& OutRegisterAlloc, uint64& OutRegisterUsed, uint64& OutCellAlloc, uint64& OutCellUsed) const
+	{
+		SPARSE_GRID_CHECK_NOT_VISITING();
+		FRWScopeLock ReadLock(GridLock, SLT_ReadOnly);
+
+		this->GetRegisterMemoryInfo(OutTotalObjects, OutRegisterAlloc, OutRegisterUsed);
+
+		OutCellAlloc = CellStorage.GetAllocatedSize() + GridCells.GetAllocatedSize();
+		OutCellUsed = 0;
+		for (const TST_SparseGridCell<T>& CellItr : GridCells)
+		{
+			uint64 A, U;
+			CellItr.GetMemoryInfo(A, U);
+
+			OutCellUsed += U;
+		}
+	}
+#endif
+
+#if SPARSE_GRID_DEBUG
+	/////////////////////
+	///// Debugging /////
+	/////////////////////
+public:
+	/*
+	* Draws all populated cells.
+	* Empty cells are skipped, drawing every voxel is rarely readable.
+	*/
+	void DrawDebugGrid() const
+	{
+		const FLinearColor DebugHotColour = FLinearColor::FromSRGBColor(FColor::FromHex(ST_SparseGridCVars::CVarHotHex.GetValueOnGameThread()));
+		const FLinearColor DebugColdColour = FLinearColor::FromSRGBColor(FColor::FromHex(ST_SparseGridCVars::CVarColdHex.GetValueOnGameThread()));
+		const int32 HotThreshold = FMath::Max(ST_SparseGridCVars::CVarDebugHotThreshold.GetValueOnGameThread(), 1);
+
+		for (int32 XIdx = 0; XIdx < NumCells.X; XIdx++)
+		{
+			for (int32 YIdx = 0; YIdx < NumCells.Y; YIdx++)
+			{
+				for (int32 ZIdx = 0; ZIdx < NumCells.Z; ZIdx++)
+				{
+					const FIntVector CellXYZ = FIntVector(XIdx, YIdx, ZIdx);
+					const int32 CellCount = GridCells[GetCellIndex(CellXYZ)].GetObjects().Num();
+					if (CellCount)
+					{
+						const float Progress = FMath::Clamp((float)CellCount / (float)HotThreshold, 0.f, 1.f);
+						DrawDebugCell(CellXYZ, FLinearColor::LerpUsingHSV(DebugColdColour, DebugHotColour, Progress).ToFColor(true), -1.f);
+					}
+				}
+			}
+		}
+	}
+
+	void DrawDebugCell(const FIntVector& CellXYZ, const FColor& Colour, const float DrawTime = -1.f) const
+	{
+		DrawDebugBox(GetGridWorld(), GetCellCenter(CellXYZ), FVector(GetCellSize3D()) * 0.5f, Colour, false, DrawTime, 0, ST_SparseGridCVars::CVarDebugGridThickness.GetValueOnGameThread());
+	}
+#endif
+};
\ No newline at end of file
@@ -54,6 +54,15 @@ public:
 	FORCEINLINE int32 GetNumCellsX() const { return NumCellsX; }
 	FORCEINLINE int32 GetNumCellsY() const { return NumCellsY; }
 	FORCEINLINE int32 GetCellSize() const { return CellSize; }
+	FORCEINLINE EST_SparseGridUpdateMode GetUpdateMode() const { return UpdateMode; }
+	FORCEINLINE int32 GetParallelUpdateBatchSize() const { return ParallelUpdateBatchSize; }
+	FORCEINLINE float GetAutoRebuildThreshold() const { return AutoRebuildThreshold; }
+	FORCEINLINE bool GetIncrementalUpdate() const { return bIncrementalUpdate; }
+	FORCEINLINE bool GetPublishSnapshots() const { return bPublishSnapshots; }
+	FORCEINLINE bool GetDeferRegistration() const { return bDeferRegistration; }
+	FORCEINLINE int32 GetNumCoarseLevels() const { return NumCoarseLevels; }
+	FORCEINLINE int32 GetCoarseLevelRatio() const { return CoarseLevelRatio; }
+	FORCEINLINE EST_SparseGridCellLayout GetCellLayout() const { return CellLayout; }
 
 	FORCEINLINE void SetRegisterAllocSize(int32 InRegisterAllocSize) { RegisterAllocSize = InRegisterAllocSize; }
 	FORCEINLINE void SetCellAllocSize(int32 InCellAllocSize) { CellAllocSize = InCellAllocSize; }
@@ -99,6 +108,69 @@ protected:
 	UPROPERTY(EditAnywhere, Category = "Grid Properties", meta = (ClampMin = "100.0", ClampMax = "16000.0", UIMin = "100.0", UIMax = "16000.0"))
 	int32 CellSize;
 
+	/*
+	* How object placement is refreshed each frame.
+	*
+	* Parallel is better for high object counts where most objects stay in the same cell between frames.
+	* Serial is better for low object counts, where the cost of dispatching tasks outweighs the work.
+	* Rebuild is better for highly dynamic grids where many objects change cell every frame, it also keeps cell storage compact.
+	* Automatic switches between Parallel and Rebuild based on how many objects changed cell in the previous frame.
+	*
+	* Rebuild only applies to full updates, incremental grids use Parallel instead.
+	*/
+	UPROPERTY(EditAnywhere, Category = "Update")
+	EST_SparseGridUpdateMode UpdateMode;
+
+	/*
+	* Number of registered objects processed by each task in a parallel update.
+	* Grids with fewer registered objects than this always update serially.
+	*/
+	UPROPERTY(EditAnywhere, Category = "Update", meta = (ClampMin = "64", ClampMax = "65536", UIMin = "64", UIMax = "65536", EditCondition = "UpdateMode != EST_SparseGridUpdateMode::Serial"))
+	int32 ParallelUpdateBatchSize;
+
+	/*
+	* Fraction of registered objects that must change cell in one frame for an Automatic grid to rebuild the next.
+	*/
+	UPROPERTY(EditAnywhere, Category = "Update", meta = (ClampMin = "0.05", ClampMax = "1.0", UIMin = "0.05", UIMax = "1.0", EditCondition = "UpdateMode == EST_SparseGridUpdateMode::Automatic"))
+	float AutoRebuildThreshold;
+
+	/*
+	* If true, only dynamic objects are re-bucketed every frame.
+	* Static objects are skipped unless their owner's root component moves.
+	* Object bounds are maintained incrementally and never shrink, so fast-rejection may be less effective.
+	*/
+	UPROPERTY(EditAnywhere, Category = "Update")
+	bool bIncrementalUpdate;
+
+	/*
+	* If true, the grid publishes an immutable snapshot after each update.
+	* Background work can query snapshots across the whole frame without blocking the next update, at the cost of copying the grid each frame.
+	*/
+	UPROPERTY(EditAnywhere, Category = "Update")
+	bool bPublishSnapshots;
+
+	/*
+	* If true, components queue their registration and are added to the grids in one batch at the start of the next manager tick.
+	* Makes mass spawning cheaper, but newly spawned components are not found by queries until the grids next update.
+	* Components registering off the game thread are always deferred.
+	*/
+	UPROPERTY(EditAnywhere, Category = "Update")
+	bool bDeferRegistration;
+
+	/*
+	* Number of coarse occupancy levels built on top of the grid cells.
+	* Large queries skip empty regions a whole block at a time, at the cost of a counter update per level whenever an object changes cell.
+	* Useful when query radii vary a lot relative to the cell size.
+	*/
+	UPROPERTY(EditAnywhere, Category = "Hierarchy", meta = (ClampMin = "0", ClampMax = "2", UIMin = "0", UIMax = "2"))
+	int32 NumCoarseLevels;
+
+	/*
+	* Number of cells (or blocks) per side grouped into each block of the next level up.
+	*/
+	UPROPERTY(EditAnywhere, Category = "Hierarchy", meta = (ClampMin = "2", ClampMax = "16", UIMin = "2", UIMax = "16", EditCondition = "NumCoarseLevels > 0"))
+	int32 CoarseLevelRatio;
+
 	/*
 	* Allocation Block Size for array of registered grid components
 	*
@@ -110,12 +182,23 @@ protected:
 
 	/*
 	* Allocation Block Size for array of grid components in a cell
+	* All cells share one storage slab, cells take and return chunks of this many components at a time.
 	*
 	* Higher values are better for large object counts and/or high object density.
 	* Lower values are better for low object counts and/or low object density.
 	*/
 	UPROPERTY(EditAnywhere, Category = "Memory Management", meta = (ClampMin = "8", ClampMax = "128", UIMin = "8", UIMax = "128"))
 	int32 CellAllocSize;
+
+	/*
+	* Order of the grid cells in memory.
+	*
+	* Morton keeps the cells of a search tile close together in memory, which helps grids with many cells along Y.
+	* Each axis is padded to a power of two, so non power-of-two grids allocate some unused cells.
+	* Use SparseGrid.BenchmarkLayout to compare both layouts in a running world.
+	*/
+	UPROPERTY(EditAnywhere, Category = "Memory Management")
+	EST_SparseGridCellLayout CellLayout;
 	
 	/*
 	* Deallocation Control for array of registered grid components
@@ -135,6 +218,7 @@ protected:
 	* 0 = Always Shrink. Cell will always shrink to the nearest multiplier of CellAllocSize that can accommodate all items.
 	* # = Variable Shrink. Cell will shrink to the nearest multiplier of CellAllocSize that can accommodate all items, but only if the slack is above # * CellAllocSize
 	*
+	* Blocks given back by a cell are reused by other cells rather than freed.
 	*/
 	UPROPERTY(EditAnywhere, AdvancedDisplay, Category = "Memory Management", meta = (ClampMin = "-1", ClampMax = "64", UIMin = "-1", UIMax = "64"))
 	int32 CellAllocShrinkMultiplier;
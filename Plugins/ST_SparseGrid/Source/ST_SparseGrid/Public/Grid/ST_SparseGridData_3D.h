@@ -0,0 +1,53 @@
+// Copyright (C) James Baxter. All Rights Reserved.
+
+#pragma once
+
+#include "ST_SparseGridData.h"
+#include "ST_SparseGridData_3D.generated.h"
+
+/*
+* Grid data for the voxel sparse grid.
+*
+* Cells are also divided vertically, so stacked floors of a level are stored in separate cells.
+* GridOrigin, NumCellsX/Y and CellSize describe the horizontal layout as usual.
+*/
+UCLASS(meta = (DisplayName = "Sparse Grid Data - 3D"))
+class ST_SPARSEGRID_API UST_SparseGridData_3D : public UST_SparseGridData
+{
+	GENERATED_BODY()
+public:
+	// Constructor
+	UST_SparseGridData_3D(const FObjectInitializer& OI);
+
+#if WITH_EDITORONLY_DATA
+	virtual FText GetGridDiagnosticText() const override;
+#endif
+
+	FORCEINLINE int32 GetGridOriginZ() const { return GridOriginZ; }
+	FORCEINLINE int32 GetNumCellsZ() const { return NumCellsZ; }
+	FORCEINLINE int32 GetCellSizeZ() const { return CellSizeZ; }
+
+	FORCEINLINE FIntVector GetGridOrigin3D() const { return FIntVector(GridOrigin.X, GridOrigin.Y, GridOriginZ); }
+	FORCEINLINE FIntVector GetNumCells3D() const { return FIntVector(NumCellsX, NumCellsY, NumCellsZ); }
+
+protected:
+	/*
+	* World-space height of the bottom of the grid
+	*/
+	UPROPERTY(EditAnywhere, Category = "Grid Properties")
+	int32 GridOriginZ;
+
+	/*
+	* Number of Grid Cells in the Z Direction.
+	* Objects above or below the grid will be clamped to the top or bottom layer of cells.
+	*/
+	UPROPERTY(EditAnywhere, Category = "Grid Properties", meta = (ClampMin = "1", UIMin = "1", ClampMax = "64", UIMax = "64"))
+	int32 NumCellsZ;
+
+	/*
+	* World-space height of the cells.
+	* Typically the height of a single floor of the level, so each floor lands in its own layer of cells.
+	*/
+	UPROPERTY(EditAnywhere, Category = "Grid Properties", meta = (ClampMin = "50.0", ClampMax = "16000.0", UIMin = "50.0", UIMax = "16000.0"))
+	int32 CellSizeZ;
+};
\ No newline at end of file
@@ -0,0 +1,21 @@
+// Copyright (C) James Baxter. All Rights Reserved.
+
+#pragma once
+
+#include "ST_SparseGridData.h"
+#include "ST_SparseGridData_Hashed.generated.h"
+
+/*
+* Grid data for the unbounded hashed sparse grid.
+*
+* Only cells holding objects are allocated, so the grid has no cell count limit and objects are never clamped into edge cells.
+* GridOrigin and NumCellsX/Y only describe the window shown by the editor visualizer and heat-map.
+*/
+UCLASS(meta = (DisplayName = "Sparse Grid Data - Hashed"))
+class ST_SPARSEGRID_API UST_SparseGridData_Hashed : public UST_SparseGridData
+{
+	GENERATED_BODY()
+public:
+	// Constructor
+	UST_SparseGridData_Hashed(const FObjectInitializer& OI);
+};
\ No newline at end of file
@@ -0,0 +1,79 @@
+// Copyright (C) James Baxter. All Rights Reserved.
+
+#pragma once
+
+#include "ST_SparseGridData.h"
+#include "ST_SparseGridData_Multi.generated.h"
+
+/*
+* Settings for one named grid of the multi-grid manager.
+* Grids cover the same world area as the grid data, so the number of cells follows from the cell size.
+*/
+USTRUCT(BlueprintType)
+struct ST_SPARSEGRID_API FST_SparseGridNamedConfig
+{
+	GENERATED_BODY()
+public:
+	FST_SparseGridNamedConfig()
+		: GridName(NAME_None)
+		, CellSize(1000)
+		, RegisterAllocSize(128)
+		, CellAllocSize(16)
+		, RegisterAllocShrinkMultiplier(0)
+		, CellAllocShrinkMultiplier(1)
+	{}
+
+	/*
+	* Name components use to choose this grid, and queries use to search it.
+	*/
+	UPROPERTY(EditAnywhere, Category = "Grid Properties")
+	FName GridName;
+
+	/*
+	* World-space size of the cells in this grid.
+	* Use larger cells for sparse, widely spread objects and smaller cells for dense clusters.
+	* Grids are limited to 192 cells per axis like the shared settings, so the shared area should not span more than 192 cells of this size.
+	*/
+	UPROPERTY(EditAnywhere, Category = "Grid Properties", meta = (ClampMin = "100.0", ClampMax = "16000.0", UIMin = "100.0", UIMax = "16000.0"))
+	int32 CellSize;
+
+	/*
+	* See UST_SparseGridData
+	*/
+	UPROPERTY(EditAnywhere, Category = "Memory Management", meta = (ClampMin = "16", ClampMax = "4096", UIMin = "16", UIMax = "4096"))
+	int32 RegisterAllocSize;
+
+	UPROPERTY(EditAnywhere, Category = "Memory Management", meta = (ClampMin = "8", ClampMax = "128", UIMin = "8", UIMax = "128"))
+	int32 CellAllocSize;
+
+	UPROPERTY(EditAnywhere, AdvancedDisplay, Category = "Memory Management", meta = (ClampMin = "-1", ClampMax = "64", UIMin = "-1", UIMax = "64"))
+	int32 RegisterAllocShrinkMultiplier;
+
+	UPROPERTY(EditAnywhere, AdvancedDisplay, Category = "Memory Management", meta = (ClampMin = "-1", ClampMax = "64", UIMin = "-1", UIMax = "64"))
+	int32 CellAllocShrinkMultiplier;
+};
+
+/*
+* Grid data for the multi-grid manager.
+*
+* Creates one sparse grid per entry, so different kinds of object (enemies, pickups, projectiles...) don't share cells.
+* GridOrigin and NumCellsX/Y * CellSize describe the area covered by every grid. Update, hierarchy and layout settings are shared.
+* Components choose their grid by name, components with no name or an unknown name use the first grid.
+*/
+UCLASS(meta = (DisplayName = "Sparse Grid Data - Multi"))
+class ST_SPARSEGRID_API UST_SparseGridData_Multi : public UST_SparseGridData
+{
+	GENERATED_BODY()
+public:
+	// Constructor
+	UST_SparseGridData_Multi(const FObjectInitializer& OI);
+
+	FORCEINLINE const TArray<FST_SparseGridNamedConfig>& GetGrids() const { return Grids; }
+
+protected:
+	/*
+	* Grids to create. If empty, a single grid is created from the shared settings.
+	*/
+	UPROPERTY(EditAnywhere, Category = "Grids", meta = (TitleProperty = "GridName"))
+	TArray<FST_SparseGridNamedConfig> Grids;
+};
\ No newline at end of file
@@ -3,10 +3,13 @@
 #pragma once
 
 #include "Components/ActorComponent.h"
+#include "Containers/Queue.h"
 #include "ST_SparseGridManager.generated.h"
 
 // Declarations
 class UST_SparseGridData;
+class UST_SparseGridComponent;
+class ULevel;
 class FST_SparseGridModule;
 
 // Sparse-Grid Forward Declaration
@@ -34,7 +37,7 @@ public:
 	* Static Accessor.
 	* Will require casting to the correct Manager Type
 	*
-	* Tries to get the Grid Instance from world settings.
+	* Looks up the Grid Instance registered for the context object's world.
 	* Will return nullptr if the Instance does not exist.
 	*/
 	UFUNCTION(BlueprintPure, Category = "Sparse Grid", meta = (CompactNodeTitle = "Sparse Grid", DisplayName = "Sparse Grid", Keywords = "Sparse Grid", HidePin = "WorldContextObject", DefaultToSelf = "WorldContextObject"))
@@ -43,12 +46,22 @@ public:
 	/*
 	* Static Accessor.
 	*
-	* Tries to get the Grid Instance from world settings.
+	* Looks up the Grid Instance registered for the context object's world.
 	* Will assert if the manager doesn't exist.
 	*/
 	static UST_SparseGridManager* GetChecked(const UObject* WorldContextObject);
 
 private:
+	/*
+	* Managers by world, so lookups don't have to search the world settings components.
+	* Managers add themselves when registered and remove themselves when unregistered.
+	* Guarded by a lock, so the accessors are safe to call from any thread.
+	*/
+	static TMap<const UWorld*, TWeakObjectPtr<UST_SparseGridManager>> WorldManagers;
+	static FRWLock WorldManagersLock;
+
+	static UST_SparseGridManager* FindWorldManager(const UWorld* InWorld);
+
 	// Allow Module to call Create/Destroy Grid.
 	friend FST_SparseGridModule;
 
@@ -112,6 +125,38 @@ public:
 	*/
 	FORCEINLINE const UST_SparseGridData* GetGridConfig() const { return GridConfig.Get(); }
 
+	/*
+	* Component Registration
+	* Called by UST_SparseGridComponent, so components can register with any manager type.
+	* Managers route the component into whichever of their grids holds sparse grid components.
+	*/
+	virtual bool RegisterGridComponent(UST_SparseGridComponent* InComponent) { return false; }
+	virtual bool UnregisterGridComponent(UST_SparseGridComponent* InComponent) { return false; }
+	virtual void MarkGridComponentDirty(UST_SparseGridComponent* InComponent) {}
+
+	/*
+	* Batch Registration
+	* Called when applying queued registrations. Registers each component in turn by default,
+	* managers override this to add the whole batch to a grid at once.
+	*/
+	virtual void RegisterGridComponents(TArrayView<UST_SparseGridComponent* const> InComponents);
+
+	/*
+	* Deferred Registration
+	* Queues a component to be registered with the grids at the start of the next tick, before the grids update.
+	* May be called from any thread. There is no queued removal, components are always removed immediately on the game thread by OnUnregister(),
+	* and queued components unregistered since are dropped.
+	*/
+	void QueueGridComponentRegistration(UST_SparseGridComponent* InComponent);
+
+	/*
+	* Level Removal
+	* Called once when a streaming level starts unloading, before its components unregister one at a time.
+	* Unregisters every component owned by an actor in that level by default,
+	* managers override this to drop the whole level from their grids in one pass and compact their storage.
+	*/
+	virtual void UnregisterLevelGridComponents(const ULevel* InLevel);
+
 protected:
 	virtual void CreateGrids() {}
 	virtual void DestroyGrids() {}
@@ -122,6 +167,16 @@ private:
 	void UninitializeGrids();
 	uint8 bGridsInitialized : 1;
 
+	// Applies queued registrations, see QueueGridComponentRegistration()
+	void ProcessPendingRegistrations();
+
+	// Lock-free, any thread may queue but only the game thread drains
+	TQueue<TWeakObjectPtr<UST_SparseGridComponent>, EQueueMode::Mpsc> PendingRegistrations;
+
+	// Scratch for draining the queue, kept between frames to avoid reallocating
+	TSet<UST_SparseGridComponent*> PendingRequests;
+	TArray<UST_SparseGridComponent*> PendingBatch;
+
 	UPROPERTY(Transient)
 	TWeakObjectPtr<const UST_SparseGridData> GridConfig;
 };
\ No newline at end of file
@@ -0,0 +1,98 @@
+// Copyright (C) James Baxter. All Rights Reserved.
+
+#pragma once
+
+#include "ST_SparseGridTypes.h"
+#include "ST_SparseGridManager.h"
+#include "ST_SparseGridManager_3D.generated.h"
+
+// Declarations
+class UST_SparseGridComponent;
+
+template<class T>
+class TST_SparseGrid3D;
+
+/*
+* Sparse Grid Manager 3D
+* Sorts Components into a single voxel sparse grid.
+*
+* Use this instead of the Basic manager for levels with stacked floors, where a 2D grid would scan every floor per query.
+* Requires UST_SparseGridData_3D as the grid config.
+*/
+UCLASS(meta = (DisplayName = "Sparse Grid - 3D"))
+class ST_SPARSEGRID_API UST_SparseGridManager_3D : public UST_SparseGridManager
+{
+	GENERATED_BODY()
+public:
+	// Constructor
+	UST_SparseGridManager_3D(const FObjectInitializer& OI);
+
+	/*
+	* Static Accessor.
+	*
+	* Tries to get the Manager Instance as a Sparse Grid - 3D from world settings.
+	* Will return nullptr if the Instance does not exist.
+	*/
+	UFUNCTION(BlueprintPure, Category = "Sparse Grid|3D", meta = (CompactNodeTitle = "Sparse Grid - 3D", DisplayName = "Sparse Grid - 3D", Keywords = "Sparse Grid 3D Voxel", HidePin = "WorldContextObject", DefaultToSelf = "WorldContextObject"))
+	static UST_SparseGridManager_3D* K2_Get(const UObject* WorldContextObject) { return Cast<UST_SparseGridManager_3D>(UST_SparseGridManager::Get(WorldContextObject)); }
+
+	// UST_SparseGridManager Interface
+	virtual void CreateGrids() override;
+	virtual void DestroyGrids() override;
+	virtual void UpdateGrids() override;
+	virtual bool RegisterGridComponent(UST_SparseGridComponent* InComponent) override;
+	virtual bool UnregisterGridComponent(UST_SparseGridComponent* InComponent) override;
+
+#if WITH_EDITOR
+	//////////////////
+	///// Editor /////
+	//////////////////
+public:
+	static const FName GRIDNAME_3D;
+
+	virtual bool GetGridNames(TArray<FName>& OutGridNames) const override;
+	virtual bool GetGridPopulationData(const FName InGridName, TArray<uint32>& OutData) const override;
+	virtual bool GetGridMemoryInfo(const FName InGridName, int32& OutTotalObjects, uint64& OutRegisterAllocSize, uint64& OutRegisterUsedSize, uint64& OutCellAllocSize, uint64& OutCellUsedSize) const override;
+#endif
+
+	/////////////////////
+	///// Grid Data /////
+	/////////////////////
+public:
+	/*
+	* Grid Data Accessor (C++ Only)
+	*/
+	TSharedRef<TST_SparseGrid3D<UST_SparseGridComponent>> GetSparseGrid_3D() const { return SparseGridData_3D.ToSharedRef(); }
+
+	/*
+	* Gets all objects currently registered in the grid
+	* Array cannot be modified
+	*/
+	UFUNCTION(BlueprintPure, Category = "Sparse Grid|3D", meta = (DisplayName = "Get All Sparse Grid Components"))
+	const TArray<UST_SparseGridComponent*>& GetGridComponents() const;
+
+	/*
+	* Gets a search query tile
+	*/
+	UFUNCTION(BlueprintPure, Category = "Sparse Grid|3D", meta = (DisplayName = "Get Search Query Cell Tile 3D"))
+	FST_SparseGridCellTile3D GetSearchTile(const FVector& WorldSearchOrigin, const FVector& WorldSearchExtents) const;
+
+private:
+	TSharedPtr<TST_SparseGrid3D<UST_SparseGridComponent>> SparseGridData_3D;
+
+	/////////////////////////////
+	///// Blueprint Queries /////
+	/////////////////////////////
+
+	/*
+	* Gets all registered Sparse Grid objects in a Sphere Shape
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Sparse Grid|Queries|3D", meta = (DisplayName = "Query 3D Grid [Sphere]", WorldContext = "WorldContextObject"))
+	static bool K2_GetComponents_Sphere(const UObject* WorldContextObject, TArray<UST_SparseGridComponent*>& GridComponents, const FVector& WorldLocation, const float SphereRadius, const bool bDrawDebug = false);
+
+	/*
+	* Gets all registered Sparse Grid objects in a AABB Box Shape
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Sparse Grid|Queries|3D", meta = (DisplayName = "Query 3D Grid [AABB]", WorldContext = "WorldContextObject"))
+	static bool K2_GetComponents_Box(const UObject* WorldContextObject, TArray<UST_SparseGridComponent*>& GridComponents, const FVector& WorldLocation, const FVector& BoxExtents, const bool bDrawDebug = false);
+};
\ No newline at end of file
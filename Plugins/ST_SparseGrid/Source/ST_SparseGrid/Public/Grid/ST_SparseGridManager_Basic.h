@@ -37,6 +37,11 @@ public:
 	virtual void CreateGrids() override;
 	virtual void DestroyGrids() override;
 	virtual void UpdateGrids() override; 
+	virtual bool RegisterGridComponent(UST_SparseGridComponent* InComponent) override;
+	virtual bool UnregisterGridComponent(UST_SparseGridComponent* InComponent) override;
+	virtual void RegisterGridComponents(TArrayView<UST_SparseGridComponent* const> InComponents) override;
+	virtual void UnregisterLevelGridComponents(const ULevel* InLevel) override;
+	virtual void MarkGridComponentDirty(UST_SparseGridComponent* InComponent) override;
 
 #if WITH_EDITOR
 	//////////////////
@@ -100,13 +105,6 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Sparse Grid|Basic", meta = (DisplayName = "Get Tile Components"))
 	void K2_GetTileComponents(const FST_SparseGridCellTile& Tile, UPARAM(DisplayName = "Grid Components")TArray<UST_SparseGridComponent*>& Components) const;
 
-	/*
-	* Gets the cached cell bounding radius
-	* Blueprint use only.
-	*/
-	UFUNCTION(BlueprintCallable, Category = "Sparse Grid|Basic", meta = (DisplayName = "Get Cell Bounds Radius"))
-	float K2_GetCellBoundsRadius() const;
-
 	/*
 	* Convert a Cell ID to X and Y ID
 	* Blueprint use only.
@@ -132,33 +130,52 @@ private:
 	///// Blueprint Queries /////
 	/////////////////////////////
 
+	/*
+	* Blueprint queries take optional category masks, matched against each component's Grid Categories.
+	* IncludeCategories of zero accepts any category, objects matching any of ExcludeCategories are always rejected.
+	*/
+
 	/*
 	* Gets all registered Sparse Grid objects in a Sphere Shape
 	*/
 	UFUNCTION(BlueprintCallable, Category = "Sparse Grid|Queries", meta = (DisplayName = "Query Grid [Sphere]", WorldContext = "WorldContextObject"))
-	static bool K2_GetComponents_Sphere(const UObject* WorldContextObject, TArray<UST_SparseGridComponent*>& GridComponents, const FVector& WorldLocation, const float SphereRadius, const bool bDrawDebug = false);
+	static bool K2_GetComponents_Sphere(const UObject* WorldContextObject, TArray<UST_SparseGridComponent*>& GridComponents, const FVector& WorldLocation, const float SphereRadius, UPARAM(meta = (Bitmask)) const int32 IncludeCategories = 0, UPARAM(meta = (Bitmask)) const int32 ExcludeCategories = 0, const bool bDrawDebug = false);
 
 	/*
 	* Gets all registered Sparse Grid objects in a Sphere Shape
 	*/
 	UFUNCTION(BlueprintCallable, Category = "Sparse Grid|Queries", meta = (DisplayName = "Query Grid [Capsule]", WorldContext = "WorldContextObject"))
-	static bool K2_GetComponents_Capsule(const UObject* WorldContextObject, TArray<UST_SparseGridComponent*>& GridComponents, const FVector& WorldLocation, const FVector& CapsuleAxis, const float CapsuleRadius, const float CapsuleHalfHeight, const bool bDrawDebug = false);
+	static bool K2_GetComponents_Capsule(const UObject* WorldContextObject, TArray<UST_SparseGridComponent*>& GridComponents, const FVector& WorldLocation, const FVector& CapsuleAxis, const float CapsuleRadius, const float CapsuleHalfHeight, UPARAM(meta = (Bitmask)) const int32 IncludeCategories = 0, UPARAM(meta = (Bitmask)) const int32 ExcludeCategories = 0, const bool bDrawDebug = false);
 
 	/*
 	* Gets all registered Sparse Grid objects in a AABB Box Shape
 	*/
 	UFUNCTION(BlueprintCallable, Category = "Sparse Grid|Queries", meta = (DisplayName = "Query Grid [AABB]", WorldContext = "WorldContextObject"))
-	static bool K2_GetComponents_Box(const UObject* WorldContextObject, TArray<UST_SparseGridComponent*>& GridComponents, const FVector& WorldLocation, const FVector& BoxExtents, const bool bDrawDebug = false);
+	static bool K2_GetComponents_Box(const UObject* WorldContextObject, TArray<UST_SparseGridComponent*>& GridComponents, const FVector& WorldLocation, const FVector& BoxExtents, UPARAM(meta = (Bitmask)) const int32 IncludeCategories = 0, UPARAM(meta = (Bitmask)) const int32 ExcludeCategories = 0, const bool bDrawDebug = false);
 
 	/*
 	* Gets all registered Sparse Grid objects in a Rotated Box Shape
 	*/
 	UFUNCTION(BlueprintCallable, Category = "Sparse Grid|Queries", meta = (DisplayName = "Query Grid [Box]", WorldContext = "WorldContextObject"))
-	static bool K2_GetComponents_RotatedBox(const UObject* WorldContextObject, TArray<UST_SparseGridComponent*>& GridComponents, const FVector& WorldLocation, const FRotator& BoxRotation, const FVector& BoxExtents, const bool bDrawDebug = false);
+	static bool K2_GetComponents_RotatedBox(const UObject* WorldContextObject, TArray<UST_SparseGridComponent*>& GridComponents, const FVector& WorldLocation, const FRotator& BoxRotation, const FVector& BoxExtents, UPARAM(meta = (Bitmask)) const int32 IncludeCategories = 0, UPARAM(meta = (Bitmask)) const int32 ExcludeCategories = 0, const bool bDrawDebug = false);
 
 	/*
 	* Gets all registered Sparse Grid objects in a Cone Shape
 	*/
 	UFUNCTION(BlueprintCallable, Category = "Sparse Grid|Queries", meta = (DisplayName = "Query Grid [Cone]", WorldContext = "WorldContextObject"))
-	static bool K2_GetComponents_Cone(const UObject* WorldContextObject, TArray<UST_SparseGridComponent*>& GridComponents, const FVector& WorldLocation, const float ConeLength, const float ConeHalfAngleRadians, const FVector& Axis, const bool bDrawDebug = false);
+	static bool K2_GetComponents_Cone(const UObject* WorldContextObject, TArray<UST_SparseGridComponent*>& GridComponents, const FVector& WorldLocation, const float ConeLength, const float ConeHalfAngleRadians, const FVector& Axis, UPARAM(meta = (Bitmask)) const int32 IncludeCategories = 0, UPARAM(meta = (Bitmask)) const int32 ExcludeCategories = 0, const bool bDrawDebug = false);
+
+	/*
+	* Gets the registered Sparse Grid object closest to a location
+	* MaxDistance is ignored if zero or less. If OwnerClass is set, only components whose owner is of that class are considered.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Sparse Grid|Queries", meta = (DisplayName = "Query Grid [Nearest]", WorldContext = "WorldContextObject"))
+	static UST_SparseGridComponent* K2_GetComponent_Nearest(const UObject* WorldContextObject, const FVector& WorldLocation, const float MaxDistance, const TSubclassOf<AActor> OwnerClass, UPARAM(meta = (Bitmask)) const int32 IncludeCategories = 0, UPARAM(meta = (Bitmask)) const int32 ExcludeCategories = 0, const bool bDrawDebug = false);
+
+	/*
+	* Gets up to K registered Sparse Grid objects closest to a location, sorted nearest first
+	* MaxDistance is ignored if zero or less. If OwnerClass is set, only components whose owner is of that class are considered.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Sparse Grid|Queries", meta = (DisplayName = "Query Grid [K-Nearest]", WorldContext = "WorldContextObject"))
+	static bool K2_GetComponents_KNearest(const UObject* WorldContextObject, TArray<UST_SparseGridComponent*>& GridComponents, const FVector& WorldLocation, const int32 K, const float MaxDistance, const TSubclassOf<AActor> OwnerClass, UPARAM(meta = (Bitmask)) const int32 IncludeCategories = 0, UPARAM(meta = (Bitmask)) const int32 ExcludeCategories = 0, const bool bDrawDebug = false);
 };
\ No newline at end of file
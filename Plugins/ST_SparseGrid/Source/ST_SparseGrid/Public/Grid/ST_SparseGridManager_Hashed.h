@@ -0,0 +1,102 @@
+// Copyright (C) James Baxter. All Rights Reserved.
+
+#pragma once
+
+#include "ST_SparseGridTypes.h"
+#include "ST_SparseGridManager.h"
+#include "ST_SparseGridManager_Hashed.generated.h"
+
+// Declarations
+class UST_SparseGridComponent;
+
+template<class T>
+class TST_SparseHashGrid;
+
+/*
+* Sparse Grid Manager Hashed
+* Sorts Components into a single unbounded hashed grid.
+*
+* Use this instead of the Basic manager for worlds too large to cover with a fixed number of cells.
+*/
+UCLASS(meta = (DisplayName = "Sparse Grid - Hashed"))
+class ST_SPARSEGRID_API UST_SparseGridManager_Hashed : public UST_SparseGridManager
+{
+	GENERATED_BODY()
+public:
+	// Constructor
+	UST_SparseGridManager_Hashed(const FObjectInitializer& OI);
+
+	/*
+	* Static Accessor.
+	*
+	* Tries to get the Manager Instance as a Sparse Grid - Hashed from world settings.
+	* Will return nullptr if the Instance does not exist.
+	*/
+	UFUNCTION(BlueprintPure, Category = "Sparse Grid|Hashed", meta = (CompactNodeTitle = "Sparse Grid - Hashed", DisplayName = "Sparse Grid - Hashed", Keywords = "Sparse Grid Hashed", HidePin = "WorldContextObject", DefaultToSelf = "WorldContextObject"))
+	static UST_SparseGridManager_Hashed* K2_Get(const UObject* WorldContextObject) { return Cast<UST_SparseGridManager_Hashed>(UST_SparseGridManager::Get(WorldContextObject)); }
+
+	// UST_SparseGridManager Interface
+	virtual void CreateGrids() override;
+	virtual void DestroyGrids() override;
+	virtual void UpdateGrids() override;
+	virtual bool RegisterGridComponent(UST_SparseGridComponent* InComponent) override;
+	virtual bool UnregisterGridComponent(UST_SparseGridComponent* InComponent) override;
+
+#if WITH_EDITOR
+	//////////////////
+	///// Editor /////
+	//////////////////
+public:
+	static const FName GRIDNAME_Hashed;
+
+	virtual bool GetGridNames(TArray<FName>& OutGridNames) const override;
+	virtual bool GetGridPopulationData(const FName InGridName, TArray<uint32>& OutData) const override;
+	virtual bool GetGridMemoryInfo(const FName InGridName, int32& OutTotalObjects, uint64& OutRegisterAllocSize, uint64& OutRegisterUsedSize, uint64& OutCellAllocSize, uint64& OutCellUsedSize) const override;
+#endif
+
+	/////////////////////
+	///// Grid Data /////
+	/////////////////////
+public:
+	/*
+	* Grid Data Accessor (C++ Only)
+	*/
+	TSharedRef<TST_SparseHashGrid<UST_SparseGridComponent>> GetSparseGrid_Hashed() const { return SparseGridData_Hashed.ToSharedRef(); }
+
+	/*
+	* Gets all objects currently registered in the grid
+	* Array cannot be modified
+	*/
+	UFUNCTION(BlueprintPure, Category = "Sparse Grid|Hashed", meta = (DisplayName = "Get All Sparse Grid Components"))
+	const TArray<UST_SparseGridComponent*>& GetGridComponents() const;
+
+	/*
+	* Number of cells currently holding components.
+	*/
+	UFUNCTION(BlueprintPure, Category = "Sparse Grid|Hashed", meta = (DisplayName = "Get Num Populated Cells"))
+	int32 K2_GetNumPopulatedCells() const;
+
+private:
+	TSharedPtr<TST_SparseHashGrid<UST_SparseGridComponent>> SparseGridData_Hashed;
+
+	/////////////////////////////
+	///// Blueprint Queries /////
+	/////////////////////////////
+
+	/*
+	* Blueprint queries take optional category masks, matched against each component's Grid Categories.
+	* IncludeCategories of zero accepts any category, objects matching any of ExcludeCategories are always rejected.
+	*/
+
+	/*
+	* Gets all registered Sparse Grid objects in a Sphere Shape
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Sparse Grid|Queries|Hashed", meta = (DisplayName = "Query Hashed Grid [Sphere]", WorldContext = "WorldContextObject"))
+	static bool K2_GetComponents_Sphere(const UObject* WorldContextObject, TArray<UST_SparseGridComponent*>& GridComponents, const FVector& WorldLocation, const float SphereRadius, UPARAM(meta = (Bitmask)) const int32 IncludeCategories = 0, UPARAM(meta = (Bitmask)) const int32 ExcludeCategories = 0, const bool bDrawDebug = false);
+
+	/*
+	* Gets all registered Sparse Grid objects in a AABB Box Shape
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Sparse Grid|Queries|Hashed", meta = (DisplayName = "Query Hashed Grid [AABB]", WorldContext = "WorldContextObject"))
+	static bool K2_GetComponents_Box(const UObject* WorldContextObject, TArray<UST_SparseGridComponent*>& GridComponents, const FVector& WorldLocation, const FVector& BoxExtents, UPARAM(meta = (Bitmask)) const int32 IncludeCategories = 0, UPARAM(meta = (Bitmask)) const int32 ExcludeCategories = 0, const bool bDrawDebug = false);
+};
\ No newline at end of file
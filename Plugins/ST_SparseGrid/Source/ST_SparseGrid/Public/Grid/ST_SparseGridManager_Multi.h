@@ -0,0 +1,150 @@
+// Copyright (C) James Baxter. All Rights Reserved.
+
+#pragma once
+
+#include "ST_SparseGridTypes.h"
+#include "ST_SparseGridManager.h"
+#include "ST_SparseGridManager_Multi.generated.h"
+
+// Declarations
+class UST_SparseGridComponent;
+
+/*
+* Sparse Grid Manager Multi
+* Sorts Components into several named sparse grids, each with its own cell size and allocation tuning.
+*
+* Components choose their grid with UST_SparseGridComponent::SetGridName(), and queries are routed to a grid by name.
+* Names without a grid of their own resolve to the default grid (the first grid in the data), for both registration and queries.
+*/
+UCLASS(meta = (DisplayName = "Sparse Grid - Multi"))
+class ST_SPARSEGRID_API UST_SparseGridManager_Multi : public UST_SparseGridManager
+{
+	GENERATED_BODY()
+public:
+	// Constructor
+	UST_SparseGridManager_Multi(const FObjectInitializer& OI);
+
+	/*
+	* Static Accessor.
+	*
+	* Tries to get the Manager Instance as a Sparse Grid - Multi from world settings.
+	* Will return nullptr if the Instance does not exist.
+	*/
+	UFUNCTION(BlueprintPure, Category = "Sparse Grid|Multi", meta = (CompactNodeTitle = "Sparse Grid - Multi", DisplayName = "Sparse Grid - Multi", Keywords = "Sparse Grid Multi", HidePin = "WorldContextObject", DefaultToSelf = "WorldContextObject"))
+	static UST_SparseGridManager_Multi* K2_Get(const UObject* WorldContextObject) { return Cast<UST_SparseGridManager_Multi>(UST_SparseGridManager::Get(WorldContextObject)); }
+
+	// UST_SparseGridManager Interface
+	virtual void CreateGrids() override;
+	virtual void DestroyGrids() override;
+	virtual void UpdateGrids() override;
+	virtual bool RegisterGridComponent(UST_SparseGridComponent* InComponent) override;
+	virtual bool UnregisterGridComponent(UST_SparseGridComponent* InComponent) override;
+	virtual void RegisterGridComponents(TArrayView<UST_SparseGridComponent* const> InComponents) override;
+	virtual void UnregisterLevelGridComponents(const ULevel* InLevel) override;
+	virtual void MarkGridComponentDirty(UST_SparseGridComponent* InComponent) override;
+
+#if WITH_EDITOR
+	//////////////////
+	///// Editor /////
+	//////////////////
+public:
+	virtual bool GetGridNames(TArray<FName>& OutGridNames) const override;
+	virtual bool GetGridPopulationData(const FName InGridName, TArray<uint32>& OutData) const override;
+	virtual bool GetGridMemoryInfo(const FName InGridName, int32& OutTotalObjects, uint64& OutRegisterAllocSize, uint64& OutRegisterUsedSize, uint64& OutCellAllocSize, uint64& OutCellUsedSize) const override;
+#endif
+
+	/////////////////////
+	///// Grid Data /////
+	/////////////////////
+public:
+	/*
+	* Grid Data Accessor (C++ Only)
+	* Unknown names resolve to the default grid.
+	*/
+	TSharedRef<TST_SparseGrid<UST_SparseGridComponent>> GetSparseGrid(const FName InGridName) const;
+
+	/*
+	* Name of the grid the given name resolves to.
+	*/
+	UFUNCTION(BlueprintPure, Category = "Sparse Grid|Multi")
+	FName ResolveGridName(const FName GridName) const;
+
+	/*
+	* Whether a grid of the given name exists, rather than resolving to the default grid.
+	*/
+	UFUNCTION(BlueprintPure, Category = "Sparse Grid|Multi")
+	bool HasGrid(const FName GridName) const { return SparseGrids.Contains(GridName); }
+
+	/*
+	* Name of the grid that unknown names resolve to.
+	*/
+	UFUNCTION(BlueprintPure, Category = "Sparse Grid|Multi")
+	FName GetDefaultGridName() const { return DefaultGridName; }
+
+	/*
+	* Gets all objects currently registered in the named grid
+	* Array cannot be modified
+	*/
+	UFUNCTION(BlueprintPure, Category = "Sparse Grid|Multi", meta = (DisplayName = "Get All Sparse Grid Components"))
+	const TArray<UST_SparseGridComponent*>& GetGridComponents(const FName GridName) const;
+
+private:
+	/*
+	* Grids by name
+	* Every grid covers the same world area, only cell size and allocation tuning differ.
+	*/
+	TMap<FName, TSharedPtr<TST_SparseGrid<UST_SparseGridComponent>>> SparseGrids;
+	FName DefaultGridName;
+
+	/////////////////////////////
+	///// Blueprint Queries /////
+	/////////////////////////////
+
+	/*
+	* Blueprint queries search the grid of the given name, see UST_SparseGridManager_Basic for the shape and category parameters.
+	*/
+
+	/*
+	* Gets all Sparse Grid objects registered with a named grid in a Sphere Shape
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Sparse Grid|Multi|Queries", meta = (DisplayName = "Query Named Grid [Sphere]", WorldContext = "WorldContextObject"))
+	static bool K2_GetComponents_Sphere(const UObject* WorldContextObject, const FName GridName, TArray<UST_SparseGridComponent*>& GridComponents, const FVector& WorldLocation, const float SphereRadius, UPARAM(meta = (Bitmask)) const int32 IncludeCategories = 0, UPARAM(meta = (Bitmask)) const int32 ExcludeCategories = 0, const bool bDrawDebug = false);
+
+	/*
+	* Gets all Sparse Grid objects registered with a named grid in a Capsule Shape
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Sparse Grid|Multi|Queries", meta = (DisplayName = "Query Named Grid [Capsule]", WorldContext = "WorldContextObject"))
+	static bool K2_GetComponents_Capsule(const UObject* WorldContextObject, const FName GridName, TArray<UST_SparseGridComponent*>& GridComponents, const FVector& WorldLocation, const FVector& CapsuleAxis, const float CapsuleRadius, const float CapsuleHalfHeight, UPARAM(meta = (Bitmask)) const int32 IncludeCategories = 0, UPARAM(meta = (Bitmask)) const int32 ExcludeCategories = 0, const bool bDrawDebug = false);
+
+	/*
+	* Gets all Sparse Grid objects registered with a named grid in a AABB Box Shape
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Sparse Grid|Multi|Queries", meta = (DisplayName = "Query Named Grid [AABB]", WorldContext = "WorldContextObject"))
+	static bool K2_GetComponents_Box(const UObject* WorldContextObject, const FName GridName, TArray<UST_SparseGridComponent*>& GridComponents, const FVector& WorldLocation, const FVector& BoxExtents, UPARAM(meta = (Bitmask)) const int32 IncludeCategories = 0, UPARAM(meta = (Bitmask)) const int32 ExcludeCategories = 0, const bool bDrawDebug = false);
+
+	/*
+	* Gets all Sparse Grid objects registered with a named grid in a Rotated Box Shape
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Sparse Grid|Multi|Queries", meta = (DisplayName = "Query Named Grid [Box]", WorldContext = "WorldContextObject"))
+	static bool K2_GetComponents_RotatedBox(const UObject* WorldContextObject, const FName GridName, TArray<UST_SparseGridComponent*>& GridComponents, const FVector& WorldLocation, const FRotator& BoxRotation, const FVector& BoxExtents, UPARAM(meta = (Bitmask)) const int32 IncludeCategories = 0, UPARAM(meta = (Bitmask)) const int32 ExcludeCategories = 0, const bool bDrawDebug = false);
+
+	/*
+	* Gets all Sparse Grid objects registered with a named grid in a Cone Shape
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Sparse Grid|Multi|Queries", meta = (DisplayName = "Query Named Grid [Cone]", WorldContext = "WorldContextObject"))
+	static bool K2_GetComponents_Cone(const UObject* WorldContextObject, const FName GridName, TArray<UST_SparseGridComponent*>& GridComponents, const FVector& WorldLocation, const float ConeLength, const float ConeHalfAngleRadians, const FVector& Axis, UPARAM(meta = (Bitmask)) const int32 IncludeCategories = 0, UPARAM(meta = (Bitmask)) const int32 ExcludeCategories = 0, const bool bDrawDebug = false);
+
+	/*
+	* Gets the Sparse Grid object registered with a named grid closest to a location
+	* MaxDistance is ignored if zero or less. If OwnerClass is set, only components whose owner is of that class are considered.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Sparse Grid|Multi|Queries", meta = (DisplayName = "Query Named Grid [Nearest]", WorldContext = "WorldContextObject"))
+	static UST_SparseGridComponent* K2_GetComponent_Nearest(const UObject* WorldContextObject, const FName GridName, const FVector& WorldLocation, const float MaxDistance, const TSubclassOf<AActor> OwnerClass, UPARAM(meta = (Bitmask)) const int32 IncludeCategories = 0, UPARAM(meta = (Bitmask)) const int32 ExcludeCategories = 0, const bool bDrawDebug = false);
+
+	/*
+	* Gets up to K Sparse Grid objects registered with a named grid closest to a location, sorted nearest first
+	* MaxDistance is ignored if zero or less. If OwnerClass is set, only components whose owner is of that class are considered.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Sparse Grid|Multi|Queries", meta = (DisplayName = "Query Named Grid [K-Nearest]", WorldContext = "WorldContextObject"))
+	static bool K2_GetComponents_KNearest(const UObject* WorldContextObject, const FName GridName, TArray<UST_SparseGridComponent*>& GridComponents, const FVector& WorldLocation, const int32 K, const float MaxDistance, const TSubclassOf<AActor> OwnerClass, UPARAM(meta = (Bitmask)) const int32 IncludeCategories = 0, UPARAM(meta = (Bitmask)) const int32 ExcludeCategories = 0, const bool bDrawDebug = false);
+};
\ No newline at end of file
@@ -0,0 +1,266 @@
+// Copyright (C) James Baxter. All Rights Reserved.
+
+#pragma once
+
+#include "ST_SparseGridTypes.h"
+#include "ST_SparseGridKernels.h"
+
+// Required
+#include "Misc/MemStack.h"
+
+#if SPARSE_GRID_DEBUG
+/*
+* Debug drawing parameters for a grid query, expects GetGridWorld() to be in scope.
+*/
+#define GATHER_DEBUG_PARAMETERS																									\
+	const UWorld* DebugWorld = GetGridWorld();																					\
+	check(DebugWorld);																											\
+	const float DrawQueryTime = ST_SparseGridCVars::CVarQueryDebugTime.GetValueOnAnyThread();									\
+	const float DrawQueryThickness = ST_SparseGridCVars::CVarDebugGridThickness.GetValueOnAnyThread();
+#endif
+
+/////////////////////////////////
+///// Sparse Grid Query API /////
+/////////////////////////////////
+
+/*
+* Query API shared by every grid type.
+*
+* A grid implements the filtered shape queries, QueryGrid_Sphere/Capsule/Box/RotatedBox/Cone(OutputType&, ..., InFilter, bDrawDebug),
+* and inherits the unfiltered, fixed-capacity and visitor versions of each from here.
+* Since a grid declaring its own QueryGrid_*() hides these overloads, it must bring them back with a using-declaration.
+*/
+template<class T, class GridType>
+class TST_SparseGridQueries
+{
+public:
+	/*
+	* Scratch Results
+	* Query results allocated from the calling thread's frame-linear FMemStack, rather than the heap.
+	* Results are only valid until the caller's FMemMark goes out of scope, e.g:
+	*
+	*	FMemMark Mark(FMemStack::Get());
+	*	TST_SparseGrid<T>::FScratchResults Results;
+	*	Grid->QueryGrid_Sphere(Results, Location, Radius);
+	*/
+	typedef TArray<T*, TMemStackAllocator<>> FScratchResults;
+
+	/*
+	* Unfiltered Queries
+	* Return every object in the shape, whatever its categories.
+	*/
+	template<class OutputType>
+	FORCEINLINE void QueryGrid_Sphere(OutputType& OutObjects, const FVector& InWorldLocation, const float InSphereRadius, bool bDrawDebug = false) const
+	{
+		AsGrid().QueryGrid_Sphere(OutObjects, InWorldLocation, InSphereRadius, FST_SparseGridCategoryFilter(), bDrawDebug);
+	}
+
+	template<class OutputType>
+	FORCEINLINE void QueryGrid_Capsule(OutputType& OutObjects, const FVector& InWorldLocation, const FVector& InUpAxis, float InCapsuleRadius, float InCapsuleHalfHeight, bool bDrawDebug = false) const
+	{
+		AsGrid().QueryGrid_Capsule(OutObjects, InWorldLocation, InUpAxis, InCapsuleRadius, InCapsuleHalfHeight, FST_SparseGridCategoryFilter(), bDrawDebug);
+	}
+
+	template<class OutputType>
+	FORCEINLINE void QueryGrid_Box(OutputType& OutObjects, const FVector& InWorldLocation, const FVector& InBoxExtents, bool bDrawDebug = false) const
+	{
+		AsGrid().QueryGrid_Box(OutObjects, InWorldLocation, InBoxExtents, FST_SparseGridCategoryFilter(), bDrawDebug);
+	}
+
+	template<class OutputType>
+	FORCEINLINE void QueryGrid_RotatedBox(OutputType& OutObjects, const FVector& InWorldLocation, const FQuat& InBoxRotation, const FVector& InBoxExtents, bool bDrawDebug = false) const
+	{
+		AsGrid().QueryGrid_RotatedBox(OutObjects, InWorldLocation, InBoxRotation, InBoxExtents, FST_SparseGridCategoryFilter(), bDrawDebug);
+	}
+
+	template<class OutputType>
+	FORCEINLINE void QueryGrid_Cone(OutputType& OutObjects, const FVector& InWorldLocation, const float InConeLength, const float InConeHalfAngleRadians, const FVector& InAxis, bool bDrawDebug = false) const
+	{
+		AsGrid().QueryGrid_Cone(OutObjects, InWorldLocation, InConeLength, InConeHalfAngleRadians, InAxis, FST_SparseGridCategoryFilter(), bDrawDebug);
+	}
+
+	/*
+	* Fixed-Capacity Queries
+	* Write into caller-provided storage without allocating, and return a view of the results.
+	* Results that do not fit are handled according to InOverflow.
+	*/
+	TArrayView<T*> QueryGrid_Sphere(const TArrayView<T*> OutBuffer, const EST_SparseGridOverflow InOverflow, const FVector& InWorldLocation, const float InSphereRadius, const FST_SparseGridCategoryFilter& InFilter, const bool bDrawDebug = false) const
+	{
+		TST_SparseGridResultSpan<T> Results = TST_SparseGridResultSpan<T>(OutBuffer, InOverflow);
+		AsGrid().QueryGrid_Sphere(Results, InWorldLocation, InSphereRadius, InFilter, bDrawDebug);
+		return Results.GetView();
+	}
+
+	TArrayView<T*> QueryGrid_Sphere(const TArrayView<T*> OutBuffer, const EST_SparseGridOverflow InOverflow, const FVector& InWorldLocation, const float InSphereRadius, const bool bDrawDebug = false) const
+	{
+		return QueryGrid_Sphere(OutBuffer, InOverflow, InWorldLocation, InSphereRadius, FST_SparseGridCategoryFilter(), bDrawDebug);
+	}
+
+	TArrayView<T*> QueryGrid_Capsule(const TArrayView<T*> OutBuffer, const EST_SparseGridOverflow InOverflow, const FVector& InWorldLocation, const FVector& InUpAxis, const float InCapsuleRadius, const float InCapsuleHalfHeight, const FST_SparseGridCategoryFilter& InFilter, const bool bDrawDebug = false) const
+	{
+		TST_SparseGridResultSpan<T> Results = TST_SparseGridResultSpan<T>(OutBuffer, InOverflow);
+		AsGrid().QueryGrid_Capsule(Results, InWorldLocation, InUpAxis, InCapsuleRadius, InCapsuleHalfHeight, InFilter, bDrawDebug);
+		return Results.GetView();
+	}
+
+	TArrayView<T*> QueryGrid_Capsule(const TArrayView<T*> OutBuffer, const EST_SparseGridOverflow InOverflow, const FVector& InWorldLocation, const FVector& InUpAxis, const float InCapsuleRadius, const float InCapsuleHalfHeight, const bool bDrawDebug = false) const
+	{
+		return QueryGrid_Capsule(OutBuffer, InOverflow, InWorldLocation, InUpAxis, InCapsuleRadius, InCapsuleHalfHeight, FST_SparseGridCategoryFilter(), bDrawDebug);
+	}
+
+	TArrayView<T*> QueryGrid_Box(const TArrayView<T*> OutBuffer, const EST_SparseGridOverflow InOverflow, const FVector& InWorldLocation, const FVector& InBoxExtents, const FST_SparseGridCategoryFilter& InFilter, const bool bDrawDebug = false) const
+	{
+		TST_SparseGridResultSpan<T> Results = TST_SparseGridResultSpan<T>(OutBuffer, InOverflow);
+		AsGrid().QueryGrid_Box(Results, InWorldLocation, InBoxExtents, InFilter, bDrawDebug);
+		return Results.GetView();
+	}
+
+	TArrayView<T*> QueryGrid_Box(const TArrayView<T*> OutBuffer, const EST_SparseGridOverflow InOverflow, const FVector& InWorldLocation, const FVector& InBoxExtents, const bool bDrawDebug = false) const
+	{
+		return QueryGrid_Box(OutBuffer, InOverflow, InWorldLocation, InBoxExtents, FST_SparseGridCategoryFilter(), bDrawDebug);
+	}
+
+	TArrayView<T*> QueryGrid_RotatedBox(const TArrayView<T*> OutBuffer, const EST_SparseGridOverflow InOverflow, const FVector& InWorldLocation, const FQuat& InBoxRotation, const FVector& InBoxExtents, const FST_SparseGridCategoryFilter& InFilter, const bool bDrawDebug = false) const
+	{
+		TST_SparseGridResultSpan<T> Results = TST_SparseGridResultSpan<T>(OutBuffer, InOverflow);
+		AsGrid().QueryGrid_RotatedBox(Results, InWorldLocation, InBoxRotation, InBoxExtents, InFilter, bDrawDebug);
+		return Results.GetView();
+	}
+
+	TArrayView<T*> QueryGrid_RotatedBox(const TArrayView<T*> OutBuffer, const EST_SparseGridOverflow InOverflow, const FVector& InWorldLocation, const FQuat& InBoxRotation, const FVector& InBoxExtents, const bool bDrawDebug = false) const
+	{
+		return QueryGrid_RotatedBox(OutBuffer, InOverflow, InWorldLocation, InBoxRotation, InBoxExtents, FST_SparseGridCategoryFilter(), bDrawDebug);
+	}
+
+	TArrayView<T*> QueryGrid_Cone(const TArrayView<T*> OutBuffer, const EST_SparseGridOverflow InOverflow, const FVector& InWorldLocation, const float InConeLength, const float InConeHalfAngleRadians, const FVector& InAxis, const FST_SparseGridCategoryFilter& InFilter, const bool bDrawDebug = false) const
+	{
+		TST_SparseGridResultSpan<T> Results = TST_SparseGridResultSpan<T>(OutBuffer, InOverflow);
+		AsGrid().QueryGrid_Cone(Results, InWorldLocation, InConeLength, InConeHalfAngleRadians, InAxis, InFilter, bDrawDebug);
+		return Results.GetView();
+	}
+
+	TArrayView<T*> QueryGrid_Cone(const TArrayView<T*> OutBuffer, const EST_SparseGridOverflow InOverflow, const FVector& InWorldLocation, const float InConeLength, const float InConeHalfAngleRadians, const FVector& InAxis, const bool bDrawDebug = false) const
+	{
+		return QueryGrid_Cone(OutBuffer, InOverflow, InWorldLocation, InConeLength, InConeHalfAngleRadians, InAxis, FST_SparseGridCategoryFilter(), bDrawDebug);
+	}
+
+	/*
+	* Visitor Queries
+	* Call InFunc(T*) for each object in the shape, without storing results. InFunc returns EST_SparseGridVisitResult::Stop
+	* to end the query, in which case no further cells are walked.
+	* InFunc runs under the grid's read lock and must not modify this grid or query it again, see TST_SparseGrid's threading contract.
+	* Return true if the visitor stopped the query early.
+	*/
+	template<class FuncType>
+	bool ForEachInSphere(const FVector& InWorldLocation, const float InSphereRadius, const FST_SparseGridCategoryFilter& InFilter, FuncType&& InFunc) const
+	{
+		TST_SparseGridVisitor<T, FuncType> Visitor = TST_SparseGridVisitor<T, FuncType>(InFunc, &AsGrid());
+		AsGrid().QueryGrid_Sphere(Visitor, InWorldLocation, InSphereRadius, InFilter);
+		return Visitor.IsStopped();
+	}
+
+	template<class FuncType>
+	FORCEINLINE bool ForEachInSphere(const FVector& InWorldLocation, const float InSphereRadius, FuncType&& InFunc) const
+	{
+		return ForEachInSphere(InWorldLocation, InSphereRadius, FST_SparseGridCategoryFilter(), Forward<FuncType>(InFunc));
+	}
+
+	template<class FuncType>
+	bool ForEachInCapsule(const FVector& InWorldLocation, const FVector& InUpAxis, const float InCapsuleRadius, const float InCapsuleHalfHeight, const FST_SparseGridCategoryFilter& InFilter, FuncType&& InFunc) const
+	{
+		TST_SparseGridVisitor<T, FuncType> Visitor = TST_SparseGridVisitor<T, FuncType>(InFunc, &AsGrid());
+		AsGrid().QueryGrid_Capsule(Visitor, InWorldLocation, InUpAxis, InCapsuleRadius, InCapsuleHalfHeight, InFilter);
+		return Visitor.IsStopped();
+	}
+
+	template<class FuncType>
+	FORCEINLINE bool ForEachInCapsule(const FVector& InWorldLocation, const FVector& InUpAxis, const float InCapsuleRadius, const float InCapsuleHalfHeight, FuncType&& InFunc) const
+	{
+		return ForEachInCapsule(InWorldLocation, InUpAxis, InCapsuleRadius, InCapsuleHalfHeight, FST_SparseGridCategoryFilter(), Forward<FuncType>(InFunc));
+	}
+
+	template<class FuncType>
+	bool ForEachInBox(const FVector& InWorldLocation, const FVector& InBoxExtents, const FST_SparseGridCategoryFilter& InFilter, FuncType&& InFunc) const
+	{
+		TST_SparseGridVisitor<T, FuncType> Visitor = TST_SparseGridVisitor<T, FuncType>(InFunc, &AsGrid());
+		AsGrid().QueryGrid_Box(Visitor, InWorldLocation, InBoxExtents, InFilter);
+		return Visitor.IsStopped();
+	}
+
+	template<class FuncType>
+	FORCEINLINE bool ForEachInBox(const FVector& InWorldLocation, const FVector& InBoxExtents, FuncType&& InFunc) const
+	{
+		return ForEachInBox(InWorldLocation, InBoxExtents, FST_SparseGridCategoryFilter(), Forward<FuncType>(InFunc));
+	}
+
+	template<class FuncType>
+	bool ForEachInRotatedBox(const FVector& InWorldLocation, const FQuat& InBoxRotation, const FVector& InBoxExtents, const FST_SparseGridCategoryFilter& InFilter, FuncType&& InFunc) const
+	{
+		TST_SparseGridVisitor<T, FuncType> Visitor = TST_SparseGridVisitor<T, FuncType>(InFunc, &AsGrid());
+		AsGrid().QueryGrid_RotatedBox(Visitor, InWorldLocation, InBoxRotation, InBoxExtents, InFilter);
+		return Visitor.IsStopped();
+	}
+
+	template<class FuncType>
+	FORCEINLINE bool ForEachInRotatedBox(const FVector& InWorldLocation, const FQuat& InBoxRotation, const FVector& InBoxExtents, FuncType&& InFunc) const
+	{
+		return ForEachInRotatedBox(InWorldLocation, InBoxRotation, InBoxExtents, FST_SparseGridCategoryFilter(), Forward<FuncType>(InFunc));
+	}
+
+	template<class FuncType>
+	bool ForEachInCone(const FVector& InWorldLocation, const float InConeLength, const float InConeHalfAngleRadians, const FVector& InAxis, const FST_SparseGridCategoryFilter& InFilter, FuncType&& InFunc) const
+	{
+		TST_SparseGridVisitor<T, FuncType> Visitor = TST_SparseGridVisitor<T, FuncType>(InFunc, &AsGrid());
+		AsGrid().QueryGrid_Cone(Visitor, InWorldLocation, InConeLength, InConeHalfAngleRadians, InAxis, InFilter);
+		return Visitor.IsStopped();
+	}
+
+	template<class FuncType>
+	FORCEINLINE bool ForEachInCone(const FVector& InWorldLocation, const float InConeLength, const float InConeHalfAngleRadians, const FVector& InAxis, FuncType&& InFunc) const
+	{
+		return ForEachInCone(InWorldLocation, InConeLength, InConeHalfAngleRadians, InAxis, FST_SparseGridCategoryFilter(), Forward<FuncType>(InFunc));
+	}
+
+	/*
+	* Number of objects in a sphere, optionally only those passing InPredicate.
+	*/
+	template<class PredicateType>
+	int32 CountInSphere(const FVector& InWorldLocation, const float InSphereRadius, const PredicateType& InPredicate) const
+	{
+		int32 Count = 0;
+		ForEachInSphere(InWorldLocation, InSphereRadius, [&Count, &InPredicate](T* InObject)
+		{
+			Count += InPredicate(InObject) ? 1 : 0;
+			return EST_SparseGridVisitResult::Continue;
+		});
+
+		return Count;
+	}
+
+	int32 CountInSphere(const FVector& InWorldLocation, const float InSphereRadius) const
+	{
+		return CountInSphere(InWorldLocation, InSphereRadius, [](const T* InObject) { return true; });
+	}
+
+	/*
+	* Whether any object is in a sphere, optionally only those passing InPredicate.
+	* Stops at the first match.
+	*/
+	template<class PredicateType>
+	bool AnyInSphere(const FVector& InWorldLocation, const float InSphereRadius, const PredicateType& InPredicate) const
+	{
+		return ForEachInSphere(InWorldLocation, InSphereRadius, [&InPredicate](T* InObject)
+		{
+			return InPredicate(InObject) ? EST_SparseGridVisitResult::Stop : EST_SparseGridVisitResult::Continue;
+		});
+	}
+
+	bool AnyInSphere(const FVector& InWorldLocation, const float InSphereRadius) const
+	{
+		return AnyInSphere(InWorldLocation, InSphereRadius, [](const T* InObject) { return true; });
+	}
+
+protected:
+	FORCEINLINE const GridType& AsGrid() const { return static_cast<const GridType&>(*this); }
+	FORCEINLINE GridType& AsGrid() { return static_cast<GridType&>(*this); }
+};
\ No newline at end of file
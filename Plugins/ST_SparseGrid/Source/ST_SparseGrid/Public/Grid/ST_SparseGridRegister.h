@@ -0,0 +1,249 @@
+// Copyright (C) James Baxter. All Rights Reserved.
+
+#pragma once
+
+#include "ST_SparseGrid.h"
+
+////////////////////////////////////
+///// Sparse Grid Registration /////
+////////////////////////////////////
+
+/*
+* Object register for grids that re-bucket every object serially in Update(), see TST_SparseHashGrid and TST_SparseGrid3D.
+* Owns the registered objects, the grid lock and the object bounds, and implements Add(), Remove(), Init() and Empty().
+*
+* The grid places objects in its cells through three hooks, all called with the write lock held:
+*
+*	void RegisterInCell(T* InObject, const FVector& InWorldPosition)	- Adds a newly registered object to its cell
+*	void UnregisterFromCell(T* InObject)								- Removes an object from its current cell
+*	void EmptyCells()													- Releases every cell, object grid data is cleared afterwards
+*/
+template<class T, class GridType>
+class TST_SparseGridRegister : public TST_SparseGridQueries<T, GridType>
+{
+	//////////////////////
+	////// Lifecycle /////
+	//////////////////////
+protected:
+	// Constructor
+	TST_SparseGridRegister(const UWorld* InGridWorld, const int32 InRegisterAllocSize, const int32 InRegisterShrinkMultiplier)
+		: GridWorld(InGridWorld)
+		, RegisterAllocSize(InRegisterAllocSize)
+		, RegisterAllocShrinkMultiplier(InRegisterShrinkMultiplier)
+	{}
+
+	//////////////////////////////
+	///// Grid Functionality /////
+	//////////////////////////////
+public:
+	FORCEINLINE int32 GetUpdateEpoch() const { return UpdateEpoch.GetValue(); }
+
+	/*
+	* Registers an object with the grid.
+	* Returns true if successfully registered (or already registered)
+	*/
+	bool Add(T* InObject)
+	{
+		SPARSE_GRID_CHECK_NOT_VISITING();
+		FRWScopeLock WriteLock(GridLock, SLT_Write);
+		return Add_Unlocked(InObject);
+	}
+
+	/*
+	* Unregisters an object with the grid.
+	* Returns true if successfully unregistered (or already unregistered)
+	*/
+	bool Remove(T* InObject)
+	{
+		SPARSE_GRID_CHECK_NOT_VISITING();
+		FRWScopeLock WriteLock(GridLock, SLT_Write);
+		return Remove_Unlocked(InObject);
+	}
+
+	/*
+	* Initializes the grid with all grid objects in it's assigned world
+	* This function is expensive, do not use it often.
+	*/
+	void Init(const bool bAllowChildClasses = false)
+	{
+		const UWorld* lWorld = GetGridWorld();
+		check(lWorld);
+
+		SPARSE_GRID_CHECK_NOT_VISITING();
+		FRWScopeLock WriteLock(GridLock, SLT_Write);
+
+		TST_SparseGridWorldObjects<T>::ForEach(lWorld, [this, bAllowChildClasses](T* ObjectItr)
+		{
+			if (!ObjectItr || ObjectItr->IsPendingKillOrUnreachable())
+			{
+				return;
+			}
+
+			if (!bAllowChildClasses && ExactCast<T>(ObjectItr) == nullptr)
+			{
+				return;
+			}
+
+			if (ObjectItr->GetSparseGridData().IsClear())
+			{
+				Add_Unlocked(ObjectItr);
+			}
+		});
+	}
+
+	/*
+	* Unregisters all registered objects, and empties all cells.
+	*/
+	void Empty()
+	{
+		SPARSE_GRID_CHECK_NOT_VISITING();
+		FRWScopeLock WriteLock(GridLock, SLT_Write);
+
+		this->AsGrid().EmptyCells();
+
+		for (T* ObjectItr : RegisteredObjects)
+		{
+			checkSlow(ObjectItr != nullptr);
+
+			ObjectItr->AccessSparseGridData().SetGridIndex(INDEX_NONE);
+			ObjectItr->AccessSparseGridData().SetCellIndex(INDEX_NONE);
+			ObjectItr->AccessSparseGridData().SetCellSubIndex(INDEX_NONE);
+		}
+
+		RegisteredObjects.Empty();
+
+#if ENABLE_GRID_BOUNDS
+		ObjectBounds = FST_SparseGridBounds();
+#endif
+	}
+
+	FORCEINLINE bool IsRegistered(const T* InObject) const
+	{
+		const int32 GridIndex = InObject->GetSparseGridData().GetGridIndex();
+		return RegisteredObjects.IsValidIndex(GridIndex) && RegisteredObjects[GridIndex] == InObject;
+	}
+
+protected:
+	bool Add_Unlocked(T* InObject)
+	{
+		checkf(InObject != nullptr, TEXT("Invalid Object!"));
+		checkf(InObject->GetWorld() == GetGridWorld(), TEXT("Invalid Object World!"));
+
+		if (InObject->GetSparseGridData().IsValid())
+		{
+			if (IsRegistered(InObject))
+			{
+				UE_LOG(LogST_SparseGrid, Verbose, TEXT("'%s' is already registered!"), *GetNameSafe(InObject));
+				return true;
+			}
+
+			UE_LOG(LogST_SparseGrid, Warning, TEXT("'%s' is already registered in another grid!"), *GetNameSafe(InObject));
+			return false;
+		}
+
+		UE_LOG(LogST_SparseGrid, VeryVerbose, TEXT("Registering Sparse Grid Object: '%s'"), *GetNameSafe(InObject));
+
+		// Grow Array if Required
+		if (RegisteredObjects.GetSlack() <= 0)
+		{
+			RegisteredObjects.Reserve(RegisteredObjects.Max() + RegisterAllocSize);
+		}
+
+		InObject->AccessSparseGridData().SetGridIndex(RegisteredObjects.Add(InObject));
+
+		const FVector WorldPosition = InObject->GetSparseGridLocation();
+		this->AsGrid().RegisterInCell(InObject, WorldPosition);
+
+#if ENABLE_GRID_BOUNDS
+		ObjectBounds.Update(WorldPosition);
+#endif
+
+		return true;
+	}
+
+	bool Remove_Unlocked(T* InObject)
+	{
+		checkf(InObject != nullptr, TEXT("Invalid Object!"));
+
+		if (InObject->GetSparseGridData().IsClear())
+		{
+			UE_LOG(LogST_SparseGrid, Verbose, TEXT("'%s' is not registered!"), *GetNameSafe(InObject));
+			return true;
+		}
+
+		if (!IsRegistered(InObject))
+		{
+			UE_LOG(LogST_SparseGrid, Warning, TEXT("'%s' is registered in another grid - cannot unregister!"), *GetNameSafe(InObject));
+			return false;
+		}
+
+		UE_LOG(LogST_SparseGrid, VeryVerbose, TEXT("Unregistering Sparse Grid Object: '%s'"), *GetNameSafe(InObject));
+
+		this->AsGrid().UnregisterFromCell(InObject);
+
+		const int32 GridIndex = InObject->GetSparseGridData().GetGridIndex();
+		RegisteredObjects.RemoveAtSwap(GridIndex, 1, false);
+		if (RegisteredObjects.IsValidIndex(GridIndex))
+		{
+			RegisteredObjects[GridIndex]->AccessSparseGridData().SetGridIndex(GridIndex);
+		}
+
+		InObject->AccessSparseGridData().SetGridIndex(INDEX_NONE);
+
+		// Shrink if required
+		const int32 Slack = RegisteredObjects.GetSlack();
+		if (RegisterAllocShrinkMultiplier >= 0 && Slack % RegisterAllocSize == 0 && Slack > RegisterAllocSize * RegisterAllocShrinkMultiplier)
+		{
+			RegisteredObjects.Shrink();
+		}
+
+		return true;
+	}
+
+	//////////////////////
+	///// Properties /////
+	//////////////////////
+public:
+	FORCEINLINE const UWorld* GetGridWorld() const { return GridWorld.Get(); }
+	FORCEINLINE const TArray<T*>& GetRegisteredObjects() const { return RegisteredObjects; }
+
+#if ENABLE_GRID_BOUNDS
+	FORCEINLINE const FST_SparseGridBounds& GetObjectBounds() const { return ObjectBounds; }
+#endif
+
+protected:
+	TWeakObjectPtr<const UWorld> GridWorld;
+
+	// See TST_SparseGrid
+	mutable FRWLock GridLock;
+	FThreadSafeCounter UpdateEpoch;
+
+	TArray<T*> RegisteredObjects;
+
+#if ENABLE_GRID_BOUNDS
+	FST_SparseGridBounds ObjectBounds;
+#endif
+
+	/////////////////////////////
+	///// Memory Management /////
+	/////////////////////////////
+private:
+	int32 RegisterAllocSize;
+	int32 RegisterAllocShrinkMultiplier;
+
+#if WITH_EDITOR
+	//////////////////
+	///// Editor /////
+	//////////////////
+protected:
+	/*
+	* Register half of the grid's GetEditorDebugInfo(), expects the read lock to be held.
+	*/
+	void GetRegisterMemoryInfo(int32& OutTotalObjects, uint64& OutRegisterAlloc, uint64& OutRegisterUsed) const
+	{
+		OutTotalObjects = RegisteredObjects.Num();
+		OutRegisterAlloc = sizeof(void*) * RegisteredObjects.Max();
+		OutRegisterUsed = sizeof(void*) * RegisteredObjects.Num();
+	}
+#endif
+};
\ No newline at end of file
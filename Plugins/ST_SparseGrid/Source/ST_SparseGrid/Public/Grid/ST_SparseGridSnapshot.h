@@ -0,0 +1,253 @@
+// Copyright (C) James Baxter. All Rights Reserved.
+
+#pragma once
+
+#include "ST_SparseGridTypes.h"
+#include "ST_SparseGridKernels.h"
+
+// Forward-Declarations
+template<class T>
+class TST_SparseGrid;
+
+////////////////////////////////
+///// Sparse Grid Snapshot /////
+////////////////////////////////
+
+/*
+* Immutable copy of a sparse grid, taken at the end of TST_SparseGrid::Update().
+*
+* Cell contents are flattened in cell order, so the objects in a cell are the range [CellOffsets[i], CellOffsets[i + 1]).
+* Snapshots are shared via thread-safe shared pointers - background jobs can hold one for as long as they need,
+* while the grid carries on updating into another buffer.
+*
+* Snapshots hold raw object pointers. Objects may be destroyed after the snapshot was taken, so results should be
+* validated on the game thread before being dereferenced.
+*/
+template<class T>
+class TST_SparseGridSnapshot
+{
+public:
+	TST_SparseGridSnapshot()
+		: FrameNumber(0)
+		, UpdateEpoch(INDEX_NONE)
+		, GridOrigin(FST_GridRef2D(0))
+		, NumCells(FST_GridRef2D(0))
+		, CellSize(1)
+	{}
+
+	//////////////////////
+	///// Properties /////
+	//////////////////////
+public:
+	// Engine frame number the snapshot was published on
+	FORCEINLINE uint64 GetFrameNumber() const { return FrameNumber; }
+
+	// Grid update epoch the snapshot was published on
+	FORCEINLINE int32 GetUpdateEpoch() const { return UpdateEpoch; }
+
+	FORCEINLINE FST_GridRef2D GetGridOrigin() const { return GridOrigin; }
+	FORCEINLINE FST_GridRef2D GetNumCells() const { return NumCells; }
+	FORCEINLINE int32 GetCellSize() const { return CellSize; }
+	FORCEINLINE FST_GridRef2D GetGridMax() const { return GridOrigin + (NumCells * CellSize); }
+
+	// All objects, in cell order
+	FORCEINLINE const TArray<T*>& GetObjects() const { return Objects; }
+
+	FORCEINLINE int32 GetCellIndex(const FST_GridRef2D& CellXY) const
+	{
+		return CellXY.Y + CellXY.X * NumCells.Y;
+	}
+
+	FORCEINLINE TArrayView<T* const> GetCellObjects(const int32 CellIndex) const
+	{
+		checkSlow(CellOffsets.IsValidIndex(CellIndex + 1));
+		return TArrayView<T* const>(Objects.GetData() + CellOffsets[CellIndex], CellOffsets[CellIndex + 1] - CellOffsets[CellIndex]);
+	}
+
+	/*
+	* Tile of cells overlapping a world-space search area.
+	* Matches TST_SparseGrid::GetSearchTile(), searches outside the grid are clamped to the boundary cells.
+	*/
+	FST_SparseGridCellTile GetSearchTile(const FVector2D& WorldSearchOrigin, const FVector2D& WorldSearchExtents) const
+	{
+		const FST_GridRef2D GridMax = GetGridMax();
+		const FVector2D SearchBoundsMin = FVector2D(
+			FMath::Clamp<float>(WorldSearchOrigin.X - WorldSearchExtents.X, GridOrigin.X, GridMax.X),
+			FMath::Clamp<float>(WorldSearchOrigin.Y - WorldSearchExtents.Y, GridOrigin.Y, GridMax.Y)) - GridOrigin.ToVector();
+		const FVector2D SearchBoundsMax = FVector2D(
+			FMath::Clamp<float>(WorldSearchOrigin.X + WorldSearchExtents.X, GridOrigin.X, GridMax.X),
+			FMath::Clamp<float>(WorldSearchOrigin.Y + WorldSearchExtents.Y, GridOrigin.Y, GridMax.Y)) - GridOrigin.ToVector();
+
+		return FST_SparseGridCellTile(
+			FST_GridRef2D(
+				FMath::Clamp(FMath::FloorToInt(SearchBoundsMin.X / CellSize), 0, NumCells.X - 1),
+				FMath::Clamp(FMath::FloorToInt(SearchBoundsMin.Y / CellSize), 0, NumCells.Y - 1)),
+			FST_GridRef2D(
+				FMath::Clamp(FMath::CeilToInt(SearchBoundsMax.X / CellSize), 1, NumCells.X),
+				FMath::Clamp(FMath::CeilToInt(SearchBoundsMax.Y / CellSize), 1, NumCells.Y)));
+	}
+
+	//////////////////////////
+	///// Search Queries /////
+	//////////////////////////
+public:
+	/*
+	* Shape queries against the snapshot, matching the TST_SparseGrid equivalents.
+	* Each optionally takes a category filter, tested against the masks copied with the positions.
+	*/
+	template<class AllocatorType>
+	void QueryGrid_Sphere(TArray<T*, AllocatorType>& OutObjects, const FVector& InWorldLocation, const float InSphereRadius, const FST_SparseGridCategoryFilter& InFilter = FST_SparseGridCategoryFilter()) const
+	{
+		QueryCells(OutObjects, InWorldLocation, FVector(InSphereRadius), FST_SparseGridKernel_Sphere(InWorldLocation, InSphereRadius), InFilter);
+	}
+
+	template<class AllocatorType>
+	void QueryGrid_Capsule(TArray<T*, AllocatorType>& OutObjects, const FVector& InWorldLocation, const FVector& InUpAxis, float InCapsuleRadius, float InCapsuleHalfHeight, const FST_SparseGridCategoryFilter& InFilter = FST_SparseGridCategoryFilter()) const
+	{
+		InCapsuleHalfHeight = FMath::Max3(0.f, InCapsuleHalfHeight, InCapsuleRadius);
+		InCapsuleRadius = FMath::Clamp(InCapsuleRadius, 0.f, InCapsuleHalfHeight);
+
+		const FVector Dir = InUpAxis * (InCapsuleHalfHeight - InCapsuleRadius);
+		const FVector Extents = Dir.GetAbs() + FVector(InCapsuleRadius);
+
+		QueryCells(OutObjects, InWorldLocation, Extents, FST_SparseGridKernel_Capsule(InWorldLocation + Dir, InWorldLocation - Dir, InCapsuleRadius), InFilter);
+	}
+
+	template<class AllocatorType>
+	void QueryGrid_Box(TArray<T*, AllocatorType>& OutObjects, const FVector& InWorldLocation, const FVector& InBoxExtents, const FST_SparseGridCategoryFilter& InFilter = FST_SparseGridCategoryFilter()) const
+	{
+		QueryCells(OutObjects, InWorldLocation, InBoxExtents, FST_SparseGridKernel_Box(InWorldLocation, InBoxExtents), InFilter);
+	}
+
+	template<class AllocatorType>
+	void QueryGrid_RotatedBox(TArray<T*, AllocatorType>& OutObjects, const FVector& InWorldLocation, const FQuat& InBoxRotation, const FVector& InBoxExtents, const FST_SparseGridCategoryFilter& InFilter = FST_SparseGridCategoryFilter()) const
+	{
+		const FBoxSphereBounds AABB = FBoxSphereBounds(FBox(-InBoxExtents, InBoxExtents)).TransformBy(FTransform(InBoxRotation, InWorldLocation));
+
+		QueryCells(OutObjects, InWorldLocation, AABB.BoxExtent, FST_SparseGridKernel_RotatedBox(InWorldLocation, InBoxRotation, InBoxExtents), InFilter);
+	}
+
+	template<class AllocatorType>
+	void QueryGrid_Cone(TArray<T*, AllocatorType>& OutObjects, const FVector& InWorldLocation, const float InConeLength, const float InConeHalfAngleRadians, const FVector& InAxis, const FST_SparseGridCategoryFilter& InFilter = FST_SparseGridCategoryFilter()) const
+	{
+		// Sphere around the cone origin is always a valid (if loose) bound
+		QueryCells(OutObjects, InWorldLocation, FVector(InConeLength), FST_SparseGridKernel_Cone(InWorldLocation, InAxis, InConeLength, InConeHalfAngleRadians), InFilter);
+	}
+
+private:
+	template<class KernelType, class AllocatorType>
+	void QueryCells(TArray<T*, AllocatorType>& OutObjects, const FVector& InWorldLocation, const FVector& InSearchExtents, const KernelType& Kernel, const FST_SparseGridCategoryFilter& Filter) const
+	{
+		if (Objects.Num() == 0) { return; }
+
+#if ENABLE_GRID_BOUNDS
+		if (ObjectBounds.CanFastReject(InWorldLocation, InSearchExtents)) { return; }
+#endif
+
+		const FST_SparseGridCellTile Tile = GetSearchTile(FVector2D(InWorldLocation), FVector2D(InSearchExtents));
+
+		TArray<uint32, TInlineAllocator<8>> HitMask;
+
+		for (int32 CIdx = Tile.Start.Y; CIdx < Tile.End.Y; CIdx++)
+		{
+			for (int32 RIdx = Tile.Start.X; RIdx < Tile.End.X; RIdx++)
+			{
+				const int32 CellIndex = GetCellIndex(FST_GridRef2D(RIdx, CIdx));
+				const int32 Offset = CellOffsets[CellIndex];
+				const int32 NumCellObjects = CellOffsets[CellIndex + 1] - Offset;
+				if (NumCellObjects)
+				{
+					HitMask.SetNumUninitialized(FST_SparseGridKernels::GetNumMaskWords(NumCellObjects), false);
+
+					int32 NumHits = FST_SparseGridKernels::BuildHitMask(Kernel, PositionsX.GetData() + Offset, PositionsY.GetData() + Offset, PositionsZ.GetData() + Offset, NumCellObjects, HitMask.GetData());
+					NumHits = FST_SparseGridKernels::FilterHitMask(Filter, Categories.GetData() + Offset, HitMask.GetData(), HitMask.Num(), NumHits);
+					if (NumHits > 0)
+					{
+						FST_SparseGridKernels::AppendMasked(OutObjects, Objects.GetData() + Offset, HitMask.GetData(), HitMask.Num(), NumHits);
+					}
+				}
+			}
+		}
+	}
+
+	////////////////////
+	///// Building /////
+	////////////////////
+private:
+	// Only the grid can write snapshots
+	friend class TST_SparseGrid<T>;
+
+	/*
+	* Copies the current state of the grid.
+	* Existing allocations are reused where possible.
+	*/
+	void Build(const TST_SparseGrid<T>& InGrid, const uint64 InFrameNumber)
+	{
+		FrameNumber = InFrameNumber;
+		UpdateEpoch = InGrid.GetUpdateEpoch();
+		GridOrigin = InGrid.GetGridOrigin();
+		NumCells = InGrid.GetNumCells();
+		CellSize = InGrid.GetCellSize();
+
+#if ENABLE_GRID_BOUNDS
+		ObjectBounds = InGrid.GetObjectBounds();
+#endif
+
+		const auto& GridCells = InGrid.GetGridCells();
+		const int32 NumObjects = InGrid.GetRegisteredObjects().Num();
+
+		const int32 NumLogicalCells = NumCells.X * NumCells.Y;
+
+		CellOffsets.SetNumUninitialized(NumLogicalCells + 1, false);
+		Objects.SetNumUninitialized(NumObjects, false);
+		PositionsX.SetNumUninitialized(NumObjects, false);
+		PositionsY.SetNumUninitialized(NumObjects, false);
+		PositionsZ.SetNumUninitialized(NumObjects, false);
+		Categories.SetNumUninitialized(NumObjects, false);
+
+		// Snapshots are always row-major, whatever the grid's cell layout
+		int32 Offset = 0;
+		for (int32 XIdx = 0; XIdx < NumCells.X; XIdx++)
+		{
+			for (int32 YIdx = 0; YIdx < NumCells.Y; YIdx++)
+			{
+				const FST_GridRef2D CellXY = FST_GridRef2D(XIdx, YIdx);
+				CellOffsets[GetCellIndex(CellXY)] = Offset;
+
+				const auto& Cell = GridCells[InGrid.GetCellIndex(CellXY)];
+				const int32 NumCellObjects = Cell.GetObjects().Num();
+				if (NumCellObjects)
+				{
+					FMemory::Memcpy(Objects.GetData() + Offset, Cell.GetObjects().GetData(), sizeof(T*) * NumCellObjects);
+					FMemory::Memcpy(PositionsX.GetData() + Offset, Cell.GetPositionsX(), sizeof(float) * NumCellObjects);
+					FMemory::Memcpy(PositionsY.GetData() + Offset, Cell.GetPositionsY(), sizeof(float) * NumCellObjects);
+					FMemory::Memcpy(PositionsZ.GetData() + Offset, Cell.GetPositionsZ(), sizeof(float) * NumCellObjects);
+					FMemory::Memcpy(Categories.GetData() + Offset, Cell.GetCategories(), sizeof(uint32) * NumCellObjects);
+					Offset += NumCellObjects;
+				}
+			}
+		}
+
+		CellOffsets[NumLogicalCells] = Offset;
+		checkf(Offset == NumObjects, TEXT("TST_SparseGridSnapshot::Build - Cell contents do not match registered objects!"));
+	}
+
+	uint64 FrameNumber;
+	int32 UpdateEpoch;
+
+	FST_GridRef2D GridOrigin;
+	FST_GridRef2D NumCells;
+	int32 CellSize;
+
+#if ENABLE_GRID_BOUNDS
+	FST_SparseGridBounds ObjectBounds;
+#endif
+
+	// Flattened cell contents, see class description
+	TArray<int32> CellOffsets;
+	TArray<T*> Objects;
+	TArray<float> PositionsX;
+	TArray<float> PositionsY;
+	TArray<float> PositionsZ;
+	TArray<uint32> Categories;
+};
\ No newline at end of file
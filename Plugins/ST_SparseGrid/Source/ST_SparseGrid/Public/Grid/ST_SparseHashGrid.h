@@ -0,0 +1,718 @@
+// Copyright (C) James Baxter. All Rights Reserved.
+
+#pragma once
+
+#include "ST_SparseGridRegister.h"
+
+////////////////////////////
+///// Sparse Hash Grid /////
+////////////////////////////
+
+/*
+* Hashed Sparse Grid
+* Same object requirements as TST_SparseGrid, but without a fixed cell count.
+* Shares the TST_SparseGridQueries API with TST_SparseGrid, nearest-neighbour queries are not supported.
+*
+* Cells are keyed by their integer coordinate in a compact open-addressing table, and only exist while they hold objects.
+* The grid is unbounded - objects are never clamped into boundary cells, so there are no hotspots at the edges of the map.
+* Cell storage is pooled, and released cells are recycled for the next cell that becomes populated.
+*
+* Follows the same threading contract as TST_SparseGrid.
+* Incremental updates, parallel updates and snapshots are not supported, every object is re-bucketed serially in Update().
+*/
+template<class T>
+class TST_SparseHashGrid : public TST_SparseGridRegister<T, TST_SparseHashGrid<T>>
+{
+	typedef TST_SparseGridRegister<T, TST_SparseHashGrid<T>> Super;
+	friend class TST_SparseGridRegister<T, TST_SparseHashGrid<T>>;
+
+	using Super::GridWorld;
+	using Super::GridLock;
+	using Super::UpdateEpoch;
+	using Super::RegisteredObjects;
+#if ENABLE_GRID_BOUNDS
+	using Super::ObjectBounds;
+#endif
+
+	//////////////////////
+	////// Lifecycle /////
+	//////////////////////
+public:
+	// Constructor
+	TST_SparseHashGrid(
+			const UWorld* InGridWorld,
+			const int32 InCellSize,
+			const int32 InRegisterAllocSize,
+			const int32 InRegisterShrinkMultiplier,
+			const int32 InCellAllocSize,
+			const int32 InCellShrinkMultiplier)
+		: Super(InGridWorld, InRegisterAllocSize, InRegisterShrinkMultiplier)
+		, CellStorage(InCellAllocSize, InCellShrinkMultiplier)
+		, NumUsedSlots(0)
+		, CellSize(InCellSize)
+	{
+		check(GridWorld.IsValid() && CellSize > 0);
+
+		// Initialize Culling Properties
+		const float HalfCellSize = (float)CellSize * 0.5f;
+		CellBoundsRadius = FVector2D(HalfCellSize, HalfCellSize).Size();
+	}
+
+	// Destructor
+	~TST_SparseHashGrid()
+	{
+		GridWorld = nullptr;
+		Super::Empty();
+	}
+
+	//////////////////////////////
+	///// Grid Functionality /////
+	//////////////////////////////
+public:
+	/*
+	* Updates object placement in the grid.
+	* Typically once per-frame for each grid instance.
+	*/
+	void Update()
+	{
+		SCOPE_CYCLE_COUNTER(STAT_UpdateGrid)
+
+		SPARSE_GRID_CHECK_NOT_VISITING();
+		FRWScopeLock WriteLock(GridLock, SLT_Write);
+
+#if ENABLE_GRID_BOUNDS
+		ObjectBounds = FST_SparseGridBounds();
+#endif
+
+		for (T* ObjectItr : RegisteredObjects)
+		{
+			checkSlow(ObjectItr != nullptr);
+
+			const FVector WorldPosition = ObjectItr->GetSparseGridLocation();
+
+#if ENABLE_GRID_BOUNDS
+			ObjectBounds.Update(WorldPosition);
+#endif
+
+			const FST_GridRef2D DesiredCoord = WorldToCellXY(FVector2D(WorldPosition));
+			const int32 CurrentCell = ObjectItr->GetSparseGridData().GetCellIndex();
+
+			if (DesiredCoord == CellCoords[CurrentCell])
+			{
+				CellPool[CurrentCell].SetPosition(ObjectItr->GetSparseGridData().GetCellSubIndex(), WorldPosition);
+				CellPool[CurrentCell].SetCategoryMask(ObjectItr->GetSparseGridData().GetCellSubIndex(), ObjectItr->GetSparseGridData().GetCategoryMask());
+			}
+			else
+			{
+				RemoveFromCell(ObjectItr, CurrentCell);
+				AddToCell(ObjectItr, DesiredCoord, WorldPosition);
+			}
+		}
+
+		UpdateEpoch.Increment();
+	}
+
+private:
+	// TST_SparseGridRegister hooks
+	FORCEINLINE void RegisterInCell(T* InObject, const FVector& InWorldPosition)
+	{
+		AddToCell(InObject, WorldToCellXY(FVector2D(InWorldPosition)), InWorldPosition);
+	}
+
+	FORCEINLINE void UnregisterFromCell(T* InObject)
+	{
+		RemoveFromCell(InObject, InObject->GetSparseGridData().GetCellIndex());
+	}
+
+	void EmptyCells()
+	{
+		CellPool.Empty();
+		CellStorage.Empty();
+		CellCoords.Empty();
+		FreeCells.Empty();
+		Slots.Empty();
+		NumUsedSlots = 0;
+	}
+
+	FORCEINLINE void AddToCell(T* InObject, const FST_GridRef2D& InCoord, const FVector& InPosition)
+	{
+		const int32 CellIndex = FindOrAddCell(InCoord);
+		CellPool[CellIndex].Add(InObject, InPosition);
+		InObject->AccessSparseGridData().SetCellIndex(CellIndex);
+	}
+
+	FORCEINLINE void RemoveFromCell(T* InObject, const int32 InCellIndex)
+	{
+		CellPool[InCellIndex].Remove(InObject);
+		InObject->AccessSparseGridData().SetCellIndex(INDEX_NONE);
+
+		if (CellPool[InCellIndex].GetObjects().Num() == 0)
+		{
+			ReleaseCell(InCellIndex);
+		}
+	}
+
+	//////////////////////
+	///// Cell Table /////
+	//////////////////////
+private:
+	/*
+	* Open-addressing table slot, mapping a packed cell coordinate to a pooled cell.
+	*/
+	struct FST_SparseGridHashSlot
+	{
+		uint64 Key;
+		int32 CellIndex;
+	};
+
+	static FORCEINLINE uint64 MakeKey(const FST_GridRef2D& InCoord)
+	{
+		return (static_cast<uint64>(static_cast<uint32>(InCoord.X)) << 32) | static_cast<uint32>(InCoord.Y);
+	}
+
+	static FORCEINLINE uint32 HashKey(const uint64 InKey)
+	{
+		// Fibonacci hashing, neighbouring coordinates spread across the table
+		return static_cast<uint32>((InKey * 0x9E3779B97F4A7C15ull) >> 32);
+	}
+
+	/*
+	* Pooled cell at a coordinate, or INDEX_NONE if the cell is empty.
+	*/
+	FORCEINLINE int32 FindCell(const FST_GridRef2D& InCoord) const
+	{
+		if (NumUsedSlots == 0) { return INDEX_NONE; }
+
+		const uint64 Key = MakeKey(InCoord);
+		const uint32 Mask = Slots.Num() - 1;
+		for (uint32 SlotIdx = HashKey(Key) & Mask; ; SlotIdx = (SlotIdx + 1) & Mask)
+		{
+			const FST_SparseGridHashSlot& Slot = Slots[SlotIdx];
+			if (Slot.CellIndex == INDEX_NONE) { return INDEX_NONE; }
+			if (Slot.Key == Key) { return Slot.CellIndex; }
+		}
+	}
+
+	int32 FindOrAddCell(const FST_GridRef2D& InCoord)
+	{
+		// Keep the table at most half full, so probe sequences stay short
+		if ((NumUsedSlots + 1) * 2 > Slots.Num())
+		{
+			Rehash(FMath::Max(Slots.Num() * 2, 64));
+		}
+
+		const uint64 Key = MakeKey(InCoord);
+		const uint32 Mask = Slots.Num() - 1;
+		for (uint32 SlotIdx = HashKey(Key) & Mask; ; SlotIdx = (SlotIdx + 1) & Mask)
+		{
+			FST_SparseGridHashSlot& Slot = Slots[SlotIdx];
+			if (Slot.CellIndex == INDEX_NONE)
+			{
+				// Recycle released cells first
+				int32 CellIndex = INDEX_NONE;
+				if (FreeCells.Num())
+				{
+					CellIndex = FreeCells.Pop(false);
+					CellCoords[CellIndex] = InCoord;
+				}
+				else
+				{
+					CellIndex = CellPool.Add(TST_SparseGridCell<T>(&CellStorage));
+					CellCoords.Add(InCoord);
+				}
+
+				Slot.Key = Key;
+				Slot.CellIndex = CellIndex;
+				NumUsedSlots++;
+
+				return CellIndex;
+			}
+
+			if (Slot.Key == Key)
+			{
+				return Slot.CellIndex;
+			}
+		}
+	}
+
+	/*
+	* Removes an empty cell from the table, and returns its storage to the pool.
+	* Uses backward-shift deletion, so the table never needs tombstones.
+	*/
+	void ReleaseCell(const int32 InCellIndex)
+	{
+		const uint64 Key = MakeKey(CellCoords[InCellIndex]);
+		const uint32 Mask = Slots.Num() - 1;
+
+		uint32 HoleIdx = HashKey(Key) & Mask;
+		while (Slots[HoleIdx].CellIndex != InCellIndex)
+		{
+			checkSlow(Slots[HoleIdx].CellIndex != INDEX_NONE);
+			HoleIdx = (HoleIdx + 1) & Mask;
+		}
+
+		Slots[HoleIdx].CellIndex = INDEX_NONE;
+		NumUsedSlots--;
+
+		// Shift back any later entries whose probe sequence passes through the hole
+		for (uint32 SlotIdx = (HoleIdx + 1) & Mask; Slots[SlotIdx].CellIndex != INDEX_NONE; SlotIdx = (SlotIdx + 1) & Mask)
+		{
+			const uint32 HomeIdx = HashKey(Slots[SlotIdx].Key) & Mask;
+			if (((SlotIdx - HomeIdx) & Mask) >= ((SlotIdx - HoleIdx) & Mask))
+			{
+				Slots[HoleIdx] = Slots[SlotIdx];
+				Slots[SlotIdx].CellIndex = INDEX_NONE;
+				HoleIdx = SlotIdx;
+			}
+		}
+
+		// Return the cell's chunk to the storage, the pool entry itself is reused
+		CellPool[InCellIndex].Empty();
+
+		FreeCells.Add(InCellIndex);
+	}
+
+	void Rehash(const int32 InNumSlots)
+	{
+		checkSlow(FMath::IsPowerOfTwo(InNumSlots));
+
+		TArray<FST_SparseGridHashSlot> OldSlots = MoveTemp(Slots);
+
+		Slots.SetNumUninitialized(InNumSlots);
+		for (FST_SparseGridHashSlot& SlotItr : Slots)
+		{
+			SlotItr.CellIndex = INDEX_NONE;
+		}
+
+		const uint32 Mask = InNumSlots - 1;
+		for (const FST_SparseGridHashSlot& OldSlot : OldSlots)
+		{
+			if (OldSlot.CellIndex != INDEX_NONE)
+			{
+				uint32 SlotIdx = HashKey(OldSlot.Key) & Mask;
+				while (Slots[SlotIdx].CellIndex != INDEX_NONE)
+				{
+					SlotIdx = (SlotIdx + 1) & Mask;
+				}
+
+				Slots[SlotIdx] = OldSlot;
+			}
+		}
+	}
+
+	//////////////////////
+	///// Properties /////
+	//////////////////////
+public:
+	using Super::GetGridWorld;
+
+	FORCEINLINE int32 GetCellSize() const { return CellSize; }
+
+	// Number of cells currently holding objects
+	FORCEINLINE int32 GetNumPopulatedCells() const { return NumUsedSlots; }
+
+	FORCEINLINE float GetCellBoundsRadius() const { return CellBoundsRadius; }
+
+	FORCEINLINE FST_GridRef2D WorldToCellXY(const FVector2D& InWorldXY) const
+	{
+		return FST_GridRef2D(FMath::FloorToInt(InWorldXY.X / CellSize), FMath::FloorToInt(InWorldXY.Y / CellSize));
+	}
+
+	FORCEINLINE FVector2D GetCellCenter(const FST_GridRef2D& CellXY) const
+	{
+		return (CellXY * CellSize).ToVector() + ((float)CellSize * 0.5f);
+	}
+
+	/*
+	* Objects in the cell at a coordinate. Empty if the cell is not populated.
+	*/
+	TArray<T*> GetCellObjects(const FST_GridRef2D& CellXY) const
+	{
+		SPARSE_GRID_CHECK_NOT_VISITING();
+		FRWScopeLock ReadLock(GridLock, SLT_ReadOnly);
+
+		const int32 CellIndex = FindCell(CellXY);
+		return CellIndex != INDEX_NONE ? TArray<T*>(CellPool[CellIndex].GetObjects().GetData(), CellPool[CellIndex].GetObjects().Num()) : TArray<T*>();
+	}
+
+	/*
+	* Get Populations of a window of cells, in the same cell order as TST_SparseGrid
+	* Since the grid is unbounded, the heat-map samples a fixed window of it.
+	*/
+	void GetGridCellPopulations(TArray<uint32>& OutPopulation, const FST_GridRef2D& InWindowOrigin, const FST_GridRef2D& InWindowNumCells) const
+	{
+		SCOPE_CYCLE_COUNTER(STAT_QueryPopulation);
+
+		SPARSE_GRID_CHECK_NOT_VISITING();
+		FRWScopeLock ReadLock(GridLock, SLT_ReadOnly);
+
+		OutPopulation.Reset(InWindowNumCells.X * InWindowNumCells.Y);
+
+		const FST_GridRef2D WindowStart = WorldToCellXY(InWindowOrigin.ToVector());
+		for (int32 RIdx = 0; RIdx < InWindowNumCells.X; RIdx++)
+		{
+			for (int32 CIdx = 0; CIdx < InWindowNumCells.Y; CIdx++)
+			{
+				const int32 CellIndex = FindCell(WindowStart + FST_GridRef2D(RIdx, CIdx));
+				OutPopulation.Add(CellIndex != INDEX_NONE ? static_cast<uint32>(CellPool[CellIndex].GetObjects().Num()) : 0);
+			}
+		}
+	}
+
+private:
+	/*
+	* Backing store for the contents of all cells.
+	*/
+	TST_SparseGridCellStorage<T> CellStorage;
+
+	/*
+	* Pooled cells, and the coordinate each one currently represents.
+	* Objects store their pool index as their cell index.
+	*/
+	TArray<TST_SparseGridCell<T>> CellPool;
+	TArray<FST_GridRef2D> CellCoords;
+	TArray<int32> FreeCells;
+
+	/*
+	* Open-addressing table of populated cells. Always a power of two in size.
+	*/
+	TArray<FST_SparseGridHashSlot> Slots;
+	int32 NumUsedSlots;
+
+	int32 CellSize;
+	double CellBoundsRadius;
+
+	//////////////////////////
+	///// Search Queries /////
+	//////////////////////////
+public:
+	// Unfiltered, fixed-capacity and visitor overloads, see TST_SparseGridQueries
+	using Super::QueryGrid_Sphere;
+	using Super::QueryGrid_Capsule;
+	using Super::QueryGrid_Box;
+	using Super::QueryGrid_RotatedBox;
+	using Super::QueryGrid_Cone;
+
+	/*
+	* Sphere Query
+	* Returns all registered objects within a sphere.
+	*/
+	template<class OutputType>
+	void QueryGrid_Sphere(OutputType& OutObjects, const FVector& InWorldLocation, const float InSphereRadius, const FST_SparseGridCategoryFilter& InFilter, bool bDrawDebug = false) const
+	{
+		SCOPE_CYCLE_COUNTER(STAT_QueryGrid_Sphere)
+
+		SPARSE_GRID_CHECK_NOT_VISITING();
+		FRWScopeLock ReadLock(GridLock, SLT_ReadOnly);
+
+#if SPARSE_GRID_DEBUG
+		bDrawDebug &= IsInGameThread();
+		GATHER_DEBUG_PARAMETERS;
+
+		if (bDrawDebug) { DrawDebugSphere(DebugWorld, InWorldLocation, InSphereRadius, 12, FColor::Green, false, DrawQueryTime, 0, DrawQueryThickness); }
+#endif
+
+#if ENABLE_GRID_BOUNDS
+		if (ObjectBounds.CanFastReject(InWorldLocation, FVector(InSphereRadius))) { return; }
+#endif
+
+		const FVector2D Center2D = FVector2D(InWorldLocation);
+		const double CullDistSqrd = FMath::Square(InSphereRadius + CellBoundsRadius);
+
+		const FST_SparseGridKernel_Sphere Kernel = FST_SparseGridKernel_Sphere(InWorldLocation, InSphereRadius);
+		QueryCells(OutObjects, Center2D, FVector2D(InSphereRadius, InSphereRadius), Kernel, InFilter, [this, &Center2D, CullDistSqrd](const FST_GridRef2D& CellXY)
+		{
+			return FVector2D(GetCellCenter(CellXY) - Center2D).SizeSquared() > CullDistSqrd;
+		}, InWorldLocation, bDrawDebug);
+	}
+
+	/*
+	* Capsule Query
+	* Returns all registered objects within an orientated capsule.
+	*/
+	template<class OutputType>
+	void QueryGrid_Capsule(OutputType& OutObjects, const FVector& InWorldLocation, const FVector& InUpAxis, float InCapsuleRadius, float InCapsuleHalfHeight, const FST_SparseGridCategoryFilter& InFilter, bool bDrawDebug = false) const
+	{
+		SCOPE_CYCLE_COUNTER(STAT_QueryGrid_Capsule)
+
+		SPARSE_GRID_CHECK_NOT_VISITING();
+		FRWScopeLock ReadLock(GridLock, SLT_ReadOnly);
+
+		InCapsuleHalfHeight = FMath::Max3(0.f, InCapsuleHalfHeight, InCapsuleRadius);
+		InCapsuleRadius = FMath::Clamp(InCapsuleRadius, 0.f, InCapsuleHalfHeight);
+
+		const FVector Dir = InUpAxis * (InCapsuleHalfHeight - InCapsuleRadius);
+		const FVector Extents = Dir.GetAbs() + FVector(InCapsuleRadius);
+
+#if SPARSE_GRID_DEBUG
+		bDrawDebug &= IsInGameThread();
+		GATHER_DEBUG_PARAMETERS;
+
+		if (bDrawDebug) { DrawDebugCapsule(DebugWorld, InWorldLocation, InCapsuleHalfHeight, InCapsuleRadius, FRotationMatrix::MakeFromZ(InUpAxis).ToQuat(), FColor::Green, false, DrawQueryTime, 0, DrawQueryThickness); }
+#endif
+
+#if ENABLE_GRID_BOUNDS
+		if (ObjectBounds.CanFastReject(InWorldLocation, Extents)) { return; }
+#endif
+
+		const FVector2D CullStart = FVector2D(InWorldLocation + Dir);
+		const FVector2D CullEnd = FVector2D(InWorldLocation - Dir);
+
+		const FST_SparseGridKernel_Capsule Kernel = FST_SparseGridKernel_Capsule(InWorldLocation + Dir, InWorldLocation - Dir, InCapsuleRadius);
+		QueryCells(OutObjects, FVector2D(InWorldLocation), FVector2D(Extents), Kernel, InFilter, [this, &CullStart, &CullEnd, InCapsuleRadius](const FST_GridRef2D& CellXY)
+		{
+			return CullCell_Line(CellXY, CullStart, CullEnd, InCapsuleRadius);
+		}, InWorldLocation, bDrawDebug);
+	}
+
+	/*
+	* Box Query
+	* Returns all registered objects in an axis-aligned bounding box.
+	*/
+	template<class OutputType>
+	void QueryGrid_Box(OutputType& OutObjects, const FVector& InWorldLocation, const FVector& InBoxExtents, const FST_SparseGridCategoryFilter& InFilter, bool bDrawDebug = false) const
+	{
+		SCOPE_CYCLE_COUNTER(STAT_QueryGrid_Box)
+
+		SPARSE_GRID_CHECK_NOT_VISITING();
+		FRWScopeLock ReadLock(GridLock, SLT_ReadOnly);
+
+#if SPARSE_GRID_DEBUG
+		bDrawDebug &= IsInGameThread();
+		GATHER_DEBUG_PARAMETERS;
+
+		if (bDrawDebug) { DrawDebugBox(DebugWorld, InWorldLocation, InBoxExtents, FColor::Blue, false, DrawQueryTime, 0, DrawQueryThickness); }
+#endif
+
+#if ENABLE_GRID_BOUNDS
+		if (ObjectBounds.CanFastReject(InWorldLocation, InBoxExtents)) { return; }
+#endif
+
+		const FST_SparseGridKernel_Box Kernel = FST_SparseGridKernel_Box(InWorldLocation, InBoxExtents);
+		QueryCells(OutObjects, FVector2D(InWorldLocation), FVector2D(InBoxExtents), Kernel, InFilter, [](const FST_GridRef2D& CellXY) { return false; }, InWorldLocation, bDrawDebug);
+	}
+
+	/*
+	* Rotated Box Query
+	* Finds all registered objects within an non-axis-aligned bounding box.
+	*/
+	template<class OutputType>
+	void QueryGrid_RotatedBox(OutputType& OutObjects, const FVector& InWorldLocation, const FQuat& InBoxRotation, const FVector& InBoxExtents, const FST_SparseGridCategoryFilter& InFilter, bool bDrawDebug = false) const
+	{
+		if (InBoxRotation.IsIdentity())
+		{
+			QueryGrid_Box(OutObjects, InWorldLocation, InBoxExtents, InFilter, bDrawDebug);
+			return;
+		}
+
+		SCOPE_CYCLE_COUNTER(STAT_QueryGrid_RotatedBox)
+
+		SPARSE_GRID_CHECK_NOT_VISITING();
+		FRWScopeLock ReadLock(GridLock, SLT_ReadOnly);
+
+		const FBoxSphereBounds AABB = FBoxSphereBounds(FBox(-InBoxExtents, InBoxExtents)).TransformBy(FTransform(InBoxRotation, InWorldLocation));
+
+#if SPARSE_GRID_DEBUG
+		bDrawDebug &= IsInGameThread();
+		GATHER_DEBUG_PARAMETERS;
+
+		if (bDrawDebug) { DrawDebugBox(DebugWorld, InWorldLocation, InBoxExtents, InBoxRotation, FColor::Green, false, DrawQueryTime, 0, DrawQueryThickness); }
+#endif
+
+#if ENABLE_GRID_BOUNDS
+		if (ObjectBounds.CanFastReject(AABB.Origin, AABB.BoxExtent)) { return; }
+#endif
+
+		const FST_SparseGridKernel_RotatedBox Kernel = FST_SparseGridKernel_RotatedBox(InWorldLocation, InBoxRotation, InBoxExtents);
+		QueryCells(OutObjects, FVector2D(AABB.Origin), FVector2D(AABB.BoxExtent), Kernel, InFilter, [](const FST_GridRef2D& CellXY) { return false; }, InWorldLocation, bDrawDebug);
+	}
+
+	/*
+	* Cone Query
+	* Finds all registered objects within a cone.
+	*/
+	template<class OutputType>
+	void QueryGrid_Cone(OutputType& OutObjects, const FVector& InWorldLocation, const float InConeLength, const float InConeHalfAngleRadians, const FVector& InAxis, const FST_SparseGridCategoryFilter& InFilter, bool bDrawDebug = false) const
+	{
+		SCOPE_CYCLE_COUNTER(STAT_QueryGrid_Cone)
+
+		SPARSE_GRID_CHECK_NOT_VISITING();
+		FRWScopeLock ReadLock(GridLock, SLT_ReadOnly);
+
+		const FVector ConeCenter = InWorldLocation + InAxis * (InConeLength * 0.5f);
+		const float ConeEndRadius = InConeLength * FMath::Tan(InConeHalfAngleRadians);
+		const FVector ConeBoundsExtents = FVector(InConeLength * 0.5f, ConeEndRadius, ConeEndRadius);
+		const FBoxSphereBounds AABB = FBoxSphereBounds(FBox(-ConeBoundsExtents, ConeBoundsExtents)).TransformBy(FTransform(FRotationMatrix::MakeFromX(InAxis).ToQuat(), ConeCenter));
+
+#if SPARSE_GRID_DEBUG
+		bDrawDebug &= IsInGameThread();
+		GATHER_DEBUG_PARAMETERS;
+
+		if (bDrawDebug) { DrawDebugCone(DebugWorld, InWorldLocation, InAxis, InConeLength, InConeHalfAngleRadians, InConeHalfAngleRadians, 16, FColor::Green, false, DrawQueryTime, 0, DrawQueryThickness); }
+#endif
+
+#if ENABLE_GRID_BOUNDS
+		if (ObjectBounds.CanFastReject(AABB.Origin, AABB.BoxExtent)) { return; }
+#endif
+
+		const FVector2D LineStart2D = FVector2D(InWorldLocation);
+		const FVector2D LineEnd2D = FVector2D(InWorldLocation + InAxis * InConeLength);
+
+		const FST_SparseGridKernel_Cone Kernel = FST_SparseGridKernel_Cone(InWorldLocation, InAxis, InConeLength, InConeHalfAngleRadians);
+		QueryCells(OutObjects, FVector2D(AABB.Origin), FVector2D(AABB.BoxExtent), Kernel, InFilter, [this, &LineStart2D, &LineEnd2D, ConeEndRadius](const FST_GridRef2D& CellXY)
+		{
+			return CullCell_Line(CellXY, LineStart2D, LineEnd2D, ConeEndRadius);
+		}, InWorldLocation, bDrawDebug);
+	}
+
+private:
+	FORCEINLINE bool CullCell_Line(const FST_GridRef2D& CellXY, const FVector2D& InLineStart, const FVector2D& InLineEnd, const float DistFromLine) const
+	{
+		const FVector2D CellCenter = GetCellCenter(CellXY);
+		const FVector2D ClosestPoint = FMath::ClosestPointOnSegment2D(CellCenter, InLineStart, InLineEnd);
+
+		return FVector2D(CellCenter - ClosestPoint).SizeSquared() > FMath::Square(DistFromLine + CellBoundsRadius);
+	}
+
+	/*
+	* Shared narrow-phase for all shape queries, see TST_SparseGrid::QueryCells()
+	* When the search area covers more cells than are populated, the populated cells are scanned directly instead of
+	* looking up every coordinate, so huge queries over a sparse world stay cheap.
+	*/
+	template<class KernelType, class CullFuncType, class OutputType>
+	void QueryCells(OutputType& OutObjects, const FVector2D& InSearchOrigin, const FVector2D& InSearchExtents, const KernelType& Kernel, const FST_SparseGridCategoryFilter& Filter, const CullFuncType& CullCellFunc, const FVector& DebugOrigin, const bool bDrawDebug) const
+	{
+#if SPARSE_GRID_DEBUG
+		GATHER_DEBUG_PARAMETERS;
+#endif
+
+		if (NumUsedSlots == 0) { return; }
+
+		const FST_GridRef2D Start = WorldToCellXY(InSearchOrigin - InSearchExtents);
+		const FST_GridRef2D End = WorldToCellXY(InSearchOrigin + InSearchExtents);
+
+		TArray<uint32, TInlineAllocator<8>> HitMask;
+
+		const auto VisitCell = [&](const FST_GridRef2D& CellXY, const int32 CellIndex)
+		{
+			if (CullCellFunc(CellXY)) { return true; }
+
+			const TST_SparseGridCell<T>& Cell = CellPool[CellIndex];
+			const int32 NumCellObjects = Cell.GetObjects().Num();
+
+#if SPARSE_GRID_DEBUG
+			if (bDrawDebug) { DrawDebugCell(CellXY, FLinearColor(0.f, 1.f, 0.f, 0.25f), DrawQueryTime); }
+#endif
+
+			HitMask.SetNumUninitialized(FST_SparseGridKernels::GetNumMaskWords(NumCellObjects), false);
+
+			int32 NumHits = FST_SparseGridKernels::BuildHitMask(Kernel, Cell.GetPositionsX(), Cell.GetPositionsY(), Cell.GetPositionsZ(), NumCellObjects, HitMask.GetData());
+			NumHits = FST_SparseGridKernels::FilterHitMask(Filter, Cell.GetCategories(), HitMask.GetData(), HitMask.Num(), NumHits);
+			if (NumHits > 0)
+			{
+				FST_SparseGridKernels::AppendMasked(OutObjects, Cell.GetObjects().GetData(), HitMask.GetData(), HitMask.Num(), NumHits);
+
+#if SPARSE_GRID_DEBUG
+				if (bDrawDebug)
+				{
+					FST_SparseGridKernels::ForEachSetBit(HitMask.GetData(), HitMask.Num(), [&](const int32 SubIdx)
+					{
+						DrawDebugLine(DebugWorld, DebugOrigin, Cell.GetPosition(SubIdx), FColor::Green, false, DrawQueryTime, 0, DrawQueryThickness);
+					});
+				}
+#endif
+
+				return !FST_SparseGridKernels::IsStopped(OutObjects);
+			}
+
+			return true;
+		};
+
+		const int64 NumTileCells = static_cast<int64>(End.X - Start.X + 1) * static_cast<int64>(End.Y - Start.Y + 1);
+		if (NumTileCells > NumUsedSlots)
+		{
+			for (const FST_SparseGridHashSlot& SlotItr : Slots)
+			{
+				if (SlotItr.CellIndex != INDEX_NONE)
+				{
+					const FST_GridRef2D& CellXY = CellCoords[SlotItr.CellIndex];
+					if (CellXY.X >= Start.X && CellXY.X <= End.X && CellXY.Y >= Start.Y && CellXY.Y <= End.Y && !VisitCell(CellXY, SlotItr.CellIndex))
+					{
+						return;
+					}
+				}
+			}
+		}
+		else
+		{
+			for (int32 CIdx = Start.Y; CIdx <= End.Y; CIdx++)
+			{
+				for (int32 RIdx = Start.X; RIdx <= End.X; RIdx++)
+				{
+					const FST_GridRef2D CellXY = FST_GridRef2D(RIdx, CIdx);
+					const int32 CellIndex = FindCell(CellXY);
+					if (CellIndex != INDEX_NONE && !VisitCell(CellXY, CellIndex))
+					{
+						return;
+					}
+				}
+			}
+		}
+	}
+
+#if WITH_EDITOR
+	//////////////////
+	///// Editor /////
+	//////////////////
+public:
+	void GetEditorDebugInfo(int32& OutTotalObjects, uint64& OutRegisterAlloc, uint64& OutRegisterUsed, uint64& OutCellAlloc, uint64& OutCellUsed) const
+	{
+		SPARSE_GRID_CHECK_NOT_VISITING();
+		FRWScopeLock ReadLock(GridLock, SLT_ReadOnly);
+
+		this->GetRegisterMemoryInfo(OutTotalObjects, OutRegisterAlloc, OutRegisterUsed);
+
+		// Table and pool overhead counts as allocated but unused
+		OutCellAlloc = Slots.GetAllocatedSize() + CellPool.GetAllocatedSize() + CellCoords.GetAllocatedSize() + FreeCells.GetAllocatedSize() + CellStorage.GetAllocatedSize();
+		OutCellUsed = 0;
+		for (const TST_SparseGridCell<T>& CellItr : CellPool)
+		{
+			uint64 A, U;
+			CellItr.GetMemoryInfo(A, U);
+
+			OutCellUsed += U;
+		}
+	}
+#endif
+
+#if SPARSE_GRID_DEBUG
+	/////////////////////
+	///// Debugging /////
+	/////////////////////
+public:
+	/*
+	* Draws all populated cells.
+	*/
+	void DrawDebugGrid() const
+	{
+		const FLinearColor DebugHotColour = FLinearColor::FromSRGBColor(FColor::FromHex(ST_SparseGridCVars::CVarHotHex.GetValueOnGameThread()));
+		const FLinearColor DebugColdColour = FLinearColor::FromSRGBColor(FColor::FromHex(ST_SparseGridCVars::CVarColdHex.GetValueOnGameThread()));
+		const int32 HotThreshold = FMath::Max(ST_SparseGridCVars::CVarDebugHotThreshold.GetValueOnGameThread(), 1);
+
+		for (const FST_SparseGridHashSlot& SlotItr : Slots)
+		{
+			if (SlotItr.CellIndex != INDEX_NONE)
+			{
+				const float Progress = FMath::Clamp((float)CellPool[SlotItr.CellIndex].GetObjects().Num() / (float)HotThreshold, 0.f, 1.f);
+				DrawDebugCell(CellCoords[SlotItr.CellIndex], FLinearColor::LerpUsingHSV(DebugColdColour, DebugHotColour, Progress), -1.f);
+			}
+		}
+	}
+
+	void DrawDebugCell(const FST_GridRef2D& CellXY, const FLinearColor& Colour, const float DrawTime = -1.f) const
+	{
+		const FVector CellCenter = FVector(GetCellCenter(CellXY), ST_SparseGridCVars::CVarDebugGridHeight.GetValueOnGameThread() + 1.f);
+		DrawDebugSolidPlane(GetGridWorld(), FPlane(CellCenter, FVector::UpVector), CellCenter, FVector2D(CellSize, CellSize) * 0.5f, Colour.ToFColor(true), false, DrawTime);
+	}
+#endif
+};
\ No newline at end of file
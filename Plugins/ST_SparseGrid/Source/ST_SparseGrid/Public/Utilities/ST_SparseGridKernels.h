@@ -0,0 +1,622 @@
+// Copyright (C) James Baxter. All Rights Reserved.
+
+#pragma once
+
+#include "ST_SparseGridTypes.h"
+
+// Required
+#include "Math/UnrealMathUtility.h"
+#include "Math/VectorRegister.h"
+
+/*
+* Sparse Grid Narrow-Phase Kernels
+*
+* Each kernel tests the packed (structure-of-arrays) positions of a grid cell against a query shape.
+* With vector intrinsics enabled, four candidates are tested per instruction using VectorRegister, otherwise (and for the
+* tail of each cell) the scalar test is used. Both paths use identical maths so results never depend on candidate order.
+*
+* Kernels write a hit bitmask, one bit per candidate, 32 candidates per word. The mask is then compacted into the results.
+*/
+
+//////////////////
+///// Sphere /////
+//////////////////
+
+struct FST_SparseGridKernel_Sphere
+{
+public:
+	FST_SparseGridKernel_Sphere(const FVector& InCenter, const float InRadius)
+		: Center(InCenter)
+		, RadiusSqrd(InRadius * InRadius)
+#if ENABLE_GRID_SIMD
+		, CenterX(VectorSetFloat1(InCenter.X))
+		, CenterY(VectorSetFloat1(InCenter.Y))
+		, CenterZ(VectorSetFloat1(InCenter.Z))
+		, RadiusSqrd4(VectorSetFloat1(InRadius * InRadius))
+#endif
+	{}
+
+	FORCEINLINE bool Test(const float X, const float Y, const float Z) const
+	{
+		const float DX = X - Center.X;
+		const float DY = Y - Center.Y;
+		const float DZ = Z - Center.Z;
+
+		return (DX * DX + DY * DY + DZ * DZ) <= RadiusSqrd;
+	}
+
+#if ENABLE_GRID_SIMD
+	FORCEINLINE uint32 Test4(const VectorRegister& X, const VectorRegister& Y, const VectorRegister& Z) const
+	{
+		const VectorRegister DX = VectorSubtract(X, CenterX);
+		const VectorRegister DY = VectorSubtract(Y, CenterY);
+		const VectorRegister DZ = VectorSubtract(Z, CenterZ);
+
+		VectorRegister DistSqrd = VectorMultiply(DX, DX);
+		DistSqrd = VectorMultiplyAdd(DY, DY, DistSqrd);
+		DistSqrd = VectorMultiplyAdd(DZ, DZ, DistSqrd);
+
+		return (uint32)VectorMaskBits(VectorCompareGE(RadiusSqrd4, DistSqrd));
+	}
+#endif
+
+private:
+	FVector Center;
+	float RadiusSqrd;
+
+#if ENABLE_GRID_SIMD
+	VectorRegister CenterX;
+	VectorRegister CenterY;
+	VectorRegister CenterZ;
+	VectorRegister RadiusSqrd4;
+#endif
+};
+
+///////////////
+///// Box /////
+///////////////
+
+struct FST_SparseGridKernel_Box
+{
+public:
+	FST_SparseGridKernel_Box(const FVector& InCenter, const FVector& InExtents)
+		: ExtentMin(InCenter - InExtents)
+		, ExtentMax(InCenter + InExtents)
+#if ENABLE_GRID_SIMD
+		, MinX(VectorSetFloat1(InCenter.X - InExtents.X))
+		, MinY(VectorSetFloat1(InCenter.Y - InExtents.Y))
+		, MinZ(VectorSetFloat1(InCenter.Z - InExtents.Z))
+		, MaxX(VectorSetFloat1(InCenter.X + InExtents.X))
+		, MaxY(VectorSetFloat1(InCenter.Y + InExtents.Y))
+		, MaxZ(VectorSetFloat1(InCenter.Z + InExtents.Z))
+#endif
+	{}
+
+	FORCEINLINE bool Test(const float X, const float Y, const float Z) const
+	{
+		return X >= ExtentMin.X && X <= ExtentMax.X
+			&& Y >= ExtentMin.Y && Y <= ExtentMax.Y
+			&& Z >= ExtentMin.Z && Z <= ExtentMax.Z;
+	}
+
+#if ENABLE_GRID_SIMD
+	FORCEINLINE uint32 Test4(const VectorRegister& X, const VectorRegister& Y, const VectorRegister& Z) const
+	{
+		const VectorRegister InX = VectorBitwiseAnd(VectorCompareGE(X, MinX), VectorCompareGE(MaxX, X));
+		const VectorRegister InY = VectorBitwiseAnd(VectorCompareGE(Y, MinY), VectorCompareGE(MaxY, Y));
+		const VectorRegister InZ = VectorBitwiseAnd(VectorCompareGE(Z, MinZ), VectorCompareGE(MaxZ, Z));
+
+		return (uint32)VectorMaskBits(VectorBitwiseAnd(InX, VectorBitwiseAnd(InY, InZ)));
+	}
+#endif
+
+private:
+	FVector ExtentMin;
+	FVector ExtentMax;
+
+#if ENABLE_GRID_SIMD
+	VectorRegister MinX;
+	VectorRegister MinY;
+	VectorRegister MinZ;
+	VectorRegister MaxX;
+	VectorRegister MaxY;
+	VectorRegister MaxZ;
+#endif
+};
+
+///////////////////////
+///// Rotated Box /////
+///////////////////////
+
+struct FST_SparseGridKernel_RotatedBox
+{
+public:
+	FST_SparseGridKernel_RotatedBox(const FVector& InCenter, const FQuat& InRotation, const FVector& InExtents)
+		: Center(InCenter)
+		, AxisX(InRotation.GetAxisX())
+		, AxisY(InRotation.GetAxisY())
+		, AxisZ(InRotation.GetAxisZ())
+		, Extents(InExtents)
+#if ENABLE_GRID_SIMD
+		, CenterX(VectorSetFloat1(InCenter.X))
+		, CenterY(VectorSetFloat1(InCenter.Y))
+		, CenterZ(VectorSetFloat1(InCenter.Z))
+		, AxisXX(VectorSetFloat1(AxisX.X)), AxisXY(VectorSetFloat1(AxisX.Y)), AxisXZ(VectorSetFloat1(AxisX.Z))
+		, AxisYX(VectorSetFloat1(AxisY.X)), AxisYY(VectorSetFloat1(AxisY.Y)), AxisYZ(VectorSetFloat1(AxisY.Z))
+		, AxisZX(VectorSetFloat1(AxisZ.X)), AxisZY(VectorSetFloat1(AxisZ.Y)), AxisZZ(VectorSetFloat1(AxisZ.Z))
+		, ExtentX(VectorSetFloat1(InExtents.X))
+		, ExtentY(VectorSetFloat1(InExtents.Y))
+		, ExtentZ(VectorSetFloat1(InExtents.Z))
+#endif
+	{}
+
+	FORCEINLINE bool Test(const float X, const float Y, const float Z) const
+	{
+		// Project into box-space along each (orthonormal) box axis
+		const FVector Delta = FVector(X, Y, Z) - Center;
+
+		return FMath::Abs(FVector::DotProduct(Delta, AxisX)) <= Extents.X
+			&& FMath::Abs(FVector::DotProduct(Delta, AxisY)) <= Extents.Y
+			&& FMath::Abs(FVector::DotProduct(Delta, AxisZ)) <= Extents.Z;
+	}
+
+#if ENABLE_GRID_SIMD
+	FORCEINLINE uint32 Test4(const VectorRegister& X, const VectorRegister& Y, const VectorRegister& Z) const
+	{
+		const VectorRegister DX = VectorSubtract(X, CenterX);
+		const VectorRegister DY = VectorSubtract(Y, CenterY);
+		const VectorRegister DZ = VectorSubtract(Z, CenterZ);
+
+		const VectorRegister LocalX = VectorMultiplyAdd(DZ, AxisXZ, VectorMultiplyAdd(DY, AxisXY, VectorMultiply(DX, AxisXX)));
+		const VectorRegister LocalY = VectorMultiplyAdd(DZ, AxisYZ, VectorMultiplyAdd(DY, AxisYY, VectorMultiply(DX, AxisYX)));
+		const VectorRegister LocalZ = VectorMultiplyAdd(DZ, AxisZZ, VectorMultiplyAdd(DY, AxisZY, VectorMultiply(DX, AxisZX)));
+
+		const VectorRegister InX = VectorCompareGE(ExtentX, VectorAbs(LocalX));
+		const VectorRegister InY = VectorCompareGE(ExtentY, VectorAbs(LocalY));
+		const VectorRegister InZ = VectorCompareGE(ExtentZ, VectorAbs(LocalZ));
+
+		return (uint32)VectorMaskBits(VectorBitwiseAnd(InX, VectorBitwiseAnd(InY, InZ)));
+	}
+#endif
+
+private:
+	FVector Center;
+	FVector AxisX;
+	FVector AxisY;
+	FVector AxisZ;
+	FVector Extents;
+
+#if ENABLE_GRID_SIMD
+	VectorRegister CenterX, CenterY, CenterZ;
+	VectorRegister AxisXX, AxisXY, AxisXZ;
+	VectorRegister AxisYX, AxisYY, AxisYZ;
+	VectorRegister AxisZX, AxisZY, AxisZZ;
+	VectorRegister ExtentX, ExtentY, ExtentZ;
+#endif
+};
+
+///////////////////
+///// Capsule /////
+///////////////////
+
+struct FST_SparseGridKernel_Capsule
+{
+public:
+	FST_SparseGridKernel_Capsule(const FVector& InSegmentStart, const FVector& InSegmentEnd, const float InRadius)
+		: SegmentStart(InSegmentStart)
+		, Segment(InSegmentEnd - InSegmentStart)
+		, InvSegmentLengthSqrd(Segment.SizeSquared() > SMALL_NUMBER ? 1.f / Segment.SizeSquared() : 0.f)
+		, RadiusSqrd(InRadius * InRadius)
+#if ENABLE_GRID_SIMD
+		, StartX(VectorSetFloat1(InSegmentStart.X))
+		, StartY(VectorSetFloat1(InSegmentStart.Y))
+		, StartZ(VectorSetFloat1(InSegmentStart.Z))
+		, SegmentX(VectorSetFloat1(Segment.X))
+		, SegmentY(VectorSetFloat1(Segment.Y))
+		, SegmentZ(VectorSetFloat1(Segment.Z))
+		, InvSegmentLengthSqrd4(VectorSetFloat1(InvSegmentLengthSqrd))
+		, RadiusSqrd4(VectorSetFloat1(RadiusSqrd))
+#endif
+	{}
+
+	FORCEINLINE bool Test(const float X, const float Y, const float Z) const
+	{
+		// Closest point on the capsule segment
+		const FVector Delta = FVector(X, Y, Z) - SegmentStart;
+		const float Alpha = FMath::Clamp(FVector::DotProduct(Delta, Segment) * InvSegmentLengthSqrd, 0.f, 1.f);
+
+		return (Delta - Segment * Alpha).SizeSquared() <= RadiusSqrd;
+	}
+
+#if ENABLE_GRID_SIMD
+	FORCEINLINE uint32 Test4(const VectorRegister& X, const VectorRegister& Y, const VectorRegister& Z) const
+	{
+		const VectorRegister DX = VectorSubtract(X, StartX);
+		const VectorRegister DY = VectorSubtract(Y, StartY);
+		const VectorRegister DZ = VectorSubtract(Z, StartZ);
+
+		VectorRegister Alpha = VectorMultiplyAdd(DZ, SegmentZ, VectorMultiplyAdd(DY, SegmentY, VectorMultiply(DX, SegmentX)));
+		Alpha = VectorMin(VectorMax(VectorMultiply(Alpha, InvSegmentLengthSqrd4), VectorZero()), VectorOne());
+
+		// Delta - Segment * Alpha
+		const VectorRegister OX = VectorSubtract(DX, VectorMultiply(SegmentX, Alpha));
+		const VectorRegister OY = VectorSubtract(DY, VectorMultiply(SegmentY, Alpha));
+		const VectorRegister OZ = VectorSubtract(DZ, VectorMultiply(SegmentZ, Alpha));
+
+		VectorRegister DistSqrd = VectorMultiply(OX, OX);
+		DistSqrd = VectorMultiplyAdd(OY, OY, DistSqrd);
+		DistSqrd = VectorMultiplyAdd(OZ, OZ, DistSqrd);
+
+		return (uint32)VectorMaskBits(VectorCompareGE(RadiusSqrd4, DistSqrd));
+	}
+#endif
+
+private:
+	FVector SegmentStart;
+	FVector Segment;
+	float InvSegmentLengthSqrd;
+	float RadiusSqrd;
+
+#if ENABLE_GRID_SIMD
+	VectorRegister StartX, StartY, StartZ;
+	VectorRegister SegmentX, SegmentY, SegmentZ;
+	VectorRegister InvSegmentLengthSqrd4;
+	VectorRegister RadiusSqrd4;
+#endif
+};
+
+////////////////
+///// Cone /////
+////////////////
+
+struct FST_SparseGridKernel_Cone
+{
+public:
+	/*
+	* Axis is expected to be normalized.
+	* The angular test avoids a square root per candidate by comparing squared terms:
+	* Dot(Axis, Delta) >= Cos * |Delta|  <=>  Dot >= 0 && Dot^2 >= Cos^2 * |Delta|^2 (for Cos >= 0)
+	*/
+	FST_SparseGridKernel_Cone(const FVector& InOrigin, const FVector& InAxis, const float InLength, const float InHalfAngleRadians)
+		: Origin(InOrigin)
+		, Axis(InAxis)
+		, LengthSqrd(InLength * InLength)
+		, CosSqrd(FMath::Square(FMath::Cos(InHalfAngleRadians)))
+		, bWideCone(FMath::Cos(InHalfAngleRadians) < 0.f)
+#if ENABLE_GRID_SIMD
+		, OriginX(VectorSetFloat1(InOrigin.X))
+		, OriginY(VectorSetFloat1(InOrigin.Y))
+		, OriginZ(VectorSetFloat1(InOrigin.Z))
+		, AxisX(VectorSetFloat1(InAxis.X))
+		, AxisY(VectorSetFloat1(InAxis.Y))
+		, AxisZ(VectorSetFloat1(InAxis.Z))
+		, LengthSqrd4(VectorSetFloat1(LengthSqrd))
+		, CosSqrd4(VectorSetFloat1(CosSqrd))
+		, MinDistSqrd4(VectorSetFloat1(SMALL_NUMBER))
+#endif
+	{}
+
+	FORCEINLINE bool Test(const float X, const float Y, const float Z) const
+	{
+		const FVector Delta = FVector(X, Y, Z) - Origin;
+		const float DistSqrd = Delta.SizeSquared();
+		if (DistSqrd > LengthSqrd)
+		{
+			return false;
+		}
+
+		const float Dot = FVector::DotProduct(Axis, Delta);
+		if (bWideCone)
+		{
+			// Cone wider than a hemisphere, only reject behind the cone edge
+			return Dot >= 0.f || (Dot * Dot) <= CosSqrd * DistSqrd;
+		}
+
+		return DistSqrd >= SMALL_NUMBER && Dot >= 0.f && (Dot * Dot) >= CosSqrd * DistSqrd;
+	}
+
+#if ENABLE_GRID_SIMD
+	FORCEINLINE uint32 Test4(const VectorRegister& X, const VectorRegister& Y, const VectorRegister& Z) const
+	{
+		const VectorRegister DX = VectorSubtract(X, OriginX);
+		const VectorRegister DY = VectorSubtract(Y, OriginY);
+		const VectorRegister DZ = VectorSubtract(Z, OriginZ);
+
+		VectorRegister DistSqrd = VectorMultiply(DX, DX);
+		DistSqrd = VectorMultiplyAdd(DY, DY, DistSqrd);
+		DistSqrd = VectorMultiplyAdd(DZ, DZ, DistSqrd);
+
+		const VectorRegister Dot = VectorMultiplyAdd(DZ, AxisZ, VectorMultiplyAdd(DY, AxisY, VectorMultiply(DX, AxisX)));
+		const VectorRegister DotSqrd = VectorMultiply(Dot, Dot);
+		const VectorRegister CosDistSqrd = VectorMultiply(CosSqrd4, DistSqrd);
+		const VectorRegister InFront = VectorCompareGE(Dot, VectorZero());
+		const VectorRegister InRange = VectorCompareGE(LengthSqrd4, DistSqrd);
+
+		VectorRegister InAngle;
+		if (bWideCone)
+		{
+			InAngle = VectorBitwiseOr(InFront, VectorCompareGE(CosDistSqrd, DotSqrd));
+		}
+		else
+		{
+			InAngle = VectorBitwiseAnd(VectorBitwiseAnd(InFront, VectorCompareGE(DistSqrd, MinDistSqrd4)), VectorCompareGE(DotSqrd, CosDistSqrd));
+		}
+
+		return (uint32)VectorMaskBits(VectorBitwiseAnd(InRange, InAngle));
+	}
+#endif
+
+private:
+	FVector Origin;
+	FVector Axis;
+	float LengthSqrd;
+	float CosSqrd;
+	bool bWideCone;
+
+#if ENABLE_GRID_SIMD
+	VectorRegister OriginX, OriginY, OriginZ;
+	VectorRegister AxisX, AxisY, AxisZ;
+	VectorRegister LengthSqrd4;
+	VectorRegister CosSqrd4;
+	VectorRegister MinDistSqrd4;
+#endif
+};
+
+///////////////////////
+///// Result Span /////
+///////////////////////
+
+/*
+* Query output that writes into caller-provided, fixed-capacity storage, such as a stack array or a frame scratch buffer.
+* Never allocates. Results beyond the capacity are handled by the overflow policy.
+*/
+template<class ObjectType>
+class TST_SparseGridResultSpan
+{
+public:
+	TST_SparseGridResultSpan(const TArrayView<ObjectType*> InBuffer, const EST_SparseGridOverflow InOverflow = EST_SparseGridOverflow::Truncate)
+		: Buffer(InBuffer)
+		, NumResults(0)
+		, Overflow(InOverflow)
+		, bOverflowed(false)
+	{}
+
+	FORCEINLINE int32 Num() const { return NumResults; }
+	FORCEINLINE int32 GetCapacity() const { return Buffer.Num(); }
+	FORCEINLINE bool HasOverflowed() const { return bOverflowed; }
+
+	// Results written so far
+	FORCEINLINE TArrayView<ObjectType*> GetView() const { return TArrayView<ObjectType*>(Buffer.GetData(), NumResults); }
+
+	FORCEINLINE void Reset()
+	{
+		NumResults = 0;
+		bOverflowed = false;
+	}
+
+	/*
+	* Reserves space for InNum results, returning how many fit.
+	* Applies the overflow policy if they do not all fit.
+	*/
+	int32 AddUninitialized(const int32 InNum)
+	{
+		const int32 NumFit = FMath::Min(InNum, Buffer.Num() - NumResults);
+		if (NumFit < InNum && !bOverflowed)
+		{
+			bOverflowed = true;
+			ensureMsgf(Overflow != EST_SparseGridOverflow::Ensure, TEXT("Sparse Grid query results overflowed a result span of capacity '%i'"), Buffer.Num());
+		}
+
+		NumResults += NumFit;
+		return NumFit;
+	}
+
+	FORCEINLINE ObjectType** GetData() const { return Buffer.GetData(); }
+
+private:
+	TArrayView<ObjectType*> Buffer;
+	int32 NumResults;
+	EST_SparseGridOverflow Overflow;
+	uint8 bOverflowed : 1;
+};
+
+///////////////////
+///// Visitor /////
+///////////////////
+
+/*
+* Query output that calls a functor for each result instead of storing it.
+* The functor returns EST_SparseGridVisitResult::Stop to end the query early.
+* The functor runs while the grid is read locked, see FST_SparseGridVisitScope.
+*/
+template<class ObjectType, class FuncType>
+class TST_SparseGridVisitor
+{
+public:
+	TST_SparseGridVisitor(FuncType& InFunc, const void* InGrid)
+		: Func(InFunc)
+		, Grid(InGrid)
+		, bStopped(false)
+	{}
+
+	FORCEINLINE bool IsStopped() const { return bStopped; }
+
+	FORCEINLINE void Visit(ObjectType* InObject)
+	{
+		const FST_SparseGridVisitScope VisitScope = FST_SparseGridVisitScope(Grid);
+		if (Func(InObject) == EST_SparseGridVisitResult::Stop)
+		{
+			bStopped = true;
+		}
+	}
+
+private:
+	FuncType& Func;
+	const void* Grid;
+	bool bStopped;
+};
+
+////////////////////////////
+///// Kernel Utilities /////
+////////////////////////////
+
+struct FST_SparseGridKernels
+{
+public:
+	/* Number of 32-bit mask words required to hold a bit per candidate */
+	static FORCEINLINE int32 GetNumMaskWords(const int32 InNumCandidates)
+	{
+		return (InNumCandidates + 31) >> 5;
+	}
+
+	/*
+	* Runs the kernel over packed positions, writing a hit bitmask.
+	* OutMask must hold at least GetNumMaskWords(InNum) words.
+	* Returns the number of hits.
+	*/
+	template<class KernelType>
+	static int32 BuildHitMask(const KernelType& InKernel, const float* InX, const float* InY, const float* InZ, const int32 InNum, uint32* OutMask)
+	{
+		FMemory::Memzero(OutMask, sizeof(uint32) * GetNumMaskWords(InNum));
+
+		int32 NumHits = 0;
+		int32 Idx = 0;
+
+#if ENABLE_GRID_SIMD
+		// Four candidates at a time. Idx is always a multiple of four here, so the four bits never straddle a mask word.
+		for (; Idx + 4 <= InNum; Idx += 4)
+		{
+			const uint32 Bits = InKernel.Test4(VectorLoad(InX + Idx), VectorLoad(InY + Idx), VectorLoad(InZ + Idx));
+			OutMask[Idx >> 5] |= Bits << (Idx & 31);
+			NumHits += FMath::CountBits(Bits);
+		}
+#endif
+
+		// Scalar Tail (or fallback)
+		for (; Idx < InNum; Idx++)
+		{
+			if (InKernel.Test(InX[Idx], InY[Idx], InZ[Idx]))
+			{
+				OutMask[Idx >> 5] |= 1u << (Idx & 31);
+				NumHits++;
+			}
+		}
+
+		return NumHits;
+	}
+
+	/*
+	* Clears the hits whose cached category mask fails the filter.
+	* Returns the number of hits left.
+	*/
+	static FORCEINLINE int32 FilterHitMask(const FST_SparseGridCategoryFilter& InFilter, const uint32* InCategories, uint32* InOutMask, const int32 InNumWords, int32 InNumHits)
+	{
+		if (InFilter.IsEmpty()) { return InNumHits; }
+
+		for (int32 WordIdx = 0; WordIdx < InNumWords && InNumHits > 0; WordIdx++)
+		{
+			uint32 Bits = InOutMask[WordIdx];
+			while (Bits)
+			{
+				const uint32 Bit = (uint32)FMath::CountTrailingZeros(Bits);
+				if (!InFilter.Passes(InCategories[(WordIdx << 5) + Bit]))
+				{
+					InOutMask[WordIdx] &= ~(1u << Bit);
+					InNumHits--;
+				}
+
+				Bits &= Bits - 1;
+			}
+		}
+
+		return InNumHits;
+	}
+
+	/*
+	* Calls InFunc(Index) for every set bit in the mask, in ascending order.
+	*/
+	template<class FuncType>
+	static FORCEINLINE void ForEachSetBit(const uint32* InMask, const int32 InNumWords, FuncType&& InFunc)
+	{
+		for (int32 WordIdx = 0; WordIdx < InNumWords; WordIdx++)
+		{
+			uint32 Bits = InMask[WordIdx];
+			while (Bits)
+			{
+				InFunc((WordIdx << 5) + (int32)FMath::CountTrailingZeros(Bits));
+				Bits &= Bits - 1;
+			}
+		}
+	}
+
+	/*
+	* Compacts the hit mask into the output array.
+	* Grows the output once per call rather than once per hit.
+	*/
+	template<class ObjectType, class AllocatorType>
+	static FORCEINLINE void AppendMasked(TArray<ObjectType*, AllocatorType>& OutObjects, ObjectType* const* InObjects, const uint32* InMask, const int32 InNumWords, const int32 InNumHits)
+	{
+		const int32 StartIdx = OutObjects.AddUninitialized(InNumHits);
+		ObjectType** Dest = OutObjects.GetData() + StartIdx;
+
+		ForEachSetBit(InMask, InNumWords, [&Dest, InObjects](const int32 InIndex)
+		{
+			*Dest++ = InObjects[InIndex];
+		});
+	}
+
+	/*
+	* Visits each hit in the mask, until the visitor stops.
+	*/
+	template<class ObjectType, class FuncType>
+	static FORCEINLINE void AppendMasked(TST_SparseGridVisitor<ObjectType, FuncType>& OutVisitor, ObjectType* const* InObjects, const uint32* InMask, const int32 InNumWords, const int32 InNumHits)
+	{
+		for (int32 WordIdx = 0; WordIdx < InNumWords && !OutVisitor.IsStopped(); WordIdx++)
+		{
+			uint32 Bits = InMask[WordIdx];
+			while (Bits && !OutVisitor.IsStopped())
+			{
+				OutVisitor.Visit(InObjects[(WordIdx << 5) + (int32)FMath::CountTrailingZeros(Bits)]);
+				Bits &= Bits - 1;
+			}
+		}
+	}
+
+	/*
+	* Whether a query output wants no more results, so the query can stop walking cells.
+	*/
+	template<class OutputType>
+	static FORCEINLINE bool IsStopped(const OutputType& InOutput)
+	{
+		return false;
+	}
+
+	template<class ObjectType, class FuncType>
+	static FORCEINLINE bool IsStopped(const TST_SparseGridVisitor<ObjectType, FuncType>& InVisitor)
+	{
+		return InVisitor.IsStopped();
+	}
+
+	/*
+	* Compacts the hit mask into a fixed-capacity result span.
+	* Hits that do not fit are dropped, according to the span's overflow policy.
+	*/
+	template<class ObjectType>
+	static FORCEINLINE void AppendMasked(TST_SparseGridResultSpan<ObjectType>& OutObjects, ObjectType* const* InObjects, const uint32* InMask, const int32 InNumWords, const int32 InNumHits)
+	{
+		const int32 StartIdx = OutObjects.Num();
+		int32 NumRemaining = OutObjects.AddUninitialized(InNumHits);
+		ObjectType** Dest = OutObjects.GetData() + StartIdx;
+
+		for (int32 WordIdx = 0; WordIdx < InNumWords && NumRemaining > 0; WordIdx++)
+		{
+			uint32 Bits = InMask[WordIdx];
+			while (Bits && NumRemaining > 0)
+			{
+				*Dest++ = InObjects[(WordIdx << 5) + (int32)FMath::CountTrailingZeros(Bits)];
+				Bits &= Bits - 1;
+				NumRemaining--;
+			}
+		}
+	}
+};
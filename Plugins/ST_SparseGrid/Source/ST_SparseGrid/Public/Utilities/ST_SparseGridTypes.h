@@ -14,6 +14,10 @@ ST_SPARSEGRID_API DECLARE_LOG_CATEGORY_EXTERN(LogST_SparseGridManager, Log, All)
 // In some cases (high objects counts and/or high numbers of queries) this can be slower, profile for best results.
 #define ENABLE_GRID_BOUNDS 1
 
+// Whether narrow-phase query kernels test four candidates at a time using VectorRegister intrinsics
+// Falls back to scalar tests on platforms without vector intrinsics.
+#define ENABLE_GRID_SIMD (PLATFORM_ENABLE_VECTORINTRINSICS || PLATFORM_ENABLE_VECTORINTRINSICS_NEON)
+
 /////////////////////////////
 ///// Console Variables /////
 /////////////////////////////
@@ -63,6 +67,60 @@ public:
 };
 #endif
 
+/*
+* How a grid refreshes object placement each frame.
+*/
+UENUM(BlueprintType)
+enum class EST_SparseGridUpdateMode : uint8
+{
+	// Walk all objects on the calling thread, moving them between cells immediately.
+	Serial		UMETA(DisplayName = "Serial"),
+
+	// Compute desired cells across worker threads, then apply cell migrations in a short serial pass.
+	Parallel	UMETA(DisplayName = "Parallel"),
+
+	// Lay out every cell again from scratch each frame with a parallel counting sort.
+	Rebuild		UMETA(DisplayName = "Rebuild"),
+
+	// Parallel, switching to Rebuild for the next frame when enough objects changed cell.
+	Automatic	UMETA(DisplayName = "Automatic"),
+};
+
+/*
+* How a grid orders its cells in memory.
+*/
+UENUM(BlueprintType)
+enum class EST_SparseGridCellLayout : uint8
+{
+	// Cells stored column by column. Neighbouring cells along X are NumCellsY cells apart in memory.
+	RowMajor	UMETA(DisplayName = "Row Major"),
+
+	// Cells stored along a Z-order curve, so cells close together in the world are also close together in memory.
+	// Each axis is padded to a power of two, the padding cells are never populated.
+	Morton		UMETA(DisplayName = "Morton (Z-Order)"),
+};
+
+/*
+* What to do when query results do not fit in a fixed-capacity result span.
+*/
+enum class EST_SparseGridOverflow : uint8
+{
+	// Drop results that do not fit.
+	Truncate,
+
+	// Drop results that do not fit, and raise an ensure.
+	Ensure,
+};
+
+/*
+* Returned by ForEachIn*() visitors to keep walking the grid, or stop.
+*/
+enum class EST_SparseGridVisitResult : uint8
+{
+	Continue,
+	Stop,
+};
+
 //////////////////////////////////////
 ///// Sparse Grid Cell Reference /////
 //////////////////////////////////////
@@ -78,6 +136,10 @@ public:
 		: GridIndex(INDEX_NONE)
 		, CellIndex(INDEX_NONE)
 		, CellSubIndex(INDEX_NONE)
+		, DynamicIndex(INDEX_NONE)
+		, CategoryMask(0)
+		, bStatic(false)
+		, bDirty(false)
 	{}
 
 	// Validation
@@ -94,10 +156,30 @@ public:
 	FORCEINLINE int32 GetCellSubIndex() const { return CellSubIndex; }
 	FORCEINLINE void SetCellSubIndex(const int32 InIndex) { CellSubIndex = InIndex; }
 
+	// Mobility
+	// Static objects are only re-bucketed after being marked dirty, when the grid uses incremental updates.
+	FORCEINLINE bool IsStatic() const { return bStatic; }
+	FORCEINLINE void SetStatic(const bool bInStatic) { bStatic = bInStatic; }
+
+	FORCEINLINE bool IsDirty() const { return bDirty; }
+	FORCEINLINE void SetDirty(const bool bInDirty) { bDirty = bInDirty; }
+
+	FORCEINLINE int32 GetDynamicIndex() const { return DynamicIndex; }
+	FORCEINLINE void SetDynamicIndex(const int32 InIndex) { DynamicIndex = InIndex; }
+
+	// Categories
+	// Cached by the grid alongside the object position, see FST_SparseGridCategoryFilter.
+	FORCEINLINE uint32 GetCategoryMask() const { return CategoryMask; }
+	FORCEINLINE void SetCategoryMask(const uint32 InCategoryMask) { CategoryMask = InCategoryMask; }
+
 private:
 	int32 GridIndex;
 	int32 CellIndex;
 	int32 CellSubIndex;
+	int32 DynamicIndex;
+	uint32 CategoryMask;
+	uint8 bStatic : 1;
+	uint8 bDirty : 1;
 };
 
 USTRUCT(BlueprintType, meta = (DisplayName = "2D Grid Ref"))
@@ -274,18 +356,104 @@ public:
 		}
 	}
 
+	// Expands to include another set of bounds
+	FORCEINLINE void Merge(const FST_SparseGridBounds& Other)
+	{
+		if (!Other.bIsClear)
+		{
+			Update(Other.FrameMin);
+			Update(Other.FrameMax);
+		}
+	}
+
 	FORCEINLINE void GetBoundingBox(FVector& OutCenter, FVector& OutExtent) const
 	{
 		OutCenter = (FrameMin + FrameMax) * 0.5f;
 		OutExtent = FrameMax - OutCenter;
 	}
 
+	FORCEINLINE const FVector& GetMin() const { return FrameMin; }
+	FORCEINLINE const FVector& GetMax() const { return FrameMax; }
+	FORCEINLINE bool IsClear() const { return bIsClear; }
+
 private:
 	FVector FrameMax;
 	FVector FrameMin;
 	uint8 bIsClear : 1;
 };
 
+/*
+* Query Category Filter
+* Objects pass if they share any category with Include (or Include is zero), and none with Exclude.
+* The default filter passes every object.
+*/
+struct ST_SPARSEGRID_API FST_SparseGridCategoryFilter
+{
+public:
+	FST_SparseGridCategoryFilter()
+		: Include(0)
+		, Exclude(0)
+	{}
+
+	explicit FST_SparseGridCategoryFilter(const uint32 InInclude, const uint32 InExclude = 0)
+		: Include(InInclude)
+		, Exclude(InExclude)
+	{}
+
+	FORCEINLINE bool IsEmpty() const { return Include == 0 && Exclude == 0; }
+	FORCEINLINE bool Passes(const uint32 InCategoryMask) const { return (Include == 0 || (InCategoryMask & Include) != 0) && (InCategoryMask & Exclude) == 0; }
+
+	uint32 Include;
+	uint32 Exclude;
+};
+
+/*
+* Visitor Re-entry Guard
+* Visitor queries call back into user code while the visited grid holds its read lock. Adding, removing or destroying objects
+* in that grid from inside the visitor would take the write lock on the same thread and deadlock, and querying it again can
+* deadlock behind a waiting writer. Debug builds track which grids each thread is visiting, so re-entry asserts instead.
+*/
+struct ST_SPARSEGRID_API FST_SparseGridVisitScope
+{
+public:
+#if SPARSE_GRID_DEBUG
+	explicit FST_SparseGridVisitScope(const void* InGrid);
+	~FST_SparseGridVisitScope();
+
+	static bool IsVisiting(const void* InGrid);
+#else
+	explicit FST_SparseGridVisitScope(const void* InGrid) {}
+
+	static FORCEINLINE bool IsVisiting(const void* InGrid) { return false; }
+#endif
+};
+
+#define SPARSE_GRID_CHECK_NOT_VISITING() checkf(!FST_SparseGridVisitScope::IsVisiting(this), TEXT("Sparse Grid accessed from inside one of its own visitor queries! Collect results with QueryGrid_*() instead when objects must be modified."))
+
+/*
+* Sphere Query Shape
+* Used for batched queries
+*/
+struct ST_SPARSEGRID_API FST_SparseGridSphereQuery
+{
+public:
+	FST_SparseGridSphereQuery()
+		: Location(FVector::ZeroVector)
+		, Radius(0.f)
+		, Filter()
+	{}
+
+	FST_SparseGridSphereQuery(const FVector& InLocation, const float InRadius, const FST_SparseGridCategoryFilter& InFilter = FST_SparseGridCategoryFilter())
+		: Location(InLocation)
+		, Radius(InRadius)
+		, Filter(InFilter)
+	{}
+
+	FVector Location;
+	float Radius;
+	FST_SparseGridCategoryFilter Filter;
+};
+
 /*
 * Sparse Grid Cell Tile
 * Used for fast cell lookups
@@ -307,4 +475,27 @@ public:
 		: Start(InStart)
 		, End(InEnd)
 	{}
+};
+
+/*
+* Sparse Grid Cell Tile 3D
+* Used for fast cell lookups in voxel grids, End is exclusive
+*/
+USTRUCT(BlueprintType)
+struct ST_SPARSEGRID_API FST_SparseGridCellTile3D
+{
+	GENERATED_BODY()
+public:
+	UPROPERTY(BlueprintReadOnly, Category = "Indices") FIntVector Start;
+	UPROPERTY(BlueprintReadOnly, Category = "Indices") FIntVector End;
+
+	FST_SparseGridCellTile3D()
+		: Start(INDEX_NONE)
+		, End(INDEX_NONE)
+	{}
+
+	FST_SparseGridCellTile3D(const FIntVector& InStart, const FIntVector& InEnd)
+		: Start(InStart)
+		, End(InEnd)
+	{}
 };
\ No newline at end of file